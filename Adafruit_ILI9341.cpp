@@ -74,6 +74,16 @@
 #define SPI_DEFAULT_FREQ 24000000 ///< Default SPI data clock frequency
 #endif
 
+#if ILI9341_ENABLE_STATS
+// Charge the rest of the calling function to an ILI9341_API_* group
+#define ILI9341_STATS_API(api) StatsScope statsScope(this, ILI9341_API_##api)
+// Add to a counter of the group currently being charged
+#define ILI9341_STATS_ADD(field, n) (_stats[_statsApi].field += (n))
+#else
+#define ILI9341_STATS_API(api)
+#define ILI9341_STATS_ADD(field, n)
+#endif
+
 #define MADCTL_MY 0x80  ///< Bottom to top
 #define MADCTL_MX 0x40  ///< Right to left
 #define MADCTL_MV 0x20  ///< Reverse Mode
@@ -82,6 +92,11 @@
 #define MADCTL_BGR 0x08 ///< Blue-Green-Red pixel order
 #define MADCTL_MH 0x04  ///< LCD refresh right to left
 
+// MADCTL for each setRotation() value
+static const uint8_t rotationMadctl[4] = {
+    MADCTL_MX | MADCTL_BGR, MADCTL_MV | MADCTL_BGR, MADCTL_MY | MADCTL_BGR,
+    MADCTL_MX | MADCTL_MY | MADCTL_MV | MADCTL_BGR};
+
 /**************************************************************************/
 /*!
     @brief  Instantiate Adafruit ILI9341 driver with software SPI
@@ -163,7 +178,7 @@ static const uint8_t PROGMEM initcmd[] = {
   ILI9341_VMCTR2  , 1, 0x86,             // VCM control2
   ILI9341_MADCTL  , 1, 0x48,             // Memory Access Control
   ILI9341_VSCRSADD, 1, 0x00,             // Vertical scroll zero
-  ILI9341_PIXFMT  , 1, 0x55,
+  ILI9341_PIXFMT  , 1, ILI9341_PIXFMT_DEFAULT,
   ILI9341_FRMCTR1 , 2, 0x00, 0x18,
   ILI9341_DFUNCTR , 3, 0x08, 0x82, 0x27, // Display Function Control
   0xF2, 1, 0x00,                         // 3Gamma Function Disable
@@ -172,8 +187,6 @@ static const uint8_t PROGMEM initcmd[] = {
     0x4E, 0xF1, 0x37, 0x07, 0x10, 0x03, 0x0E, 0x09, 0x00,
   ILI9341_GMCTRN1 , 15, 0x00, 0x0E, 0x14, 0x03, 0x11, 0x07, // Set Gamma
     0x31, 0xC1, 0x48, 0x08, 0x0F, 0x0C, 0x31, 0x36, 0x0F,
-  ILI9341_SLPOUT  , 0x80,                // Exit Sleep
-  ILI9341_DISPON  , 0x80,                // Display on
   0x00                                   // End of list
 };
 // clang-format on
@@ -181,34 +194,157 @@ static const uint8_t PROGMEM initcmd[] = {
 /**************************************************************************/
 /*!
     @brief   Initialize ILI9341 chip
-    Connects to the ILI9341 over SPI and sends initialization procedure commands
+    Connects to the ILI9341 over SPI and sends initialization procedure
+    commands, returning once the display is on. Equivalent to beginAsync()
+    followed by calling poll() until it returns true.
     @param    freq  Desired SPI clock frequency
 */
 /**************************************************************************/
 void Adafruit_ILI9341::begin(uint32_t freq) {
+  ILI9341_STATS_API(CONTROL);
+  beginAsync(freq);
+  while (!poll())
+    yield();
+}
+
+/**************************************************************************/
+/*!
+    @brief   Start initializing the ILI9341 without waiting for it. Resets
+             the controller and returns; keep calling poll() (e.g. while
+             bringing up other peripherals) until it returns true, and do
+             not draw before then.
+    @param    freq  Desired SPI clock frequency
+*/
+/**************************************************************************/
+void Adafruit_ILI9341::beginAsync(uint32_t freq) {
+  ILI9341_STATS_API(CONTROL);
 
   if (!freq)
     freq = SPI_DEFAULT_FREQ;
+  _writeFreq = freq;
+
+  // initSPI() would pulse the reset pin with 400 ms of delays; hide the pin
+  // from it and give the datasheet's 10 us minimum pulse here instead.
+  int8_t rst = _rst;
+  _rst = -1;
   initSPI(freq);
+  _rst = rst;
 
-  if (_rst < 0) {                 // If no hardware reset pin...
+  if (_rst >= 0) {
+    pinMode(_rst, OUTPUT);
+    digitalWrite(_rst, LOW);
+    delayMicroseconds(10);
+    digitalWrite(_rst, HIGH);
+  } else {                        // If no hardware reset pin...
     sendCommand(ILI9341_SWRESET); // Engage software reset
-    delay(150);
   }
+  _initState = ILI9341_INIT_RESET;
+  _initTime = micros();
+}
+
+/**************************************************************************/
+/*!
+    @brief   Advance the initialization started by beginAsync(). Each call
+             does at most one step and returns immediately if the panel
+             still needs time: ILI9341_RESET_DELAY ms after reset before the
+             register setup is sent, ILI9341_RESET_SLPOUT_DELAY ms after
+             reset before SLPOUT, then ILI9341_SLPOUT_DELAY ms before
+             DISPON.
+    @return  true once the display is initialized and on.
+*/
+/**************************************************************************/
+bool Adafruit_ILI9341::poll(void) {
+  ILI9341_STATS_API(CONTROL);
+  uint32_t elapsed = micros() - _initTime;
+
+  switch (_initState) {
+  case ILI9341_INIT_RESET:
+    if (elapsed < ILI9341_RESET_DELAY * 1000UL)
+      return false;
+    {
+      uint8_t cmd, numArgs;
+      const uint8_t *addr = initcmd;
+      while ((cmd = pgm_read_byte(addr++)) > 0) {
+        numArgs = pgm_read_byte(addr++);
+        sendCommand(cmd, addr, numArgs);
+        addr += numArgs;
+      }
+    }
+    _initState = ILI9341_INIT_WAKE; // _initTime stays at the reset
+    return false;
+
+  case ILI9341_INIT_WAKE:
+    // A reset taken while the panel is awake (any warm reboot of the MCU)
+    // forbids SLPOUT for 120 ms, although registers can be set after 5 ms
+    if (elapsed < ILI9341_RESET_SLPOUT_DELAY * 1000UL)
+      return false;
+    sendCommand(ILI9341_SLPOUT); // Exit Sleep
+    _initState = ILI9341_INIT_SLPOUT;
+    _initTime = micros();
+    return false;
+
+  case ILI9341_INIT_SLPOUT:
+    if (elapsed < ILI9341_SLPOUT_DELAY * 1000UL)
+      return false;
+    sendCommand(ILI9341_DISPON); // Display on
+    break;
+
+  case ILI9341_INIT_READY:
+    return true;
 
-  uint8_t cmd, x, numArgs;
-  const uint8_t *addr = initcmd;
-  while ((cmd = pgm_read_byte(addr++)) > 0) {
-    x = pgm_read_byte(addr++);
-    numArgs = x & 0x7F;
-    sendCommand(cmd, addr, numArgs);
-    addr += numArgs;
-    if (x & 0x80)
-      delay(150);
+  default: // beginAsync() not called
+    return false;
   }
 
   _width = ILI9341_TFTWIDTH;
   _height = ILI9341_TFTHEIGHT;
+
+  // The controller was just reset and programmed from initcmd[], so the
+  // shadow registers can be seeded with known values.
+  invalidateState();
+  _madctl = 0x48;
+  _pixfmt = ILI9341_PIXFMT_DEFAULT;
+  _scrollStart = 0;
+  _scrollTop = _scrollBottom = 0;
+  _inverted = false;
+  _sleeping = false;
+  _partialStart = 0;
+  _partialEnd = ILI9341_TFTHEIGHT - 1;
+  _partialMode = false;
+  _idleMode = false;
+  _tearing = false;
+  _frameRate[0][0] = 0x00; // FRMCTR1 from initcmd[]
+  _frameRate[0][1] = 0x18;
+  for (uint8_t i = 1; i < 3; i++) { // FRMCTR2/3 reset defaults
+    _frameRate[i][0] = 0x00;
+    _frameRate[i][1] = 0x1B;
+  }
+  _stateValid = ILI9341_STATE_MADCTL | ILI9341_STATE_PIXFMT |
+                ILI9341_STATE_VSCRSADD | ILI9341_STATE_VSCRDEF |
+                ILI9341_STATE_INVERT | ILI9341_STATE_SLEEP |
+                ILI9341_STATE_PTLAR | ILI9341_STATE_PARTIAL |
+                ILI9341_STATE_IDLE | ILI9341_STATE_FRMCTR1 |
+                ILI9341_STATE_FRMCTR2 | ILI9341_STATE_FRMCTR3 |
+                ILI9341_STATE_TE;
+  if ((_pixfmt == ILI9341_PIXFMT_18BIT) && (connection == TFT_PARALLEL) &&
+      tft8.wide) // initcmd[] asked for a format this bus can't carry
+    setPixelFormat(ILI9341_PIXFMT_16BIT);
+  _initState = ILI9341_INIT_READY;
+  return true;
+}
+
+/**************************************************************************/
+/*!
+    @brief   Forget everything cached about the controller's registers, so
+             the next call to each setter is sent to the display regardless
+             of its argument. Call this after writing registers directly
+             with sendCommand()/writeCommand() or after resetting the panel
+             outside of begin().
+*/
+/**************************************************************************/
+void Adafruit_ILI9341::invalidateState(void) {
+  _winX1 = _winX2 = _winY1 = _winY2 = 0xFFFF;
+  _stateValid = 0;
 }
 
 /**************************************************************************/
@@ -218,31 +354,22 @@ void Adafruit_ILI9341::begin(uint32_t freq) {
 */
 /**************************************************************************/
 void Adafruit_ILI9341::setRotation(uint8_t m) {
+  ILI9341_STATS_API(CONTROL);
   rotation = m % 4; // can't be higher than 3
-  switch (rotation) {
-  case 0:
-    m = (MADCTL_MX | MADCTL_BGR);
-    _width = ILI9341_TFTWIDTH;
-    _height = ILI9341_TFTHEIGHT;
-    break;
-  case 1:
-    m = (MADCTL_MV | MADCTL_BGR);
+  m = rotationMadctl[rotation];
+  if (rotation & 1) {
     _width = ILI9341_TFTHEIGHT;
     _height = ILI9341_TFTWIDTH;
-    break;
-  case 2:
-    m = (MADCTL_MY | MADCTL_BGR);
+  } else {
     _width = ILI9341_TFTWIDTH;
     _height = ILI9341_TFTHEIGHT;
-    break;
-  case 3:
-    m = (MADCTL_MX | MADCTL_MY | MADCTL_MV | MADCTL_BGR);
-    _width = ILI9341_TFTHEIGHT;
-    _height = ILI9341_TFTWIDTH;
-    break;
   }
 
+  if ((_stateValid & ILI9341_STATE_MADCTL) && (m == _madctl))
+    return;
   sendCommand(ILI9341_MADCTL, &m, 1);
+  _madctl = m;
+  _stateValid |= ILI9341_STATE_MADCTL;
 }
 
 /**************************************************************************/
@@ -252,7 +379,226 @@ void Adafruit_ILI9341::setRotation(uint8_t m) {
 */
 /**************************************************************************/
 void Adafruit_ILI9341::invertDisplay(bool invert) {
+  ILI9341_STATS_API(CONTROL);
+  if ((_stateValid & ILI9341_STATE_INVERT) && (invert == _inverted))
+    return;
   sendCommand(invert ? ILI9341_INVON : ILI9341_INVOFF);
+  _inverted = invert;
+  _stateValid |= ILI9341_STATE_INVERT;
+}
+
+/**************************************************************************/
+/*!
+    @brief   Select the interface pixel format. All drawing functions follow
+             the selected format: 16-bit sends RGB565 (2 bytes/pixel),
+             18-bit sends RGB666 (3 bytes/pixel, so 50% more bus traffic)
+             and lets the *888 functions show full-precision colour.
+             18-bit mode needs SPI or an 8-bit parallel connection; on a
+             16-bit parallel bus it is ignored and the format stays 16-bit.
+    @param   fmt ILI9341_PIXFMT_16BIT or ILI9341_PIXFMT_18BIT
+*/
+/**************************************************************************/
+void Adafruit_ILI9341::setPixelFormat(uint8_t fmt) {
+  ILI9341_STATS_API(CONTROL);
+  if ((fmt != ILI9341_PIXFMT_16BIT) && (fmt != ILI9341_PIXFMT_18BIT))
+    return;
+  if ((fmt == ILI9341_PIXFMT_18BIT) && (connection == TFT_PARALLEL) &&
+      tft8.wide) // 3-byte pixels don't map onto 16-bit bus writes
+    return;
+  if ((_stateValid & ILI9341_STATE_PIXFMT) && (fmt == _pixfmt))
+    return;
+  sendCommand(ILI9341_PIXFMT, &fmt, 1);
+  _pixfmt = fmt;
+  _stateValid |= ILI9341_STATE_PIXFMT;
+}
+
+/**************************************************************************/
+/*!
+    @brief   Enter or leave sleep mode. The controller needs 5 ms after
+             either command (120 ms after SLPOUT before the next SLPIN);
+             timing is left to the caller.
+    @param   enable True to enter sleep (SLPIN), False to wake (SLPOUT)
+*/
+/**************************************************************************/
+void Adafruit_ILI9341::enableSleep(bool enable) {
+  ILI9341_STATS_API(CONTROL);
+  if ((_stateValid & ILI9341_STATE_SLEEP) && (enable == _sleeping))
+    return;
+  sendCommand(enable ? ILI9341_SLPIN : ILI9341_SLPOUT);
+  _sleeping = enable;
+  _stateValid |= ILI9341_STATE_SLEEP;
+}
+
+/**************************************************************************/
+/*!
+    @brief   Set the rows shown in partial mode. Rows are panel gate lines
+             (0-319, rotation 0 order); start may exceed end to wrap around
+             the bottom. Outside this area the panel shows the non-display
+             colour and skips refreshing it.
+    @param   start First displayed row
+    @param   end   Last displayed row
+*/
+/**************************************************************************/
+void Adafruit_ILI9341::setPartialArea(uint16_t start, uint16_t end) {
+  ILI9341_STATS_API(CONTROL);
+  if ((start >= ILI9341_TFTHEIGHT) || (end >= ILI9341_TFTHEIGHT))
+    return;
+  if ((_stateValid & ILI9341_STATE_PTLAR) && (start == _partialStart) &&
+      (end == _partialEnd))
+    return;
+  uint8_t data[4];
+  data[0] = start >> 8;
+  data[1] = start & 0xff;
+  data[2] = end >> 8;
+  data[3] = end & 0xff;
+  sendCommand(ILI9341_PTLAR, data, 4);
+  _partialStart = start;
+  _partialEnd = end;
+  _stateValid |= ILI9341_STATE_PTLAR;
+}
+
+/**************************************************************************/
+/*!
+    @brief   Switch between partial mode (only the setPartialArea() band is
+             driven, at the FRMCTR3 frame rate) and normal full-screen mode
+    @param   enable True for partial mode (PTLON), False for normal (NORON)
+*/
+/**************************************************************************/
+void Adafruit_ILI9341::enablePartialMode(bool enable) {
+  ILI9341_STATS_API(CONTROL);
+  if ((_stateValid & ILI9341_STATE_PARTIAL) && (enable == _partialMode))
+    return;
+  sendCommand(enable ? ILI9341_PTLON : ILI9341_NORON);
+  _partialMode = enable;
+  _stateValid |= ILI9341_STATE_PARTIAL;
+}
+
+/**************************************************************************/
+/*!
+    @brief   Enter or leave idle mode: 8 colours (MSB of each channel only)
+             at the FRMCTR2 frame rate, for minimum panel current
+    @param   enable True for idle mode (IDMON), False to leave it (IDMOFF)
+*/
+/**************************************************************************/
+void Adafruit_ILI9341::enableIdleMode(bool enable) {
+  ILI9341_STATS_API(CONTROL);
+  if ((_stateValid & ILI9341_STATE_IDLE) && (enable == _idleMode))
+    return;
+  sendCommand(enable ? ILI9341_IDMON : ILI9341_IDMOFF);
+  _idleMode = enable;
+  _stateValid |= ILI9341_STATE_IDLE;
+}
+
+/**************************************************************************/
+/*!
+    @brief   Program a frame rate control register directly
+    @param   reg   ILI9341_FRMCTR1 (normal), ILI9341_FRMCTR2 (idle) or
+                   ILI9341_FRMCTR3 (partial)
+    @param   diva  Oscillator division: 0-3 for fosc/1, /2, /4, /8
+    @param   rtna  Clocks per line, 16-31
+*/
+/**************************************************************************/
+void Adafruit_ILI9341::setFrameRateControl(uint8_t reg, uint8_t diva,
+                                           uint8_t rtna) {
+  ILI9341_STATS_API(CONTROL);
+  if ((reg < ILI9341_FRMCTR1) || (reg > ILI9341_FRMCTR3))
+    return;
+  uint8_t *shadow = _frameRate[reg - ILI9341_FRMCTR1];
+  uint16_t bit = ILI9341_STATE_FRMCTR1 << (reg - ILI9341_FRMCTR1);
+  uint8_t data[2] = {(uint8_t)(diva & 0x03), (uint8_t)(rtna & 0x1F)};
+  if (data[1] < 0x10)
+    data[1] = 0x10;
+  if ((_stateValid & bit) && (shadow[0] == data[0]) && (shadow[1] == data[1]))
+    return;
+  sendCommand(reg, data, 2);
+  shadow[0] = data[0];
+  shadow[1] = data[1];
+  _stateValid |= bit;
+}
+
+/**************************************************************************/
+/*!
+    @brief   Choose the closest achievable frame rate for one of the three
+             panel modes. Lower rates cut panel and driver current. The
+             rate is fosc / (clocks per line * division * 324 lines), with
+             fosc nominally 615 kHz, so roughly 8-119 Hz is available.
+    @param   hz   Desired frame rate in Hz
+    @param   reg  ILI9341_FRMCTR1 (normal), ILI9341_FRMCTR2 (idle) or
+                  ILI9341_FRMCTR3 (partial)
+    @return  The nominal frame rate selected, in Hz
+*/
+/**************************************************************************/
+uint8_t Adafruit_ILI9341::setFrameRate(uint8_t hz, uint8_t reg) {
+  if (!hz)
+    hz = 1;
+  uint8_t bestDiv = 0, bestClocks = 0x10;
+  uint32_t bestErr = 0xFFFFFFFF;
+  for (uint8_t div = 0; div < 4; div++) {
+    for (uint8_t clocks = 0x10; clocks <= 0x1F; clocks++) {
+      uint32_t rate = ILI9341_OSC_HZ * 10UL /
+                      ((uint32_t)clocks * (1 << div) * ILI9341_FRAME_LINES);
+      uint32_t err = (rate > hz * 10UL) ? rate - hz * 10UL : hz * 10UL - rate;
+      if (err < bestErr) {
+        bestErr = err;
+        bestDiv = div;
+        bestClocks = clocks;
+      }
+    }
+  }
+  setFrameRateControl(reg, bestDiv, bestClocks);
+  return (ILI9341_OSC_HZ + bestClocks * (1UL << bestDiv) * ILI9341_FRAME_LINES /
+                              2) /
+         ((uint32_t)bestClocks * (1 << bestDiv) * ILI9341_FRAME_LINES);
+}
+
+/**************************************************************************/
+/*!
+    @brief   Return to normal full-colour, full-screen operation (leaves
+             idle and partial modes). Frame rate settings are kept, and
+             nothing is sent for modes that are already off.
+*/
+/**************************************************************************/
+void Adafruit_ILI9341::normalMode(void) {
+  enableIdleMode(false);
+  enablePartialMode(false);
+}
+
+/**************************************************************************/
+/*!
+    @brief   Turn the TE (tearing effect) output on or off. When on, TE goes
+             high while the panel is in vertical blanking.
+    @param   enable True to drive TE (TEON, V-blank only), False for TEOFF
+*/
+/**************************************************************************/
+void Adafruit_ILI9341::setTearingEffect(bool enable) {
+  ILI9341_STATS_API(CONTROL);
+  if ((_stateValid & ILI9341_STATE_TE) && (enable == _tearing))
+    return;
+  if (enable) {
+    uint8_t mode = 0x00; // TELOM = 0: V-blanking information only
+    sendCommand(ILI9341_TEON, &mode, 1);
+  } else {
+    sendCommand(ILI9341_TEOFF);
+  }
+  _tearing = enable;
+  _stateValid |= ILI9341_STATE_TE;
+}
+
+/**************************************************************************/
+/*!
+    @brief   Nominal time the panel takes to refresh one frame in its
+             current mode, from the cached FRMCTR1/2/3 setting. The real
+             oscillator can be off by several percent.
+    @return  Frame period in microseconds
+*/
+/**************************************************************************/
+uint32_t Adafruit_ILI9341::framePeriodMicros(void) const {
+  const uint8_t *f = _frameRate[_idleMode ? 1 : (_partialMode ? 2 : 0)];
+  uint32_t clocks = f[1] & 0x1F;
+  if (clocks < 0x10)
+    clocks = 0x10;
+  return clocks * (1UL << (f[0] & 0x03)) * ILI9341_FRAME_LINES * 1000UL /
+         (ILI9341_OSC_HZ / 1000);
 }
 
 /**************************************************************************/
@@ -262,10 +608,15 @@ void Adafruit_ILI9341::invertDisplay(bool invert) {
 */
 /**************************************************************************/
 void Adafruit_ILI9341::scrollTo(uint16_t y) {
+  ILI9341_STATS_API(CONTROL);
+  if ((_stateValid & ILI9341_STATE_VSCRSADD) && (y == _scrollStart))
+    return;
   uint8_t data[2];
   data[0] = y >> 8;
   data[1] = y & 0xff;
   sendCommand(ILI9341_VSCRSADD, (uint8_t *)data, 2);
+  _scrollStart = y;
+  _stateValid |= ILI9341_STATE_VSCRSADD;
 }
 
 /**************************************************************************/
@@ -276,8 +627,12 @@ void Adafruit_ILI9341::scrollTo(uint16_t y) {
  */
 /**************************************************************************/
 void Adafruit_ILI9341::setScrollMargins(uint16_t top, uint16_t bottom) {
+  ILI9341_STATS_API(CONTROL);
   // TFA+VSA+BFA must equal 320
   if (top + bottom <= ILI9341_TFTHEIGHT) {
+    if ((_stateValid & ILI9341_STATE_VSCRDEF) && (top == _scrollTop) &&
+        (bottom == _scrollBottom))
+      return;
     uint16_t middle = ILI9341_TFTHEIGHT - (top + bottom);
     uint8_t data[6];
     data[0] = top >> 8;
@@ -287,6 +642,9 @@ void Adafruit_ILI9341::setScrollMargins(uint16_t top, uint16_t bottom) {
     data[4] = bottom >> 8;
     data[5] = bottom & 0xff;
     sendCommand(ILI9341_VSCRDEF, (uint8_t *)data, 6);
+    _scrollTop = top;
+    _scrollBottom = bottom;
+    _stateValid |= ILI9341_STATE_VSCRDEF;
   }
 }
 
@@ -294,7 +652,8 @@ void Adafruit_ILI9341::setScrollMargins(uint16_t top, uint16_t bottom) {
 /*!
     @brief   Set the "address window" - the rectangle we will write to RAM with
    the next chunk of      SPI data writes. The ILI9341 will automatically wrap
-   the data as each row is filled
+   the data as each row is filled. CASET/PASET are only sent when they differ
+   from this instance's cached window.
     @param   x1  TFT memory 'x' origin
     @param   y1  TFT memory 'y' origin
     @param   w   Width of rectangle
@@ -303,25 +662,35 @@ void Adafruit_ILI9341::setScrollMargins(uint16_t top, uint16_t bottom) {
 /**************************************************************************/
 void Adafruit_ILI9341::setAddrWindow(uint16_t x1, uint16_t y1, uint16_t w,
                                      uint16_t h) {
-  static uint16_t old_x1 = 0xffff, old_x2 = 0xffff;
-  static uint16_t old_y1 = 0xffff, old_y2 = 0xffff;
+  ILI9341_STATS_API(STREAM);
+  setWindow(x1, y1, w, h);
+  writeCommand(ILI9341_RAMWR); // Write to RAM
+}
 
+// Send CASET/PASET for a window, skipping whichever matches the cache.
+// Leaves the controller ready for RAMWR or RAMRD.
+void Adafruit_ILI9341::setWindow(uint16_t x1, uint16_t y1, uint16_t w,
+                                 uint16_t h) {
   uint16_t x2 = (x1 + w - 1), y2 = (y1 + h - 1);
-  if (x1 != old_x1 || x2 != old_x2) {
+  ILI9341_STATS_ADD(windows, 1);
+  ILI9341_STATS_ADD(windowsCached, (x1 == _winX1) && (x2 == _winX2) &&
+                                       (y1 == _winY1) && (y2 == _winY2));
+  if (x1 != _winX1 || x2 != _winX2) {
     writeCommand(ILI9341_CASET); // Column address set
     SPI_WRITE16(x1);
     SPI_WRITE16(x2);
-    old_x1 = x1;
-    old_x2 = x2;
+    ILI9341_STATS_ADD(dataBytes, 4);
+    _winX1 = x1;
+    _winX2 = x2;
   }
-  if (y1 != old_y1 || y2 != old_y2) {
+  if (y1 != _winY1 || y2 != _winY2) {
     writeCommand(ILI9341_PASET); // Row address set
     SPI_WRITE16(y1);
     SPI_WRITE16(y2);
-    old_y1 = y1;
-    old_y2 = y2;
+    ILI9341_STATS_ADD(dataBytes, 4);
+    _winY1 = y1;
+    _winY2 = y2;
   }
-  writeCommand(ILI9341_RAMWR); // Write to RAM
 }
 
 /**************************************************************************/
@@ -335,7 +704,1392 @@ void Adafruit_ILI9341::setAddrWindow(uint16_t x1, uint16_t y1, uint16_t w,
  */
 /**************************************************************************/
 uint8_t Adafruit_ILI9341::readcommand8(uint8_t commandByte, uint8_t index) {
+  ILI9341_STATS_API(READ);
   uint8_t data = 0x10 + index;
   sendCommand(0xD9, &data, 1); // Set Index Register
+  ILI9341_STATS_ADD(commands, 1);
+  ILI9341_STATS_ADD(readBytes, 1);
   return Adafruit_SPITFT::readcommand8(commandByte);
 }
+
+/**************************************************************************/
+/*!
+    @brief  Read a rectangle of GRAM back as RGB565. The panel always
+            returns 18-bit pixels (3 bytes) after a dummy byte, whatever the
+            pixel format; they are reduced to 565 here. The bus runs at the
+            setReadSpeed() clock for the read and is put back to the begin()
+            clock afterward, so call this outside startWrite()/endWrite().
+            Needs MISO (or the parallel read strobe) to be connected.
+    @param  x    Left edge.
+    @param  y    Top edge.
+    @param  w    Width in pixels.
+    @param  h    Height in pixels.
+    @param  dst  Receives w * h pixels, row-major. Entries for any part of
+                 the rectangle that lies off-screen are left unchanged.
+*/
+/**************************************************************************/
+void Adafruit_ILI9341::readPixels(int16_t x, int16_t y, int16_t w, int16_t h,
+                                  uint16_t *dst) {
+  ILI9341_STATS_API(READ);
+  int16_t cx = x, cy = y, cw = w, ch = h;
+  if ((w <= 0) || (h <= 0) || !clipRect(cx, cy, cw, ch))
+    return;
+  dst += (int32_t)(cy - y) * w + (cx - x);
+
+  setSPISpeed(_readFreq);
+  startWrite();
+  setWindow(cx, cy, cw, ch);
+  writeCommand(ILI9341_RAMRD);
+  spiRead(); // Dummy byte
+  for (int16_t j = 0; j < ch; j++, dst += w) {
+    for (int16_t i = 0; i < cw; i++) {
+      uint8_t r = spiRead(), g = spiRead(), b = spiRead();
+      dst[i] = ((uint16_t)(r & 0xF8) << 8) | ((uint16_t)(g & 0xFC) << 3) |
+               (b >> 3);
+    }
+  }
+  endWrite();
+  setSPISpeed(_writeFreq);
+}
+
+// Encode one row of RGB565 pixels for dumpScreen(). Returns bytes written
+// to out, which must hold 3 * w bytes.
+static uint16_t encodeDumpRow(const uint16_t *pix, uint16_t w, uint8_t format,
+                              uint8_t *out) {
+  uint8_t *o = out;
+  if (format == ILI9341_DUMP_PPM) {
+    for (uint16_t i = 0; i < w; i++) {
+      uint16_t c = pix[i];
+      uint8_t r = c >> 11, g = (c >> 5) & 0x3F, b = c & 0x1F;
+      *o++ = (r << 3) | (r >> 2);
+      *o++ = (g << 2) | (g >> 4);
+      *o++ = (b << 3) | (b >> 2);
+    }
+    return o - out;
+  }
+  uint16_t i = 0;
+  uint8_t *lit = NULL; // Header of the open literal packet
+  while (i < w) {
+    uint16_t r = 1;
+    while ((i + r < w) && (r < 128) && (pix[i + r] == pix[i]))
+      r++;
+    if (r >= 3) {
+      *o++ = 0x80 | (r - 1);
+      *o++ = pix[i] >> 8;
+      *o++ = pix[i];
+      i += r;
+      lit = NULL;
+    } else {
+      if (!lit || (*lit == 127)) {
+        lit = o++;
+        *lit = 0xFF; // Becomes 0 with the first pixel
+      }
+      (*lit)++;
+      *o++ = pix[i] >> 8;
+      *o++ = pix[i];
+      i++;
+    }
+  }
+  return o - out;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Send a screenshot of the whole screen (in the current rotation)
+            to a Print target such as Serial or an SD card File. GRAM is
+            read back a whole row per readPixels() call into two
+            alternating row buffers. Each finished row is written in two
+            parts: as many bytes as availableForWrite() says can go without
+            blocking, then, after the next row has been read, the rest. A
+            buffered serial port therefore drains while the panel is being
+            read. Uses about 7 bytes per screen column.
+
+            ILI9341_DUMP_RLE565 output is 'R' '5', width and height (2
+            bytes each, big-endian), then for each row, packets that do not
+            cross rows: 0x80 | (n - 1) and one colour is a run of n pixels;
+            n - 1 (below 0x80) is followed by n colours. Colours are RGB565,
+            big-endian. extras/screenshot_decode converts it to PPM.
+    @param  out     Where to write the image.
+    @param  format  ILI9341_DUMP_PPM or ILI9341_DUMP_RLE565.
+    @return false if the buffers could not be allocated.
+*/
+/**************************************************************************/
+bool Adafruit_ILI9341::dumpScreen(Print &out, uint8_t format) {
+  ILI9341_STATS_API(READ);
+  const uint16_t w = _width, h = _height;
+  uint16_t *pix = (uint16_t *)malloc(2 * w * sizeof(uint16_t));
+  uint8_t *enc = (uint8_t *)malloc(3 * w);
+  if (!pix || !enc) {
+    free(pix);
+    free(enc);
+    return false;
+  }
+
+  if (format == ILI9341_DUMP_PPM) {
+    out.print(F("P6\n"));
+    out.print(w);
+    out.print(' ');
+    out.print(h);
+    out.print(F("\n255\n"));
+  } else {
+    uint8_t header[6] = {'R', '5', (uint8_t)(w >> 8), (uint8_t)w,
+                         (uint8_t)(h >> 8), (uint8_t)h};
+    out.write(header, sizeof header);
+  }
+
+  uint8_t cur = 0;
+  readPixels(0, 0, w, 1, pix);
+  for (uint16_t row = 0; row < h; row++) {
+    uint16_t len = encodeDumpRow(&pix[cur * w], w, format, enc), sent = 0;
+    int room = out.availableForWrite(); // What fits without blocking
+    if (room > len)
+      room = len;
+    if (room > 0)
+      sent = out.write(enc, room);
+    if (row + 1 < h) // The port drains while the next row is read
+      readPixels(0, row + 1, w, 1, &pix[(cur ^ 1) * w]);
+    if (sent < len)
+      out.write(&enc[sent], len - sent);
+    cur ^= 1;
+  }
+
+  free(pix);
+  free(enc);
+  return true;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Clip a rectangle to the screen, normalizing negative sizes.
+    @param  x  Left edge, updated in place.
+    @param  y  Top edge, updated in place.
+    @param  w  Width, updated in place.
+    @param  h  Height, updated in place.
+    @return true if anything is left to draw.
+*/
+/**************************************************************************/
+bool Adafruit_ILI9341::clipRect(int16_t &x, int16_t &y, int16_t &w,
+                                int16_t &h) const {
+  if (w < 0) {
+    x += w + 1;
+    w = -w;
+  }
+  if (h < 0) {
+    y += h + 1;
+    h = -h;
+  }
+  if (x < 0) {
+    w += x;
+    x = 0;
+  }
+  if (y < 0) {
+    h += y;
+    y = 0;
+  }
+  if (x + w > _width)
+    w = _width - x;
+  if (y + h > _height)
+    h = _height - y;
+  return (w > 0) && (h > 0);
+}
+
+// Send one RGB565 colour as an RGB666 pixel. The controller uses bits 7-2
+// of each byte; the top bits of R and B are replicated into the sixth bit.
+void Adafruit_ILI9341::write666(uint16_t color) {
+  ILI9341_STATS_ADD(pixelBytes, 3);
+  spiWrite(((color >> 8) & 0xF8) | ((color >> 13) & 0x04));
+  spiWrite((color >> 3) & 0xFC);
+  spiWrite(((color << 3) & 0xF8) | ((color >> 2) & 0x04));
+}
+
+// Stream packed bytes, four at a time through the 32-bit write path
+void Adafruit_ILI9341::writeBytes666(const uint8_t *bytes, uint32_t len) {
+  ILI9341_STATS_ADD(pixelBytes, len);
+  for (; len >= 4; len -= 4, bytes += 4)
+    SPI_WRITE32(((uint32_t)bytes[0] << 24) | ((uint32_t)bytes[1] << 16) |
+                ((uint32_t)bytes[2] << 8) | bytes[3]);
+  while (len--)
+    spiWrite(*bytes++);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Draw a single pixel (own transaction).
+    @param  x      X coordinate.
+    @param  y      Y coordinate.
+    @param  color  RGB565 colour.
+*/
+/**************************************************************************/
+void Adafruit_ILI9341::drawPixel(int16_t x, int16_t y, uint16_t color) {
+  ILI9341_STATS_API(PIXEL);
+  if (_pixfmt != ILI9341_PIXFMT_18BIT) {
+    ILI9341_STATS_ADD(pixelBytes, rectBytes(x, y, 1, 1));
+    Adafruit_SPITFT::drawPixel(x, y, color);
+    return;
+  }
+  if ((x >= 0) && (x < _width) && (y >= 0) && (y < _height)) {
+    startWrite();
+    setAddrWindow(x, y, 1, 1);
+    write666(color);
+    endWrite();
+  }
+}
+
+/**************************************************************************/
+/*!
+    @brief  Draw a single pixel inside an open transaction.
+    @param  x      X coordinate.
+    @param  y      Y coordinate.
+    @param  color  RGB565 colour.
+*/
+/**************************************************************************/
+void Adafruit_ILI9341::writePixel(int16_t x, int16_t y, uint16_t color) {
+  ILI9341_STATS_API(PIXEL);
+  if (_pixfmt != ILI9341_PIXFMT_18BIT) {
+    ILI9341_STATS_ADD(pixelBytes, rectBytes(x, y, 1, 1));
+    Adafruit_SPITFT::writePixel(x, y, color);
+    return;
+  }
+  if ((x >= 0) && (x < _width) && (y >= 0) && (y < _height)) {
+    setAddrWindow(x, y, 1, 1);
+    write666(color);
+  }
+}
+
+/**************************************************************************/
+/*!
+    @brief  Send one pixel to the current address window.
+    @param  color  RGB565 colour.
+*/
+/**************************************************************************/
+void Adafruit_ILI9341::writePixel(uint16_t color) {
+  ILI9341_STATS_API(STREAM);
+  if (_pixfmt != ILI9341_PIXFMT_18BIT) {
+    ILI9341_STATS_ADD(pixelBytes, 2);
+    Adafruit_SPITFT::writePixel(color);
+  } else {
+    write666(color);
+  }
+}
+
+/**************************************************************************/
+/*!
+    @brief  Send RGB565 pixels to the current address window. In 18-bit
+            mode four pixels are packed into three 32-bit writes.
+    @param  colors     RGB565 pixels.
+    @param  len        Number of pixels.
+    @param  block      If false, may return before a DMA transfer finishes
+                       (16-bit mode only; call dmaWait() before reuse).
+    @param  bigEndian  True if the pixels are already big-endian.
+*/
+/**************************************************************************/
+void Adafruit_ILI9341::writePixels(uint16_t *colors, uint32_t len, bool block,
+                                   bool bigEndian) {
+  ILI9341_STATS_API(STREAM);
+  if (_pixfmt != ILI9341_PIXFMT_18BIT) {
+    ILI9341_STATS_ADD(pixelBytes, len * 2);
+    Adafruit_SPITFT::writePixels(colors, len, block, bigEndian);
+    return;
+  }
+  uint8_t packed[12];
+  while (len) {
+    uint8_t n = (len < 4) ? len : 4;
+    for (uint8_t i = 0; i < n; i++) {
+      uint16_t c = *colors++;
+      if (bigEndian)
+        c = (c << 8) | (c >> 8);
+      packed[i * 3] = ((c >> 8) & 0xF8) | ((c >> 13) & 0x04);
+      packed[i * 3 + 1] = (c >> 3) & 0xFC;
+      packed[i * 3 + 2] = ((c << 3) & 0xF8) | ((c >> 2) & 0x04);
+    }
+    writeBytes666(packed, n * 3);
+    len -= n;
+  }
+}
+
+/**************************************************************************/
+/*!
+    @brief  Send the same RGB565 colour repeatedly to the address window.
+    @param  color  RGB565 colour.
+    @param  len    Number of pixels.
+*/
+/**************************************************************************/
+void Adafruit_ILI9341::writeColor(uint16_t color, uint32_t len) {
+  ILI9341_STATS_API(STREAM);
+  if (_pixfmt != ILI9341_PIXFMT_18BIT) {
+    ILI9341_STATS_ADD(pixelBytes, len * 2);
+    Adafruit_SPITFT::writeColor(color, len);
+    return;
+  }
+  uint8_t r = ((color >> 8) & 0xF8) | ((color >> 13) & 0x04),
+          g = (color >> 3) & 0xFC,
+          b = ((color << 3) & 0xF8) | ((color >> 2) & 0x04);
+  writeColor888(((uint32_t)r << 16) | ((uint16_t)g << 8) | b, len);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Fill a rectangle inside an open transaction.
+    @param  x      Left edge.
+    @param  y      Top edge.
+    @param  w      Width in pixels.
+    @param  h      Height in pixels.
+    @param  color  RGB565 colour.
+*/
+/**************************************************************************/
+void Adafruit_ILI9341::writeFillRect(int16_t x, int16_t y, int16_t w,
+                                     int16_t h, uint16_t color) {
+  ILI9341_STATS_API(FILLRECT);
+  if (_pixfmt != ILI9341_PIXFMT_18BIT) {
+    ILI9341_STATS_ADD(pixelBytes, rectBytes(x, y, w, h));
+    Adafruit_SPITFT::writeFillRect(x, y, w, h, color);
+    return;
+  }
+  if (clipRect(x, y, w, h)) {
+    setAddrWindow(x, y, w, h);
+    writeColor(color, (uint32_t)w * h);
+  }
+}
+
+/**************************************************************************/
+/*!
+    @brief  Draw a horizontal line inside an open transaction.
+    @param  x      Left end.
+    @param  y      Row.
+    @param  w      Length in pixels.
+    @param  color  RGB565 colour.
+*/
+/**************************************************************************/
+void Adafruit_ILI9341::writeFastHLine(int16_t x, int16_t y, int16_t w,
+                                      uint16_t color) {
+  ILI9341_STATS_API(HLINE);
+  if (_pixfmt != ILI9341_PIXFMT_18BIT) {
+    ILI9341_STATS_ADD(pixelBytes, rectBytes(x, y, w, 1));
+    Adafruit_SPITFT::writeFastHLine(x, y, w, color);
+  } else {
+    writeFillRect(x, y, w, 1, color);
+  }
+}
+
+/**************************************************************************/
+/*!
+    @brief  Draw a vertical line inside an open transaction.
+    @param  x      Column.
+    @param  y      Top end.
+    @param  h      Length in pixels.
+    @param  color  RGB565 colour.
+*/
+/**************************************************************************/
+void Adafruit_ILI9341::writeFastVLine(int16_t x, int16_t y, int16_t h,
+                                      uint16_t color) {
+  ILI9341_STATS_API(VLINE);
+  if (_pixfmt != ILI9341_PIXFMT_18BIT) {
+    ILI9341_STATS_ADD(pixelBytes, rectBytes(x, y, 1, h));
+    Adafruit_SPITFT::writeFastVLine(x, y, h, color);
+  } else {
+    writeFillRect(x, y, 1, h, color);
+  }
+}
+
+/**************************************************************************/
+/*!
+    @brief  Fill a rectangle (own transaction).
+    @param  x      Left edge.
+    @param  y      Top edge.
+    @param  w      Width in pixels.
+    @param  h      Height in pixels.
+    @param  color  RGB565 colour.
+*/
+/**************************************************************************/
+void Adafruit_ILI9341::fillRect(int16_t x, int16_t y, int16_t w, int16_t h,
+                                uint16_t color) {
+  ILI9341_STATS_API(FILLRECT);
+  if (_pixfmt != ILI9341_PIXFMT_18BIT) {
+    ILI9341_STATS_ADD(pixelBytes, rectBytes(x, y, w, h));
+    Adafruit_SPITFT::fillRect(x, y, w, h, color);
+    return;
+  }
+  startWrite();
+  writeFillRect(x, y, w, h, color);
+  endWrite();
+}
+
+/**************************************************************************/
+/*!
+    @brief  Draw a horizontal line (own transaction).
+    @param  x      Left end.
+    @param  y      Row.
+    @param  w      Length in pixels.
+    @param  color  RGB565 colour.
+*/
+/**************************************************************************/
+void Adafruit_ILI9341::drawFastHLine(int16_t x, int16_t y, int16_t w,
+                                     uint16_t color) {
+  ILI9341_STATS_API(HLINE);
+  if (_pixfmt != ILI9341_PIXFMT_18BIT) {
+    ILI9341_STATS_ADD(pixelBytes, rectBytes(x, y, w, 1));
+    Adafruit_SPITFT::drawFastHLine(x, y, w, color);
+  } else {
+    fillRect(x, y, w, 1, color);
+  }
+}
+
+/**************************************************************************/
+/*!
+    @brief  Draw a vertical line (own transaction).
+    @param  x      Column.
+    @param  y      Top end.
+    @param  h      Length in pixels.
+    @param  color  RGB565 colour.
+*/
+/**************************************************************************/
+void Adafruit_ILI9341::drawFastVLine(int16_t x, int16_t y, int16_t h,
+                                     uint16_t color) {
+  ILI9341_STATS_API(VLINE);
+  if (_pixfmt != ILI9341_PIXFMT_18BIT) {
+    ILI9341_STATS_ADD(pixelBytes, rectBytes(x, y, 1, h));
+    Adafruit_SPITFT::drawFastVLine(x, y, h, color);
+  } else {
+    fillRect(x, y, 1, h, color);
+  }
+}
+
+/**************************************************************************/
+/*!
+    @brief  Send one pixel to the current address window (own
+            transaction).
+    @param  color  RGB565 colour.
+*/
+/**************************************************************************/
+void Adafruit_ILI9341::pushColor(uint16_t color) {
+  ILI9341_STATS_API(STREAM);
+  if (_pixfmt != ILI9341_PIXFMT_18BIT) {
+    ILI9341_STATS_ADD(pixelBytes, 2);
+    Adafruit_SPITFT::pushColor(color);
+    return;
+  }
+  startWrite();
+  write666(color);
+  endWrite();
+}
+
+/**************************************************************************/
+/*!
+    @brief  Draw an RGB565 bitmap from RAM, clipped to the screen.
+    @param  x        Left edge.
+    @param  y        Top edge.
+    @param  pcolors  w * h RGB565 pixels, row-major.
+    @param  w        Bitmap width.
+    @param  h        Bitmap height.
+*/
+/**************************************************************************/
+void Adafruit_ILI9341::drawRGBBitmap(int16_t x, int16_t y, uint16_t *pcolors,
+                                     int16_t w, int16_t h) {
+  ILI9341_STATS_API(BITMAP);
+  if (_pixfmt != ILI9341_PIXFMT_18BIT) {
+    ILI9341_STATS_ADD(pixelBytes, ((w > 0) && (h > 0)) ? rectBytes(x, y, w, h)
+                                                       : 0);
+    Adafruit_SPITFT::drawRGBBitmap(x, y, pcolors, w, h);
+    return;
+  }
+  int16_t cx = x, cy = y, cw = w, ch = h;
+  if ((w <= 0) || (h <= 0) || !clipRect(cx, cy, cw, ch))
+    return;
+  pcolors += (int32_t)(cy - y) * w + (cx - x);
+  startWrite();
+  setAddrWindow(cx, cy, cw, ch);
+  while (ch--) {
+    writePixels(pcolors, cw);
+    pcolors += w;
+  }
+  endWrite();
+}
+
+// Panel position (rotation 0 coordinates) of address (x, y) under a MADCTL
+// value, and the reverse. MX/MY mirror the column/page address before MV
+// exchanges them.
+static void madctlToPanel(uint8_t m, int16_t x, int16_t y, int16_t &px,
+                          int16_t &py) {
+  bool mv = m & MADCTL_MV;
+  int16_t cmax = (mv ? ILI9341_TFTHEIGHT : ILI9341_TFTWIDTH) - 1;
+  int16_t pmax = (mv ? ILI9341_TFTWIDTH : ILI9341_TFTHEIGHT) - 1;
+  int16_t c = (m & MADCTL_MX) ? cmax - x : x;
+  int16_t p = (m & MADCTL_MY) ? pmax - y : y;
+  px = ILI9341_TFTWIDTH - 1 - (mv ? p : c);
+  py = mv ? c : p;
+}
+
+static void panelToMadctl(uint8_t m, int16_t px, int16_t py, int16_t &x,
+                          int16_t &y) {
+  bool mv = m & MADCTL_MV;
+  int16_t cmax = (mv ? ILI9341_TFTHEIGHT : ILI9341_TFTWIDTH) - 1;
+  int16_t pmax = (mv ? ILI9341_TFTWIDTH : ILI9341_TFTHEIGHT) - 1;
+  int16_t col = ILI9341_TFTWIDTH - 1 - px;
+  int16_t c = mv ? py : col, p = mv ? col : py;
+  x = (m & MADCTL_MX) ? cmax - c : c;
+  y = (m & MADCTL_MY) ? pmax - p : p;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Draw an RGB565 bitmap from RAM turned by a multiple of 90
+            degrees and/or mirrored, clipped to the screen. Instead of
+            moving pixels around, MADCTL is switched for the duration of
+            the blit to the orientation setRotation() would use for the
+            combined rotation, so the source streams out in stored order at
+            the cost of a plain drawRGBBitmap() plus two MADCTL writes.
+    @param  x       Left edge of the drawn (rotated) image.
+    @param  y       Top edge of the drawn image.
+    @param  bitmap  w * h RGB565 pixels, row-major.
+    @param  w       Bitmap width as stored.
+    @param  h       Bitmap height as stored.
+    @param  rot     Clockwise quarter turns, 0-3. For 1 and 3 the image
+                    drawn is h wide and w tall.
+    @param  mirror  Flip the bitmap left to right before turning it.
+*/
+/**************************************************************************/
+void Adafruit_ILI9341::drawRGBBitmapRotated(int16_t x, int16_t y,
+                                            uint16_t *bitmap, int16_t w,
+                                            int16_t h, uint8_t rot,
+                                            bool mirror) {
+  ILI9341_STATS_API(BITMAP);
+  rot &= 3;
+  if (!rot && !mirror) {
+    drawRGBBitmap(x, y, bitmap, w, h);
+    return;
+  }
+  int16_t cx = x, cy = y, cw = (rot & 1) ? h : w, ch = (rot & 1) ? w : h;
+  if ((w <= 0) || (h <= 0) || !clipRect(cx, cy, cw, ch))
+    return;
+
+  // Part of the (mirrored) source that lands in the clipped area
+  int16_t dx0 = cx - x, dx1 = dx0 + cw, dy0 = cy - y, dy1 = dy0 + ch;
+  int16_t i0, i1, j0, j1;
+  switch (rot) {
+  case 0:
+    i0 = dx0, i1 = dx1, j0 = dy0, j1 = dy1;
+    break;
+  case 1:
+    i0 = dy0, i1 = dy1, j0 = h - dx1, j1 = h - dx0;
+    break;
+  case 2:
+    i0 = w - dx1, i1 = w - dx0, j0 = h - dy1, j1 = h - dy0;
+    break;
+  default:
+    i0 = w - dy1, i1 = w - dy0, j0 = dx0, j1 = dx1;
+    break;
+  }
+  if (mirror) { // Back to stored columns
+    int16_t t = i0;
+    i0 = w - i1;
+    i1 = w - t;
+  }
+
+  // Where the first source pixel sent ends up on screen
+  int16_t m0 = mirror ? w - 1 - i0 : i0, sx, sy;
+  switch (rot) {
+  case 0:
+    sx = m0, sy = j0;
+    break;
+  case 1:
+    sx = h - 1 - j0, sy = m0;
+    break;
+  case 2:
+    sx = w - 1 - m0, sy = h - 1 - j0;
+    break;
+  default:
+    sx = j0, sy = w - 1 - m0;
+    break;
+  }
+
+  // Orientation in which the stored rows run the way they should appear:
+  // the combined rotation, with the column order reversed to mirror
+  uint8_t m = rotationMadctl[(rotation + rot) & 3];
+  if (mirror)
+    m ^= MADCTL_MX;
+  int16_t px, py, wx, wy;
+  madctlToPanel(rotationMadctl[rotation], x + sx, y + sy, px, py);
+  panelToMadctl(m, px, py, wx, wy);
+
+  uint16_t sw = i1 - i0;
+  bitmap += (int32_t)j0 * w + i0;
+  startWrite();
+  writeMadctl(m);
+  setAddrWindow(wx, wy, sw, j1 - j0);
+  for (int16_t j = j0; j < j1; j++) {
+    writePixels(bitmap, sw);
+    bitmap += w;
+  }
+  writeMadctl(rotationMadctl[rotation]);
+  endWrite();
+}
+
+/**************************************************************************/
+/*!
+    @brief  Redraw a band of columns from a list of vertical runs, as for
+            an oscilloscope or waterfall trace. Each column named in spans
+            is rewritten from top to top + height - 1: the runs in their
+            colours (later runs win where they overlap) and bg elsewhere.
+            Consecutive entries for the same or the next column are sent
+            as one window; when any such neighbours exist MADCTL is
+            switched to a transposed scan for the call so that a window
+            fills column by column. Sort the runs by x to get the fewest
+            windows. To move a trace without rewriting whole columns use
+            updateVSpans().
+    @param  spans   Runs, ideally sorted by x. Runs sharing a column must
+                    be next to each other in the array.
+    @param  count   Number of runs.
+    @param  top     First row of the band.
+    @param  height  Rows in the band.
+    @param  bg      RGB565 colour for rows outside the runs.
+*/
+/**************************************************************************/
+void Adafruit_ILI9341::drawVSpans(const ILI9341_VSpan *spans, uint16_t count,
+                                  int16_t top, int16_t height, uint16_t bg) {
+  ILI9341_STATS_API(VLINE);
+  if (top < 0) {
+    height += top;
+    top = 0;
+  }
+  height = min(height, (int16_t)(_height - top));
+  if (!spans || !count || (height <= 0))
+    return;
+  bool transpose = false;
+  for (uint16_t i = 1; (i < count) && !transpose; i++)
+    transpose = (spans[i].x == spans[i - 1].x + 1);
+  // Screen x and y swapped: a quarter turn back, mirrored
+  const uint8_t m = rotationMadctl[(rotation + 3) & 3] ^ MADCTL_MX;
+
+  startWrite();
+  if (transpose)
+    writeMadctl(m);
+  uint16_t i = 0;
+  while (i < count) {
+    uint16_t end = i + 1; // Extend over the same or the next column
+    while ((end < count) &&
+           ((spans[end].x == spans[end - 1].x) ||
+            (transpose && (spans[end].x == spans[end - 1].x + 1))))
+      end++;
+    while ((i < end) && (spans[i].x < 0)) // Clip
+      i++;
+    uint16_t last = i;
+    while ((last < end) && (spans[last].x < _width))
+      last++;
+    if (last > i) {
+      int16_t x0 = spans[i].x, columns = spans[last - 1].x - x0 + 1;
+      if (transpose) {
+        int16_t px, py, wx, wy;
+        madctlToPanel(rotationMadctl[rotation], x0, top, px, py);
+        panelToMadctl(m, px, py, wx, wy);
+        setAddrWindow(wx, wy, height, columns);
+      } else {
+        setAddrWindow(x0, top, 1, height);
+      }
+      for (uint16_t a = i, b; a < last; a = b) {
+        for (b = a + 1; (b < last) && (spans[b].x == spans[a].x); b++)
+          ;
+        writeVSpanColumn(&spans[a], b - a, top, height, bg);
+      }
+    }
+    i = end;
+  }
+  if (transpose)
+    writeMadctl(rotationMadctl[rotation]);
+  endWrite();
+}
+
+/**************************************************************************/
+/*!
+    @brief  Move a trace drawn with vertical runs from its previous frame
+            to a new one, sending only the rows that change. In each
+            column, rows covered by a new run are written in its colour
+            (later runs win), rows only the previous runs covered are set
+            to bg, and rows that keep the same colour or that neither list
+            covers are left alone. Each stretch of changed rows is sent
+            through its own one-column window, so the cost follows the
+            size of the change rather than the height of the trace.
+    @param  spans          Runs of the new frame.
+    @param  count          Number of new runs.
+    @param  previous       Runs last drawn, or NULL for none.
+    @param  previousCount  Number of previous runs.
+    @param  bg             RGB565 colour for rows left uncovered.
+    @note   Both lists must be sorted by x.
+*/
+/**************************************************************************/
+void Adafruit_ILI9341::updateVSpans(const ILI9341_VSpan *spans,
+                                    uint16_t count,
+                                    const ILI9341_VSpan *previous,
+                                    uint16_t previousCount, uint16_t bg) {
+  ILI9341_STATS_API(VLINE);
+  if (!spans)
+    count = 0;
+  if (!previous)
+    previousCount = 0;
+  startWrite();
+  uint16_t i = 0, j = 0;
+  while ((i < count) || (j < previousCount)) {
+    int16_t x = ((j == previousCount) ||
+                 ((i < count) && (spans[i].x <= previous[j].x)))
+                    ? spans[i].x
+                    : previous[j].x;
+    uint16_t a = i, b = j;
+    while ((i < count) && (spans[i].x == x))
+      i++;
+    while ((j < previousCount) && (previous[j].x == x))
+      j++;
+    if ((x >= 0) && (x < _width))
+      writeVSpanChanges(x, &spans[a], i - a, &previous[b], j - b, bg);
+  }
+  endWrite();
+}
+
+// Colour of the last run covering row y, if any, and lower next to the
+// row after y where that may change.
+static bool vspanAt(const ILI9341_VSpan *spans, uint16_t count, int16_t y,
+                    uint16_t &color, int16_t &next) {
+  bool covered = false;
+  for (uint16_t k = 0; k < count; k++) {
+    int16_t lo = min(spans[k].y0, spans[k].y1);
+    int16_t hi = max(spans[k].y0, spans[k].y1) + 1;
+    if (lo > y) {
+      next = min(next, lo);
+    } else if (hi > y) {
+      color = spans[k].color;
+      covered = true;
+      next = min(next, hi);
+    }
+  }
+  return covered;
+}
+
+// Send one column of drawVSpans() to the open window, as runs of colour.
+void Adafruit_ILI9341::writeVSpanColumn(const ILI9341_VSpan *spans,
+                                        uint16_t count, int16_t top,
+                                        int16_t height, uint16_t bg) {
+  const int16_t bottom = top + height;
+  for (int16_t y = top; y < bottom;) {
+    uint16_t color = bg;
+    int16_t next = bottom; // Where the colour may change
+    vspanAt(spans, count, y, color, next);
+    writeColor(color, next - y);
+    y = next;
+  }
+}
+
+// Send the rows of one updateVSpans() column that change. A window is
+// opened at the start of each stretch of changed rows and left running to
+// the bottom of the column; the pixels sent decide how much of it is used.
+void Adafruit_ILI9341::writeVSpanChanges(int16_t x, const ILI9341_VSpan *spans,
+                                         uint16_t count,
+                                         const ILI9341_VSpan *previous,
+                                         uint16_t previousCount,
+                                         uint16_t bg) {
+  int16_t y = _height, bottom = 0; // Rows either list touches
+  for (uint16_t k = 0; k < count + previousCount; k++) {
+    const ILI9341_VSpan &s = (k < count) ? spans[k] : previous[k - count];
+    y = min(y, min(s.y0, s.y1));
+    bottom = max(bottom, (int16_t)(max(s.y0, s.y1) + 1));
+  }
+  y = max(y, (int16_t)0);
+  bottom = min(bottom, _height);
+  bool open = false;
+  while (y < bottom) {
+    uint16_t color = bg, was = bg;
+    int16_t next = bottom;
+    bool is = vspanAt(spans, count, y, color, next);
+    bool had = vspanAt(previous, previousCount, y, was, next);
+    if ((is || had) && !(had && (was == color))) {
+      if (!open)
+        setAddrWindow(x, y, 1, bottom - y);
+      open = true;
+      writeColor(color, next - y);
+    } else {
+      open = false;
+    }
+    y = next;
+  }
+}
+
+// Send MADCTL inside an open transaction and record it in the shadow.
+void Adafruit_ILI9341::writeMadctl(uint8_t m) {
+  writeCommand(ILI9341_MADCTL);
+  spiWrite(m);
+  ILI9341_STATS_ADD(dataBytes, 1);
+  _madctl = m;
+  _stateValid |= ILI9341_STATE_MADCTL;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Send RGB888 pixels (3 bytes each, R first) to the current
+            address window. Full precision in 18-bit mode; converted to
+            RGB565 in 16-bit mode.
+    @param  rgb  Packed RGB888 pixels (RAM).
+    @param  len  Number of pixels.
+*/
+/**************************************************************************/
+void Adafruit_ILI9341::writePixels888(const uint8_t *rgb, uint32_t len) {
+  ILI9341_STATS_API(STREAM);
+  if (_pixfmt == ILI9341_PIXFMT_18BIT) {
+    writeBytes666(rgb, len * 3); // Low two bits of each byte are ignored
+    return;
+  }
+  ILI9341_STATS_ADD(pixelBytes, len * 2);
+  for (; len--; rgb += 3)
+    SPI_WRITE16(color565(rgb[0], rgb[1], rgb[2]));
+}
+
+/**************************************************************************/
+/*!
+    @brief  Send the same RGB888 colour repeatedly to the address window.
+    @param  rgb  Colour as 0xRRGGBB.
+    @param  len  Number of pixels.
+*/
+/**************************************************************************/
+void Adafruit_ILI9341::writeColor888(uint32_t rgb, uint32_t len) {
+  ILI9341_STATS_API(STREAM);
+  uint8_t r = rgb >> 16, g = rgb >> 8, b = rgb;
+  if (_pixfmt != ILI9341_PIXFMT_18BIT) {
+    ILI9341_STATS_ADD(pixelBytes, len * 2);
+    Adafruit_SPITFT::writeColor(color565(r, g, b), len);
+    return;
+  }
+  ILI9341_STATS_ADD(pixelBytes, len * 3);
+  // Four pixels are exactly three 32-bit words: RGBR GBRG BRGB
+  uint32_t w0 = ((uint32_t)r << 24) | ((uint32_t)g << 16) | (b << 8) | r,
+           w1 = ((uint32_t)g << 24) | ((uint32_t)b << 16) | (r << 8) | g,
+           w2 = ((uint32_t)b << 24) | ((uint32_t)r << 16) | (g << 8) | b;
+  for (; len >= 4; len -= 4) {
+    SPI_WRITE32(w0);
+    SPI_WRITE32(w1);
+    SPI_WRITE32(w2);
+  }
+  while (len--) {
+    spiWrite(r);
+    spiWrite(g);
+    spiWrite(b);
+  }
+}
+
+/**************************************************************************/
+/*!
+    @brief  Fill a rectangle with an RGB888 colour (own transaction).
+    @param  x    Left edge.
+    @param  y    Top edge.
+    @param  w    Width in pixels.
+    @param  h    Height in pixels.
+    @param  rgb  Colour as 0xRRGGBB.
+*/
+/**************************************************************************/
+void Adafruit_ILI9341::fillRect888(int16_t x, int16_t y, int16_t w, int16_t h,
+                                   uint32_t rgb) {
+  ILI9341_STATS_API(RGB888);
+  if (!clipRect(x, y, w, h))
+    return;
+  startWrite();
+  setAddrWindow(x, y, w, h);
+  writeColor888(rgb, (uint32_t)w * h);
+  endWrite();
+}
+
+/**************************************************************************/
+/*!
+    @brief  Draw an RGB888 bitmap from RAM, clipped to the screen.
+    @param  x    Left edge.
+    @param  y    Top edge.
+    @param  rgb  w * h packed RGB888 pixels (R first), row-major.
+    @param  w    Bitmap width.
+    @param  h    Bitmap height.
+*/
+/**************************************************************************/
+void Adafruit_ILI9341::drawRGB888Bitmap(int16_t x, int16_t y,
+                                        const uint8_t *rgb, int16_t w,
+                                        int16_t h) {
+  ILI9341_STATS_API(RGB888);
+  int16_t cx = x, cy = y, cw = w, ch = h;
+  if ((w <= 0) || (h <= 0) || !clipRect(cx, cy, cw, ch))
+    return;
+  rgb += ((int32_t)(cy - y) * w + (cx - x)) * 3;
+  startWrite();
+  setAddrWindow(cx, cy, cw, ch);
+  while (ch--) {
+    writePixels888(rgb, cw);
+    rgb += (int32_t)w * 3;
+  }
+  endWrite();
+}
+
+/**************************************************************************/
+/*!
+    @brief  Read the size of a compressed image.
+    @param  image  Compressed image in PROGMEM.
+    @param  w      Receives the image width.
+    @param  h      Receives the image height.
+    @return false if the data does not start with the 'RL' signature.
+*/
+/**************************************************************************/
+bool Adafruit_ILI9341::compressedBitmapSize(const uint8_t image[], int16_t &w,
+                                            int16_t &h) {
+  if ((pgm_read_byte(&image[0]) != 'R') || (pgm_read_byte(&image[1]) != 'L'))
+    return false;
+  w = ((uint16_t)pgm_read_byte(&image[2]) << 8) | pgm_read_byte(&image[3]);
+  h = ((uint16_t)pgm_read_byte(&image[4]) << 8) | pgm_read_byte(&image[5]);
+  return true;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Draw a palette + run-length compressed image, decoding it
+            straight into the address window with no image-sized buffer.
+            Runs are sent as single colour bursts and literal pixels in
+            batches of ILI9341_RLE_CHUNK. The layout, as written by
+            extras/rle_encode, is:
+              'R' 'L', width (2 bytes), height (2 bytes), big-endian;
+              colour count n (1 byte, 0 meaning 256);
+              n RGB565 palette entries (2 bytes each, big-endian);
+              packets in row-major order, which may span rows: a byte
+              0x80 | (k - 1) followed by one palette index is a run of k
+              pixels, a byte k - 1 (below 0x80) is followed by k indexes.
+    @param  x      Top left corner x coordinate.
+    @param  y      Top left corner y coordinate.
+    @param  image  Compressed image in PROGMEM.
+*/
+/**************************************************************************/
+void Adafruit_ILI9341::drawCompressedBitmap(int16_t x, int16_t y,
+                                            const uint8_t image[]) {
+  ILI9341_STATS_API(COMPRESSED);
+  int16_t w, h;
+  if (!compressedBitmapSize(image, w, h) || (w <= 0) || (h <= 0))
+    return;
+  uint16_t ncolors = pgm_read_byte(&image[6]);
+  if (!ncolors)
+    ncolors = 256;
+  const uint8_t *palette = &image[7];
+  const uint8_t *p = palette + ncolors * 2;
+
+  int16_t cx = x, cy = y, cw = w, ch = h;
+  if (!clipRect(cx, cy, cw, ch))
+    return;
+  const int16_t col0 = cx - x, col1 = col0 + cw; // Visible image columns
+  const int16_t row0 = cy - y, row1 = row0 + ch; // and rows
+  uint16_t buf[ILI9341_RLE_CHUNK];
+  uint8_t n = 0; // Literal pixels waiting in buf
+  int16_t col = 0, row = 0;
+
+  startWrite();
+  setAddrWindow(cx, cy, cw, ch);
+  while (row < row1) {
+    uint8_t code = pgm_read_byte(p++);
+    uint8_t count = (code & 0x7F) + 1;
+    if (code & 0x80) {
+      const uint8_t *c = &palette[pgm_read_byte(p++) * 2];
+      uint16_t color = ((uint16_t)pgm_read_byte(c) << 8) | pgm_read_byte(c + 1);
+      while (count && (row < row1)) {
+        uint8_t k = min((int16_t)count, (int16_t)(w - col));
+        if (row >= row0) {
+          int16_t a = max(col, col0), e = min((int16_t)(col + k), col1);
+          if (e > a) {
+            if (n) {
+              writePixels(buf, n);
+              n = 0;
+            }
+            writeColor(color, e - a);
+          }
+        }
+        count -= k;
+        if ((col += k) == w) {
+          col = 0;
+          row++;
+        }
+      }
+    } else {
+      while (count-- && (row < row1)) {
+        uint8_t i = pgm_read_byte(p++);
+        if ((row >= row0) && (col >= col0) && (col < col1)) {
+          const uint8_t *c = &palette[i * 2];
+          buf[n++] = ((uint16_t)pgm_read_byte(c) << 8) | pgm_read_byte(c + 1);
+          if (n == ILI9341_RLE_CHUNK) {
+            writePixels(buf, n);
+            n = 0;
+          }
+        }
+        if (++col == w) {
+          col = 0;
+          row++;
+        }
+      }
+    }
+  }
+  if (n)
+    writePixels(buf, n);
+  endWrite();
+}
+
+// Unpack count pixels starting at pixel 'from' of a packed row and look
+// them up in the palette. Whole bytes are expanded with unrolled shifts;
+// only a partial first or last byte goes pixel by pixel. With MASKED set,
+// pixels equal to 'transparent' leave dst untouched.
+template <bool MASKED>
+static void expandRow(uint16_t *dst, const uint8_t *row, uint8_t bpp,
+                      int16_t from, uint16_t count, const uint16_t *palette,
+                      uint8_t transparent) {
+#define PUT(k, i)                                                              \
+  do {                                                                         \
+    uint8_t idx = (i);                                                         \
+    if (!MASKED || (idx != transparent))                                       \
+      dst[k] = palette[idx];                                                   \
+  } while (0)
+  if ((bpp != 1) && (bpp != 2) && (bpp != 4) && (bpp != 8))
+    return;
+  const uint8_t perByte = 8 / bpp, mask = (1 << bpp) - 1;
+  const uint8_t *s = row + ((uint32_t)from * bpp >> 3);
+  uint8_t sub = from & (perByte - 1);
+  if (sub) {
+    uint8_t b = pgm_read_byte(s++);
+    for (; (sub < perByte) && count; sub++, count--, dst++)
+      PUT(0, (b >> (8 - bpp * (sub + 1))) & mask);
+  }
+  uint8_t b;
+  switch (bpp) {
+  case 1:
+    for (; count >= 8; count -= 8, dst += 8) {
+      b = pgm_read_byte(s++);
+      PUT(0, b >> 7);
+      PUT(1, (b >> 6) & 1);
+      PUT(2, (b >> 5) & 1);
+      PUT(3, (b >> 4) & 1);
+      PUT(4, (b >> 3) & 1);
+      PUT(5, (b >> 2) & 1);
+      PUT(6, (b >> 1) & 1);
+      PUT(7, b & 1);
+    }
+    break;
+  case 2:
+    for (; count >= 4; count -= 4, dst += 4) {
+      b = pgm_read_byte(s++);
+      PUT(0, b >> 6);
+      PUT(1, (b >> 4) & 3);
+      PUT(2, (b >> 2) & 3);
+      PUT(3, b & 3);
+    }
+    break;
+  case 4:
+    for (; count >= 2; count -= 2, dst += 2) {
+      b = pgm_read_byte(s++);
+      PUT(0, b >> 4);
+      PUT(1, b & 15);
+    }
+    break;
+  default:
+    for (; count >= 4; count -= 4, dst += 4, s += 4) {
+      PUT(0, pgm_read_byte(s));
+      PUT(1, pgm_read_byte(s + 1));
+      PUT(2, pgm_read_byte(s + 2));
+      PUT(3, pgm_read_byte(s + 3));
+    }
+    for (; count; count--, dst++)
+      PUT(0, pgm_read_byte(s++));
+    return;
+  }
+  if (count) { // Fewer than perByte pixels left
+    b = pgm_read_byte(s);
+    for (sub = 0; count; sub++, count--, dst++)
+      PUT(0, (b >> (8 - bpp * (sub + 1))) & mask);
+  }
+#undef PUT
+}
+
+/**************************************************************************/
+/*!
+    @brief  Expand part of a packed bitmap row to RGB565, for building line
+            buffers (sprites, custom compositing).
+    @param  dst      Receives count pixels.
+    @param  row      Start of the packed row (PROGMEM on AVR).
+    @param  bpp      Bits per pixel: 1, 2, 4 or 8.
+    @param  from     First pixel of the row to expand.
+    @param  count    Number of pixels.
+    @param  palette  RGB565 colour for each index.
+*/
+/**************************************************************************/
+void Adafruit_ILI9341::expandIndexed(uint16_t *dst, const uint8_t *row,
+                                     uint8_t bpp, int16_t from, uint16_t count,
+                                     const uint16_t *palette) {
+  expandRow<false>(dst, row, bpp, from, count, palette, 0);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Expand part of a packed bitmap row over existing pixels,
+            leaving those under the transparent index unchanged.
+    @param  dst          Line buffer to draw over (count pixels).
+    @param  row          Start of the packed row (PROGMEM on AVR).
+    @param  bpp          Bits per pixel: 1, 2, 4 or 8.
+    @param  from         First pixel of the row to expand.
+    @param  count        Number of pixels.
+    @param  palette      RGB565 colour for each index.
+    @param  transparent  Index that is not drawn.
+*/
+/**************************************************************************/
+void Adafruit_ILI9341::expandIndexed(uint16_t *dst, const uint8_t *row,
+                                     uint8_t bpp, int16_t from, uint16_t count,
+                                     const uint16_t *palette,
+                                     uint8_t transparent) {
+  expandRow<true>(dst, row, bpp, from, count, palette, transparent);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Draw a packed 1, 2, 4 or 8 bpp bitmap through a palette. Rows
+            start on a byte boundary, leftmost pixel in the high bits.
+            Opaque bitmaps go out as one address window, expanded in
+            ILI9341_BLIT_CHUNK pixel pieces into two alternating buffers so
+            that expansion overlaps DMA where available. With a transparent
+            index, each opaque run of a row gets its own window.
+    @param  x            Top left corner x coordinate.
+    @param  y            Top left corner y coordinate.
+    @param  bitmap       Packed pixels (PROGMEM on AVR).
+    @param  bpp          Bits per pixel: 1, 2, 4 or 8.
+    @param  w            Width in pixels.
+    @param  h            Height in pixels.
+    @param  palette      RGB565 colour for each index, in RAM.
+    @param  transparent  Index that is not drawn, or -1 for none.
+*/
+/**************************************************************************/
+void Adafruit_ILI9341::drawIndexedBitmap(int16_t x, int16_t y,
+                                         const uint8_t bitmap[], uint8_t bpp,
+                                         int16_t w, int16_t h,
+                                         const uint16_t *palette,
+                                         int16_t transparent) {
+  ILI9341_STATS_API(INDEXED);
+  int16_t cx = x, cy = y, cw = w, ch = h;
+  if ((w <= 0) || (h <= 0) || !clipRect(cx, cy, cw, ch))
+    return;
+  const uint16_t stride = indexedStride(w, bpp);
+  const uint8_t mask = (1 << bpp) - 1;
+  const uint8_t *row = bitmap + (uint32_t)(cy - y) * stride;
+  uint16_t buf[2][ILI9341_BLIT_CHUNK];
+  uint8_t b = 0;
+
+  startWrite();
+  if (transparent < 0)
+    setAddrWindow(cx, cy, cw, ch);
+  for (int16_t j = 0; j < ch; j++, row += stride) {
+    int16_t i = cx - x, end = i + cw;
+    while (i < end) {
+      if (transparent >= 0) { // Skip to the next opaque run
+        for (; i < end; i++) {
+          uint32_t bit = (uint32_t)i * bpp;
+          uint8_t v = pgm_read_byte(&row[bit >> 3]) >> (8 - bpp - (bit & 7));
+          if ((v & mask) != transparent)
+            break;
+        }
+        int16_t runEnd = i;
+        for (; runEnd < end; runEnd++) {
+          uint32_t bit = (uint32_t)runEnd * bpp;
+          uint8_t v = pgm_read_byte(&row[bit >> 3]) >> (8 - bpp - (bit & 7));
+          if ((v & mask) == transparent)
+            break;
+        }
+        if (runEnd == i)
+          break;
+        dmaWait();
+        setAddrWindow(x + i, cy + j, runEnd - i, 1);
+        end = runEnd; // Send this run, then look for the next
+      }
+      while (i < end) {
+        uint16_t n = min(end - i, ILI9341_BLIT_CHUNK);
+        expandIndexed(buf[b], row, bpp, i, n, palette);
+        dmaWait();
+        writePixels(buf[b], n, false);
+        b ^= 1;
+        i += n;
+      }
+      end = cx - x + cw;
+    }
+  }
+  dmaWait();
+  endWrite();
+}
+
+/**************************************************************************/
+/*!
+    @brief  Composite two indexed layers over a background colour and send
+            the result as one address window, without a frame buffer. Each
+            line is built in ILI9341_BLIT_CHUNK pixel pieces: background,
+            then the bottom layer, then the top layer, each layer's
+            transparent index letting what is below show through.
+    @param  x       Left edge of the area to update.
+    @param  y       Top edge of the area to update.
+    @param  w       Width of the area.
+    @param  h       Height of the area.
+    @param  bottom  Lower layer.
+    @param  top     Upper layer.
+    @param  bg      Colour where neither layer is drawn.
+*/
+/**************************************************************************/
+void Adafruit_ILI9341::drawIndexedLayers(int16_t x, int16_t y, int16_t w,
+                                         int16_t h,
+                                         const ILI9341_IndexedLayer &bottom,
+                                         const ILI9341_IndexedLayer &top,
+                                         uint16_t bg) {
+  ILI9341_STATS_API(INDEXED);
+  if (!clipRect(x, y, w, h))
+    return;
+  const ILI9341_IndexedLayer *layers[2] = {&bottom, &top};
+  uint16_t buf[2][ILI9341_BLIT_CHUNK];
+  uint8_t b = 0;
+
+  startWrite();
+  setAddrWindow(x, y, w, h);
+  for (int16_t row = y; row < y + h; row++) {
+    for (int16_t x0 = x; x0 < x + w; x0 += ILI9341_BLIT_CHUNK) {
+      int16_t x1 = min(x0 + ILI9341_BLIT_CHUNK, x + w);
+      uint16_t *line = buf[b];
+      for (int16_t i = 0; i < x1 - x0; i++)
+        line[i] = bg;
+      for (uint8_t l = 0; l < 2; l++) {
+        const ILI9341_IndexedLayer &L = *layers[l];
+        if (!L.bitmap || (row < L.y) || (row >= L.y + L.h))
+          continue;
+        int16_t a = max(x0, L.x), e = min(x1, (int16_t)(L.x + L.w));
+        if (e <= a)
+          continue;
+        const uint8_t *src =
+            L.bitmap + (uint32_t)(row - L.y) * indexedStride(L.w, L.bpp);
+        if (L.transparent < 0)
+          expandIndexed(&line[a - x0], src, L.bpp, a - L.x, e - a, L.palette);
+        else
+          expandIndexed(&line[a - x0], src, L.bpp, a - L.x, e - a, L.palette,
+                        L.transparent);
+      }
+      dmaWait();
+      writePixels(line, x1 - x0, false);
+      b ^= 1;
+    }
+  }
+  dmaWait();
+  endWrite();
+}
+
+#if ILI9341_ENABLE_STATS
+
+// Pixel bytes a 16-bit rectangle fill would send after clipping
+uint32_t Adafruit_ILI9341::rectBytes(int16_t x, int16_t y, int16_t w,
+                                     int16_t h) const {
+  return clipRect(x, y, w, h) ? (uint32_t)w * h * 2 : 0;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Start a transaction, counting it.
+*/
+/**************************************************************************/
+void Adafruit_ILI9341::startWrite(void) {
+  ILI9341_STATS_ADD(transactions, 1);
+  Adafruit_SPITFT::startWrite();
+}
+
+/**************************************************************************/
+/*!
+    @brief  Send a command and its parameters in their own transaction,
+            counting them.
+    @param  commandByte   Command.
+    @param  dataBytes     Parameters.
+    @param  numDataBytes  Number of parameters.
+*/
+/**************************************************************************/
+void Adafruit_ILI9341::sendCommand(uint8_t commandByte, uint8_t *dataBytes,
+                                   uint8_t numDataBytes) {
+  sendCommand(commandByte, (const uint8_t *)dataBytes, numDataBytes);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Send a command and its parameters (PROGMEM on AVR) in their
+            own transaction, counting them.
+    @param  commandByte   Command.
+    @param  dataBytes     Parameters.
+    @param  numDataBytes  Number of parameters.
+*/
+/**************************************************************************/
+void Adafruit_ILI9341::sendCommand(uint8_t commandByte,
+                                   const uint8_t *dataBytes,
+                                   uint8_t numDataBytes) {
+  ILI9341_STATS_ADD(transactions, 1);
+  ILI9341_STATS_ADD(commands, 1);
+  ILI9341_STATS_ADD(dataBytes, numDataBytes);
+  Adafruit_SPITFT::sendCommand(commandByte, dataBytes, numDataBytes);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Send a command byte inside an open transaction, counting it.
+    @param  cmd  Command.
+*/
+/**************************************************************************/
+void Adafruit_ILI9341::writeCommand(uint8_t cmd) {
+  ILI9341_STATS_ADD(commands, 1);
+  Adafruit_SPITFT::writeCommand(cmd);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Read a byte inside an open transaction, counting it.
+    @return Byte read.
+*/
+/**************************************************************************/
+uint8_t Adafruit_ILI9341::spiRead(void) {
+  ILI9341_STATS_ADD(readBytes, 1);
+  return Adafruit_SPITFT::spiRead();
+}
+
+/**************************************************************************/
+/*!
+    @brief  Wait for a DMA transfer to finish, timing the wait.
+*/
+/**************************************************************************/
+void Adafruit_ILI9341::dmaWait(void) {
+  uint32_t t = micros();
+  Adafruit_SPITFT::dmaWait();
+  ILI9341_STATS_ADD(dmaWaitMicros, micros() - t);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Copy the bus statistics gathered since the last resetStats().
+    @param  snapshot  Receives the per-group counters and their total.
+*/
+/**************************************************************************/
+void Adafruit_ILI9341::getStats(ILI9341_Stats &snapshot) const {
+  memcpy(snapshot.api, _stats, sizeof _stats);
+  memset(&snapshot.total, 0, sizeof snapshot.total);
+  uint32_t *sum = (uint32_t *)&snapshot.total;
+  for (uint8_t a = 0; a < ILI9341_API_COUNT; a++) {
+    const uint32_t *c = (const uint32_t *)&_stats[a];
+    for (uint8_t i = 0; i < sizeof(ILI9341_BusStats) / sizeof(uint32_t); i++)
+      sum[i] += c[i];
+  }
+}
+
+/**************************************************************************/
+/*!
+    @brief  Zero all bus statistics.
+*/
+/**************************************************************************/
+void Adafruit_ILI9341::resetStats(void) { memset(_stats, 0, sizeof _stats); }
+
+/**************************************************************************/
+/*!
+    @brief  Short name of a statistics group, for printing reports.
+    @param  api  ILI9341_API_* value.
+    @return Name, or "?" if out of range.
+*/
+/**************************************************************************/
+const char *Adafruit_ILI9341::statsApiName(uint8_t api) {
+  static const char *const names[ILI9341_API_COUNT] = {
+      "other",  "control", "pixel",  "fillRect",   "hLine",   "vLine",
+      "bitmap", "stream",  "rgb888", "compressed", "indexed", "read"};
+  return (api < ILI9341_API_COUNT) ? names[api] : "?";
+}
+
+#endif // ILI9341_ENABLE_STATS
@@ -44,6 +44,9 @@
 
 #define ILI9341_TFTWIDTH 240  ///< ILI9341 max TFT width
 #define ILI9341_TFTHEIGHT 320 ///< ILI9341 max TFT height
+#define ILI9341_OSC_HZ 615000 ///< Internal oscillator (datasheet typical)
+#define ILI9341_FRAME_LINES                                                    \
+  (ILI9341_TFTHEIGHT + 4) ///< Gate lines + default front/back porch per frame
 
 #define ILI9341_NOP 0x00     ///< No-op register
 #define ILI9341_SWRESET 0x01 ///< Software reset register
@@ -74,9 +77,14 @@
 
 #define ILI9341_PTLAR 0x30    ///< Partial Area
 #define ILI9341_VSCRDEF 0x33  ///< Vertical Scrolling Definition
+#define ILI9341_TEOFF 0x34    ///< Tearing Effect Line OFF
+#define ILI9341_TEON 0x35     ///< Tearing Effect Line ON
 #define ILI9341_MADCTL 0x36   ///< Memory Access Control
 #define ILI9341_VSCRSADD 0x37 ///< Vertical Scrolling Start Address
+#define ILI9341_IDMOFF 0x38   ///< Idle Mode OFF
+#define ILI9341_IDMON 0x39    ///< Idle Mode ON
 #define ILI9341_PIXFMT 0x3A   ///< COLMOD: Pixel Format Set
+#define ILI9341_RAMWRC 0x3C   ///< Memory Write Continue
 
 #define ILI9341_FRMCTR1                                                        \
   0xB1 ///< Frame Rate Control (In Normal Mode/Full Colors)
@@ -124,7 +132,110 @@
 #define ILI9341_GREENYELLOW 0xAFE5 ///< 173, 255,  41
 #define ILI9341_PINK 0xFC18        ///< 255, 130, 198
 
+// Argument values
+#define ILI9341_PIXFMT_16BIT 0x55 ///< PIXFMT value for RGB565, 2 bytes/pixel
+#define ILI9341_PIXFMT_18BIT 0x66 ///< PIXFMT value for RGB666, 3 bytes/pixel
+#define ILI9341_DUMP_PPM 0        ///< dumpScreen(): binary PPM (P6)
+#define ILI9341_DUMP_RLE565 1     ///< dumpScreen(): run-length RGB565
+
+// Buffer sizes
+#define ILI9341_RLE_CHUNK 32  ///< Literal pixels buffered per writePixels()
+#define ILI9341_BLIT_CHUNK 32 ///< Pixels per buffer in indexed blits
+
+// Build options: define any of these before including this header
+#ifndef ILI9341_RESET_DELAY
+#define ILI9341_RESET_DELAY 5 ///< ms from reset until commands are accepted
+#endif
+#ifndef ILI9341_RESET_SLPOUT_DELAY
+#define ILI9341_RESET_SLPOUT_DELAY 120 ///< ms from reset until SLPOUT
+#endif
+#ifndef ILI9341_SLPOUT_DELAY
+#define ILI9341_SLPOUT_DELAY 120 ///< ms from SLPOUT until DISPON
+#endif
+
+#ifndef ILI9341_READ_FREQ
+#define ILI9341_READ_FREQ 6000000 ///< Default SPI clock for GRAM reads
+#endif
+
+#ifndef ILI9341_ENABLE_STATS
+#define ILI9341_ENABLE_STATS 0 ///< 1 to count bus traffic (see getStats())
+#endif
+
+#ifndef ILI9341_PIXFMT_DEFAULT
+#define ILI9341_PIXFMT_DEFAULT                                                 \
+  ILI9341_PIXFMT_16BIT ///< Pixel format programmed by begin()
+#endif
+
 /**************************************************************************/
+/*!
+  @brief  A packed 1, 2, 4 or 8 bits-per-pixel bitmap placed on the screen,
+          for Adafruit_ILI9341::drawIndexedLayers(). Rows start on a byte
+          boundary and the leftmost pixel is in the most significant bits.
+*/
+typedef struct {
+  const uint8_t *bitmap;   ///< Packed pixels (PROGMEM on AVR)
+  const uint16_t *palette; ///< RGB565 colour for each index, in RAM
+  int16_t x;               ///< Screen position of the left edge
+  int16_t y;               ///< Screen position of the top edge
+  int16_t w;               ///< Width in pixels
+  int16_t h;               ///< Height in pixels
+  uint8_t bpp;             ///< Bits per pixel: 1, 2, 4 or 8
+  int16_t transparent;     ///< Index that is not drawn, or -1 for none
+} ILI9341_IndexedLayer;
+
+/*!
+  @brief  A vertical run of one colour in a column, for
+          Adafruit_ILI9341::drawVSpans() and updateVSpans().
+*/
+typedef struct {
+  int16_t x;      ///< Column
+  int16_t y0;     ///< First row of the run
+  int16_t y1;     ///< Last row of the run (inclusive)
+  uint16_t color; ///< RGB565 colour
+} ILI9341_VSpan;
+
+/// Groups of driver calls that bus statistics are broken down by
+enum {
+  ILI9341_API_OTHER = 0,  ///< Outside any driver call, e.g. sendCommand()
+  ILI9341_API_CONTROL,    ///< begin, rotation, scrolling and mode setters
+  ILI9341_API_PIXEL,      ///< drawPixel, writePixel(x, y, color)
+  ILI9341_API_FILLRECT,   ///< fillRect, writeFillRect (and fillScreen)
+  ILI9341_API_HLINE,      ///< drawFastHLine, writeFastHLine
+  ILI9341_API_VLINE,      ///< drawFastVLine, writeFastVLine
+  ILI9341_API_BITMAP,     ///< drawRGBBitmap from RAM
+  ILI9341_API_STREAM,     ///< setAddrWindow, writePixels, writeColor, ...
+  ILI9341_API_RGB888,     ///< fillRect888, drawRGB888Bitmap
+  ILI9341_API_COMPRESSED, ///< drawCompressedBitmap
+  ILI9341_API_INDEXED,    ///< drawIndexedBitmap, drawIndexedLayers
+  ILI9341_API_READ,       ///< readPixels, dumpScreen, readcommand8
+  ILI9341_API_COUNT       ///< Number of groups
+};
+
+/*!
+  @brief  Bus traffic attributed to one group of driver calls. Work done
+          inside another driver call is charged to the outermost one, so
+          a fillScreen() counts as one FILLRECT call.
+*/
+typedef struct {
+  uint32_t calls;         ///< Top-level calls
+  uint32_t commands;      ///< Command bytes sent
+  uint32_t windows;       ///< Address windows set up
+  uint32_t windowsCached; ///< ...of which needed no CASET or PASET
+  uint32_t pixelBytes;    ///< Pixel data bytes written
+  uint32_t dataBytes;     ///< Other data (parameter) bytes written
+  uint32_t readBytes;     ///< Bytes read from the controller
+  uint32_t transactions;  ///< Transactions (chip selects) started
+  uint32_t dmaWaitMicros; ///< Time spent in dmaWait()
+} ILI9341_BusStats;
+
+/*!
+  @brief  Snapshot of all bus statistics (ILI9341_ENABLE_STATS builds).
+*/
+typedef struct {
+  ILI9341_BusStats total;                  ///< Sum over all groups
+  ILI9341_BusStats api[ILI9341_API_COUNT]; ///< Per ILI9341_API_* group
+} ILI9341_Stats;
+
 /*!
 @brief Class to manage hardware interface with ILI9341 chipset (also seems to
 work with ILI9340)
@@ -144,15 +255,213 @@ public:
                    int8_t cs = -1, int8_t rst = -1, int8_t rd = -1);
 
   void begin(uint32_t freq = 0);
+  void beginAsync(uint32_t freq = 0);
+  bool poll(void);
   void setRotation(uint8_t r);
   void invertDisplay(bool i);
+  void enableSleep(bool enable);
   void scrollTo(uint16_t y);
   void setScrollMargins(uint16_t top, uint16_t bottom);
+  void invalidateState(void);
+  void setPixelFormat(uint8_t fmt);
+  /*!
+    @brief  Pixel format the drawing functions are currently producing.
+    @return ILI9341_PIXFMT_16BIT or ILI9341_PIXFMT_18BIT.
+  */
+  uint8_t getPixelFormat(void) const { return _pixfmt; }
+  void setPartialArea(uint16_t start, uint16_t end);
+  void enablePartialMode(bool enable);
+  void enableIdleMode(bool enable);
+  uint8_t setFrameRate(uint8_t hz, uint8_t reg = ILI9341_FRMCTR1);
+  void setFrameRateControl(uint8_t reg, uint8_t diva, uint8_t rtna);
+  void normalMode(void);
+  void setTearingEffect(bool enable);
+  uint32_t framePeriodMicros(void) const;
 
   // Transaction API not used by GFX
   void setAddrWindow(uint16_t x, uint16_t y, uint16_t w, uint16_t h);
 
   uint8_t readcommand8(uint8_t reg, uint8_t index = 0);
+  void readPixels(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t *dst);
+  /*!
+    @brief  Set the SPI clock used by readPixels(). The ILI9341 read cycle
+            is much slower than its write cycle (150 ns vs. 66 ns).
+    @param  freq  Read clock in Hz.
+  */
+  void setReadSpeed(uint32_t freq) { _readFreq = freq; }
+  bool dumpScreen(Print &out, uint8_t format = ILI9341_DUMP_PPM);
+
+  // Pixel paths, overridden so they also work in 18-bit mode
+  void drawPixel(int16_t x, int16_t y, uint16_t color);
+  void writePixel(int16_t x, int16_t y, uint16_t color);
+  void writePixel(uint16_t color);
+  void writePixels(uint16_t *colors, uint32_t len, bool block = true,
+                   bool bigEndian = false);
+  void writeColor(uint16_t color, uint32_t len);
+  void writeFillRect(int16_t x, int16_t y, int16_t w, int16_t h,
+                     uint16_t color);
+  void writeFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color);
+  void writeFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color);
+  void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+  void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color);
+  void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color);
+  void pushColor(uint16_t color);
+  using Adafruit_SPITFT::drawRGBBitmap;
+  void drawRGBBitmap(int16_t x, int16_t y, uint16_t *pcolors, int16_t w,
+                     int16_t h);
+  void drawRGBBitmapRotated(int16_t x, int16_t y, uint16_t *bitmap, int16_t w,
+                            int16_t h, uint8_t rot, bool mirror = false);
+  void drawVSpans(const ILI9341_VSpan *spans, uint16_t count, int16_t top,
+                  int16_t height, uint16_t bg);
+  void updateVSpans(const ILI9341_VSpan *spans, uint16_t count,
+                    const ILI9341_VSpan *previous, uint16_t previousCount,
+                    uint16_t bg);
+
+  // RGB888 sources: full precision in 18-bit mode, reduced to 565 otherwise
+  void writePixels888(const uint8_t *rgb, uint32_t len);
+  void writeColor888(uint32_t rgb, uint32_t len);
+  void fillRect888(int16_t x, int16_t y, int16_t w, int16_t h, uint32_t rgb);
+  void drawRGB888Bitmap(int16_t x, int16_t y, const uint8_t *rgb, int16_t w,
+                        int16_t h);
+
+  // Palette + RLE compressed images (see extras/rle_encode)
+  void drawCompressedBitmap(int16_t x, int16_t y, const uint8_t image[]);
+  static bool compressedBitmapSize(const uint8_t image[], int16_t &w,
+                                   int16_t &h);
+
+  // Packed 1/2/4/8 bpp bitmaps with an RGB565 palette
+  void drawIndexedBitmap(int16_t x, int16_t y, const uint8_t bitmap[],
+                         uint8_t bpp, int16_t w, int16_t h,
+                         const uint16_t *palette, int16_t transparent = -1);
+  void drawIndexedLayers(int16_t x, int16_t y, int16_t w, int16_t h,
+                         const ILI9341_IndexedLayer &bottom,
+                         const ILI9341_IndexedLayer &top, uint16_t bg = 0);
+  static void expandIndexed(uint16_t *dst, const uint8_t *row, uint8_t bpp,
+                            int16_t from, uint16_t count,
+                            const uint16_t *palette);
+  static void expandIndexed(uint16_t *dst, const uint8_t *row, uint8_t bpp,
+                            int16_t from, uint16_t count,
+                            const uint16_t *palette, uint8_t transparent);
+  /*!
+    @brief  Bytes per row of a packed bitmap.
+    @param  w    Width in pixels.
+    @param  bpp  Bits per pixel.
+    @return Row stride in bytes.
+  */
+  static uint16_t indexedStride(int16_t w, uint8_t bpp) {
+    return ((uint32_t)w * bpp + 7) / 8;
+  }
+
+#if ILI9341_ENABLE_STATS
+  // Counting versions of the Adafruit_SPITFT bus primitives
+  void startWrite(void);
+  void sendCommand(uint8_t commandByte, uint8_t *dataBytes,
+                   uint8_t numDataBytes);
+  void sendCommand(uint8_t commandByte, const uint8_t *dataBytes = NULL,
+                   uint8_t numDataBytes = 0);
+  void writeCommand(uint8_t cmd);
+  uint8_t spiRead(void);
+  void dmaWait(void);
+
+  void getStats(ILI9341_Stats &snapshot) const;
+  void resetStats(void);
+  static const char *statsApiName(uint8_t api);
+#endif
+
+protected:
+  bool clipRect(int16_t &x, int16_t &y, int16_t &w, int16_t &h) const;
+
+private:
+#if ILI9341_ENABLE_STATS
+  /// Charges traffic to the outermost driver call in progress
+  class StatsScope {
+  public:
+    /*!
+      @brief  Enter a driver call.
+      @param  tft  Driver being called.
+      @param  api  ILI9341_API_* group of the call.
+    */
+    StatsScope(Adafruit_ILI9341 *tft, uint8_t api)
+        : _tft(tft), _outer(tft->_statsApi == ILI9341_API_OTHER) {
+      if (_outer) {
+        tft->_statsApi = api;
+        tft->_stats[api].calls++;
+      }
+    }
+    ~StatsScope(void) {
+      if (_outer)
+        _tft->_statsApi = ILI9341_API_OTHER;
+    }
+
+  private:
+    Adafruit_ILI9341 *_tft; ///< Driver being called
+    bool _outer;            ///< This is the outermost call
+  };
+
+  uint32_t rectBytes(int16_t x, int16_t y, int16_t w, int16_t h) const;
+#endif
+  void setWindow(uint16_t x1, uint16_t y1, uint16_t w, uint16_t h);
+  void writeMadctl(uint8_t m);
+  void writeVSpanColumn(const ILI9341_VSpan *spans, uint16_t count,
+                        int16_t top, int16_t height, uint16_t bg);
+  void writeVSpanChanges(int16_t x, const ILI9341_VSpan *spans,
+                         uint16_t count, const ILI9341_VSpan *previous,
+                         uint16_t previousCount, uint16_t bg);
+  void write666(uint16_t color);
+  void writeBytes666(const uint8_t *bytes, uint32_t len);
+
+  /// Bits in _stateValid: which shadow registers match the controller
+  enum {
+    ILI9341_STATE_MADCTL = 0x01,   ///< _madctl is known
+    ILI9341_STATE_PIXFMT = 0x02,   ///< _pixfmt is known
+    ILI9341_STATE_VSCRSADD = 0x04, ///< _scrollStart is known
+    ILI9341_STATE_VSCRDEF = 0x08,  ///< _scrollTop/_scrollBottom are known
+    ILI9341_STATE_INVERT = 0x10,   ///< _inverted is known
+    ILI9341_STATE_SLEEP = 0x20,    ///< _sleeping is known
+    ILI9341_STATE_PTLAR = 0x40,    ///< _partialStart/_partialEnd are known
+    ILI9341_STATE_PARTIAL = 0x80,  ///< _partialMode is known
+    ILI9341_STATE_IDLE = 0x100,    ///< _idleMode is known
+    ILI9341_STATE_FRMCTR1 = 0x200, ///< _frameRate[0] is known
+    ILI9341_STATE_FRMCTR2 = 0x400, ///< _frameRate[1] is known
+    ILI9341_STATE_FRMCTR3 = 0x800, ///< _frameRate[2] is known
+    ILI9341_STATE_TE = 0x1000      ///< _tearing is known
+  };
+
+  /// Steps of beginAsync()/poll()
+  enum {
+    ILI9341_INIT_NONE = 0, ///< beginAsync() not called yet
+    ILI9341_INIT_RESET,    ///< Waiting for the controller to leave reset
+    ILI9341_INIT_WAKE,     ///< Registers set, waiting to send SLPOUT
+    ILI9341_INIT_SLPOUT,   ///< Waiting for the panel to wake from sleep
+    ILI9341_INIT_READY     ///< Display on
+  };
+
+  uint32_t _writeFreq = 0;                 ///< SPI clock given to begin()
+  uint32_t _readFreq = ILI9341_READ_FREQ; ///< SPI clock for readPixels()
+  uint16_t _winX1 = 0xFFFF;   ///< Last CASET start column
+  uint16_t _winX2 = 0xFFFF;   ///< Last CASET end column
+  uint16_t _winY1 = 0xFFFF;   ///< Last PASET start row
+  uint16_t _winY2 = 0xFFFF;   ///< Last PASET end row
+  uint16_t _scrollStart = 0;  ///< Last VSCRSADD value
+  uint16_t _scrollTop = 0;    ///< Last VSCRDEF top fixed area
+  uint16_t _scrollBottom = 0; ///< Last VSCRDEF bottom fixed area
+  uint8_t _madctl = 0;        ///< Last MADCTL value
+  uint8_t _pixfmt = 0;        ///< Last PIXFMT value
+  bool _inverted = false;     ///< INVON in effect
+  bool _sleeping = false;     ///< SLPIN in effect
+  uint16_t _partialStart = 0; ///< Last PTLAR start row
+  uint16_t _partialEnd = 0;   ///< Last PTLAR end row
+  bool _partialMode = false;  ///< PTLON (vs. NORON) in effect
+  bool _idleMode = false;     ///< IDMON in effect
+  bool _tearing = false;      ///< TEON in effect
+  uint8_t _frameRate[3][2];   ///< FRMCTR1-3 parameters (DIVA, RTNA)
+  uint16_t _stateValid = 0;   ///< ILI9341_STATE_* bits
+  uint32_t _initTime = 0;     ///< micros() when the current init step began
+  uint8_t _initState = ILI9341_INIT_NONE; ///< ILI9341_INIT_* step
+#if ILI9341_ENABLE_STATS
+  ILI9341_BusStats _stats[ILI9341_API_COUNT] = {}; ///< Per-group counters
+  uint8_t _statsApi = ILI9341_API_OTHER; ///< Group being charged
+#endif
 };
 
 #endif // _ADAFRUIT_ILI9341H_
@@ -0,0 +1,176 @@
+/*!
+ * @file ILI9341_BandRenderer.cpp
+ *
+ * Banded (strip) renderer for Adafruit_ILI9341.
+ *
+ * BSD license, all text here must be included in any redistribution.
+ *
+ */
+
+#include "ILI9341_BandRenderer.h"
+#include <stdlib.h>
+
+/**************************************************************************/
+/*!
+    @brief  Create a band renderer. Nothing is allocated until begin().
+    @param  tft           Display the bands are sent to.
+    @param  bandHeight    Rows per band. RAM used is width * bandHeight * 2
+                          bytes, doubled if doubleBuffer is set.
+    @param  doubleBuffer  Allocate a second band so drawing and DMA overlap.
+*/
+/**************************************************************************/
+ILI9341_BandRenderer::ILI9341_BandRenderer(Adafruit_ILI9341 &tft,
+                                           uint16_t bandHeight,
+                                           bool doubleBuffer)
+    : Adafruit_GFX(ILI9341_TFTWIDTH, ILI9341_TFTHEIGHT), _tft(tft),
+      _band(NULL), _bandHeight(bandHeight ? bandHeight : 1), _bandY(0),
+      _bandRows(0), _clearColor(ILI9341_BLACK), _double(doubleBuffer) {
+  _buf[0] = _buf[1] = NULL;
+}
+
+ILI9341_BandRenderer::~ILI9341_BandRenderer(void) {
+  free(_buf[0]);
+  free(_buf[1]);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Allocate band buffer(s), sized to the panel's current rotation
+            (set the panel's rotation first and leave this canvas at
+            rotation 0).
+    @return true on success, false if there is not enough RAM.
+*/
+/**************************************************************************/
+bool ILI9341_BandRenderer::begin(void) {
+  free(_buf[0]);
+  free(_buf[1]);
+  _buf[0] = _buf[1] = NULL;
+  _width = _tft.width();
+  _height = _tft.height();
+  if (_bandHeight > _height)
+    _bandHeight = _height;
+  uint32_t bytes = (uint32_t)_width * _bandHeight * sizeof(uint16_t);
+  _buf[0] = (uint16_t *)malloc(bytes);
+  if (_double)
+    _buf[1] = (uint16_t *)malloc(bytes);
+  if (!_buf[0] || (_double && !_buf[1])) {
+    free(_buf[0]);
+    free(_buf[1]);
+    _buf[0] = _buf[1] = NULL;
+    return false;
+  }
+  return true;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Draw one full frame: for each band, clear it, replay the draw
+            callback into it, and stream it to the panel.
+    @param  draw  Scene drawing function.
+    @param  arg   User pointer handed to the callback.
+*/
+/**************************************************************************/
+void ILI9341_BandRenderer::render(ILI9341_DrawCallback draw, void *arg) {
+  if (!_buf[0] || !draw)
+    return;
+  uint8_t idx = 0;
+  _tft.startWrite();
+  for (_bandY = 0; _bandY < _height; _bandY += _bandHeight) {
+    _bandRows = min((int16_t)_bandHeight, (int16_t)(_height - _bandY));
+    _band = _buf[idx];
+    if (!_double) // Only buffer may still be on its way out
+      _tft.dmaWait();
+    uint32_t count = (uint32_t)_width * _bandRows;
+    for (uint32_t i = 0; i < count; i++)
+      _band[i] = _clearColor;
+    draw(*this, arg);
+    _tft.dmaWait();
+    _tft.setAddrWindow(0, _bandY, _width, _bandRows);
+    _tft.writePixels(_band, count, false);
+    if (_double)
+      idx ^= 1;
+  }
+  _tft.dmaWait();
+  _tft.endWrite();
+  _band = NULL;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Set a pixel if it falls inside the current band.
+    @param  x      X coordinate.
+    @param  y      Y coordinate (screen space).
+    @param  color  RGB565 colour.
+*/
+/**************************************************************************/
+void ILI9341_BandRenderer::drawPixel(int16_t x, int16_t y, uint16_t color) {
+  if (!_band || (x < 0) || (x >= _width) || (y < _bandY) ||
+      (y >= _bandY + _bandRows))
+    return;
+  _band[(uint32_t)(y - _bandY) * _width + x] = color;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Fill the part of a rectangle that falls inside the current band.
+    @param  x      Left edge.
+    @param  y      Top edge (screen space).
+    @param  w      Width in pixels.
+    @param  h      Height in pixels.
+    @param  color  RGB565 colour.
+*/
+/**************************************************************************/
+void ILI9341_BandRenderer::fillRect(int16_t x, int16_t y, int16_t w,
+                                    int16_t h, uint16_t color) {
+  if (!_band)
+    return;
+  if (w < 0) {
+    x += w + 1;
+    w = -w;
+  }
+  if (h < 0) {
+    y += h + 1;
+    h = -h;
+  }
+  int16_t x2 = min((int16_t)(x + w), _width);
+  int16_t y2 = min((int16_t)(y + h), (int16_t)(_bandY + _bandRows));
+  if (x < 0)
+    x = 0;
+  if (y < _bandY)
+    y = _bandY;
+  if ((x >= x2) || (y >= y2))
+    return;
+  for (int16_t row = y; row < y2; row++) {
+    uint16_t *p = &_band[(uint32_t)(row - _bandY) * _width + x];
+    for (int16_t i = x; i < x2; i++)
+      *p++ = color;
+  }
+}
+
+/**************************************************************************/
+/*!
+    @brief  Draw the part of a horizontal line inside the current band.
+    @param  x      Left end.
+    @param  y      Row.
+    @param  w      Length in pixels.
+    @param  color  RGB565 colour.
+*/
+/**************************************************************************/
+void ILI9341_BandRenderer::drawFastHLine(int16_t x, int16_t y, int16_t w,
+                                         uint16_t color) {
+  fillRect(x, y, w, 1, color);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Draw the part of a vertical line inside the current band.
+    @param  x      Column.
+    @param  y      Top end.
+    @param  h      Length in pixels.
+    @param  color  RGB565 colour.
+*/
+/**************************************************************************/
+void ILI9341_BandRenderer::drawFastVLine(int16_t x, int16_t y, int16_t h,
+                                         uint16_t color) {
+  fillRect(x, y, 1, h, color);
+}
@@ -0,0 +1,84 @@
+/*!
+ * @file ILI9341_BandRenderer.h
+ *
+ * Banded (strip) renderer for Adafruit_ILI9341: full-frame, flicker-free
+ * composition in a fixed RAM budget of one or two horizontal bands.
+ *
+ * BSD license, all text here must be included in any redistribution.
+ *
+ */
+
+#ifndef _ILI9341_BANDRENDERER_H_
+#define _ILI9341_BANDRENDERER_H_
+
+#include "Adafruit_ILI9341.h"
+
+/*!
+  @brief  Scene drawing function replayed once per band.
+  @param  gfx  Canvas to draw on (clipped to the current band).
+  @param  arg  User pointer passed to ILI9341_BandRenderer::render().
+*/
+typedef void (*ILI9341_DrawCallback)(Adafruit_GFX &gfx, void *arg);
+
+/**************************************************************************/
+/*!
+@brief  Renders a frame as a stack of horizontal bands. The application's
+        draw callback is replayed for every band; drawing lands in a band
+        sized line buffer and is clipped to it, and each finished band is
+        sent with one setAddrWindow() and one (non-blocking where DMA is
+        available) writePixels() call. With two buffers, drawing band k+1
+        overlaps the transfer of band k.
+*/
+/**************************************************************************/
+class ILI9341_BandRenderer : public Adafruit_GFX {
+public:
+  ILI9341_BandRenderer(Adafruit_ILI9341 &tft, uint16_t bandHeight = 40,
+                       bool doubleBuffer = false);
+  ~ILI9341_BandRenderer(void);
+
+  bool begin(void);
+  void render(ILI9341_DrawCallback draw, void *arg = NULL);
+  /*!
+    @brief  Colour each band is cleared to before the callback runs.
+    @param  color  RGB565 background colour.
+  */
+  void setClearColor(uint16_t color) { _clearColor = color; }
+
+  /*!
+    @brief  First row of the band currently being drawn.
+    @return Y coordinate, valid inside the draw callback.
+  */
+  int16_t bandTop(void) const { return _bandY; }
+  /*!
+    @brief  Number of rows in the band currently being drawn.
+    @return Band height (the last band may be shorter).
+  */
+  int16_t bandRows(void) const { return _bandRows; }
+  /*!
+    @brief  Whether a span of rows touches the current band. Callbacks can
+            use this to skip objects that fall entirely outside it.
+    @param  y  First row of the span.
+    @param  h  Number of rows.
+    @return true if any row of the span is in the band.
+  */
+  bool inBand(int16_t y, int16_t h) const {
+    return (y < _bandY + _bandRows) && (y + h > _bandY);
+  }
+
+  void drawPixel(int16_t x, int16_t y, uint16_t color);
+  void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+  void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color);
+  void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color);
+
+private:
+  Adafruit_ILI9341 &_tft; ///< Panel bands are streamed to
+  uint16_t *_buf[2];      ///< Band buffers (second is NULL if single)
+  uint16_t *_band;        ///< Buffer being drawn into
+  uint16_t _bandHeight;   ///< Rows per band
+  int16_t _bandY;         ///< Top row of the band being drawn
+  int16_t _bandRows;      ///< Rows in the band being drawn
+  uint16_t _clearColor;   ///< Band background
+  bool _double;           ///< Use two buffers
+};
+
+#endif // _ILI9341_BANDRENDERER_H_
@@ -0,0 +1,337 @@
+/*!
+ * @file ILI9341_BusScheduler.cpp
+ *
+ * Shares one SPI bus between several Adafruit_ILI9341 panels, interleaving
+ * their queued transfers.
+ *
+ * BSD license, all text here must be included in any redistribution.
+ *
+ */
+
+#include "ILI9341_BusScheduler.h"
+#include <stdlib.h>
+#include <string.h>
+
+/**************************************************************************/
+/*!
+    @brief  Create a scheduler. Nothing is allocated until begin().
+*/
+/**************************************************************************/
+ILI9341_BusScheduler::ILI9341_BusScheduler(void)
+    : _jobs(NULL), _seq(0), _chunk(ILI9341_BUS_CHUNK), _maxJobs(0),
+      _panelCount(0), _active(-1), _last(0), _turn(0), _resumed(false) {
+  for (uint8_t i = 0; i < ILI9341_BUS_PANELS; i++) {
+    _tft[i] = NULL;
+    _weight[i] = 1;
+  }
+  resetStats();
+}
+
+ILI9341_BusScheduler::~ILI9341_BusScheduler(void) {
+  endTurn();
+  free(_jobs);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Allocate the queue, dropping any transfers queued before.
+    @param  maxJobs      Most transfers queued at once, over all panels.
+    @param  chunkPixels  Pixels sent per poll(). Smaller chunks share the
+                         bus more finely at the cost of more commands when
+                         a transfer is resumed.
+    @return true on success, false if there is not enough RAM.
+*/
+/**************************************************************************/
+bool ILI9341_BusScheduler::begin(uint8_t maxJobs, uint16_t chunkPixels) {
+  endTurn();
+  free(_jobs);
+  _jobs = maxJobs ? (Job *)calloc(maxJobs, sizeof(Job)) : NULL;
+  _maxJobs = _jobs ? maxJobs : 0;
+  _chunk = chunkPixels ? chunkPixels : ILI9341_BUS_CHUNK;
+  _turn = 0;
+  return _jobs != NULL;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Add a panel on the shared bus. It must have been started with
+            begin() and have its own CS pin.
+    @param  tft     Panel.
+    @param  weight  Chunks sent each time the panel gets the bus, 1 or
+                    more.
+    @return Panel number for queueing, or -1 if ILI9341_BUS_PANELS panels
+            have already been added.
+*/
+/**************************************************************************/
+int8_t ILI9341_BusScheduler::addPanel(Adafruit_ILI9341 &tft, uint8_t weight) {
+  if (_panelCount >= ILI9341_BUS_PANELS)
+    return -1;
+  _tft[_panelCount] = &tft;
+  _weight[_panelCount] = weight ? weight : 1;
+  _last = _panelCount; // The first turn goes to panel 0
+  return _panelCount++;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Change a panel's share of the bus. Takes effect at its next
+            turn.
+    @param  panel   Panel number from addPanel().
+    @param  weight  Chunks sent each time the panel gets the bus, 1 or
+                    more.
+*/
+/**************************************************************************/
+void ILI9341_BusScheduler::setWeight(uint8_t panel, uint8_t weight) {
+  if (panel < _panelCount)
+    _weight[panel] = weight ? weight : 1;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Queue a block of pixels. The buffer is sent straight from
+            memory (by DMA where supported), so it must stay unchanged
+            until the transfer's callback.
+    @param  panel   Panel number from addPanel().
+    @param  x       Left edge, in the panel's current rotation.
+    @param  y       Top edge.
+    @param  w       Width. The block must lie wholly on the panel.
+    @param  h       Height.
+    @param  pixels  w * h RGB565 pixels, row by row.
+    @param  done    Called from poll() once the last pixel has been sent,
+                    or NULL.
+    @param  arg     Passed to done.
+    @return true if queued, false if the queue is full or the block is
+            not on the panel.
+*/
+/**************************************************************************/
+bool ILI9341_BusScheduler::queuePixels(uint8_t panel, int16_t x, int16_t y,
+                                       int16_t w, int16_t h, uint16_t *pixels,
+                                       ILI9341_BusCallback done, void *arg) {
+  if ((panel >= _panelCount) || !pixels || (x < 0) || (y < 0) || (w < 1) ||
+      (h < 1) || (x + w > _tft[panel]->width()) ||
+      (y + h > _tft[panel]->height()))
+    return false;
+  return queue(panel, x, y, w, h, pixels, 0, done, arg);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Queue a filled rectangle. It is clipped to the panel.
+    @param  panel  Panel number from addPanel().
+    @param  x      Left edge, in the panel's current rotation.
+    @param  y      Top edge.
+    @param  w      Width.
+    @param  h      Height.
+    @param  color  RGB565 colour.
+    @param  done   Called from poll() once the fill has been sent, or NULL.
+    @param  arg    Passed to done.
+    @return true if queued, false if the queue is full or nothing of the
+            rectangle is on the panel.
+*/
+/**************************************************************************/
+bool ILI9341_BusScheduler::queueFill(uint8_t panel, int16_t x, int16_t y,
+                                     int16_t w, int16_t h, uint16_t color,
+                                     ILI9341_BusCallback done, void *arg) {
+  if (panel >= _panelCount)
+    return false;
+  int16_t x2 = min((int32_t)x + w, (int32_t)_tft[panel]->width());
+  int16_t y2 = min((int32_t)y + h, (int32_t)_tft[panel]->height());
+  x = max(x, (int16_t)0);
+  y = max(y, (int16_t)0);
+  if ((x2 <= x) || (y2 <= y))
+    return false;
+  return queue(panel, x, y, x2 - x, y2 - y, NULL, color, done, arg);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Send the next chunk. Call often, e.g. from loop(), or use
+            flush() to wait for everything.
+    @return true while transfers are queued or in flight, false once the
+            queue is empty and the bus has been released.
+*/
+/**************************************************************************/
+bool ILI9341_BusScheduler::poll(void) {
+  if (_active >= 0) {
+    if (_tft[_active]->dmaBusy())
+      return true;
+    // Retire the active panel's transfer once its last chunk is out
+    Job *j = oldest(_active);
+    if (j && (j->sent == (uint32_t)j->w * j->h)) {
+      j->used = false;
+      _stats[_active].jobs++;
+      if (j->done)
+        j->done(_active, j->arg);
+    }
+  }
+
+  int8_t next = nextPanel();
+  if (next != _active) {
+    endTurn(); // Raise the old panel's CS before the next one is selected
+    if (next < 0)
+      return false;
+    _tft[next]->startWrite();
+    _active = next;
+    _resumed = true;
+    _turn = 0;
+  }
+  if (!_turn) {
+    _turn = _weight[next];
+    _last = next;
+    _stats[next].turns++;
+  }
+
+  Adafruit_ILI9341 &tft = *_tft[next];
+  Job *j = oldest(next);
+  if (!j->sent)
+    tft.setAddrWindow(j->x, j->y, j->w, j->h);
+  else if (_resumed) // The controller kept its address; carry on from it
+    tft.writeCommand(ILI9341_RAMWRC);
+  uint32_t n = min((uint32_t)j->w * j->h - j->sent, (uint32_t)_chunk);
+  if (j->pixels)
+    tft.writePixels(j->pixels + j->sent, n, false);
+  else
+    tft.writeColor(j->color, n);
+  j->sent += n;
+  _turn--;
+  _resumed = false;
+  _stats[next].chunks++;
+  _stats[next].pixels += n;
+  return true;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Send everything queued and release the bus.
+*/
+/**************************************************************************/
+void ILI9341_BusScheduler::flush(void) {
+  while (poll())
+    ;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Number of transfers queued for a panel and not yet complete.
+    @param  panel  Panel number from addPanel().
+    @return Transfers.
+*/
+/**************************************************************************/
+uint8_t ILI9341_BusScheduler::pending(uint8_t panel) const {
+  uint8_t n = 0;
+  for (uint8_t i = 0; i < _maxJobs; i++)
+    n += _jobs[i].used && (_jobs[i].panel == panel);
+  return n;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Traffic sent to one panel.
+    @param  panel  Panel number from addPanel().
+    @return Counters since the last resetStats().
+*/
+/**************************************************************************/
+const ILI9341_BusPanelStats &
+ILI9341_BusScheduler::stats(uint8_t panel) const {
+  return _stats[(panel < ILI9341_BUS_PANELS) ? panel : 0];
+}
+
+/**************************************************************************/
+/*!
+    @brief  Zero the traffic counters of every panel.
+*/
+/**************************************************************************/
+void ILI9341_BusScheduler::resetStats(void) {
+  memset(_stats, 0, sizeof _stats);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Put a transfer in a free queue slot.
+    @param  panel   Panel number.
+    @param  x       Left edge, on the panel.
+    @param  y       Top edge.
+    @param  w       Width.
+    @param  h       Height.
+    @param  pixels  Source pixels, or NULL to fill.
+    @param  color   Fill colour.
+    @param  done    Completion callback.
+    @param  arg     Callback argument.
+    @return true if queued, false if the queue is full.
+*/
+/**************************************************************************/
+bool ILI9341_BusScheduler::queue(uint8_t panel, int16_t x, int16_t y,
+                                 int16_t w, int16_t h, uint16_t *pixels,
+                                 uint16_t color, ILI9341_BusCallback done,
+                                 void *arg) {
+  for (uint8_t i = 0; i < _maxJobs; i++) {
+    Job &j = _jobs[i];
+    if (j.used)
+      continue;
+    j.pixels = pixels;
+    j.done = done;
+    j.arg = arg;
+    j.seq = _seq++;
+    j.sent = 0;
+    j.x = x;
+    j.y = y;
+    j.w = w;
+    j.h = h;
+    j.color = color;
+    j.panel = panel;
+    j.used = true;
+    return true;
+  }
+  return false;
+}
+
+/**************************************************************************/
+/*!
+    @brief  The transfer a panel is sending, or will send next.
+    @param  panel  Panel number.
+    @return Its earliest queued transfer, or NULL if it has none.
+*/
+/**************************************************************************/
+ILI9341_BusScheduler::Job *ILI9341_BusScheduler::oldest(uint8_t panel) const {
+  Job *found = NULL;
+  for (uint8_t i = 0; i < _maxJobs; i++) {
+    Job &j = _jobs[i];
+    // Sequence numbers are compared by difference so wrap-around is safe
+    if (j.used && (j.panel == panel) &&
+        (!found || ((int32_t)(j.seq - found->seq) < 0)))
+      found = &j;
+  }
+  return found;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Pick the panel to send the next chunk to: the active one while
+            its turn lasts, otherwise the next panel with work after the
+            one that had the bus last.
+    @return Panel number, or -1 if nothing is queued.
+*/
+/**************************************************************************/
+int8_t ILI9341_BusScheduler::nextPanel(void) const {
+  if ((_active >= 0) && _turn && oldest(_active))
+    return _active;
+  for (uint8_t i = 1; i <= _panelCount; i++) {
+    uint8_t p = (_last + i) % _panelCount;
+    if (oldest(p))
+      return p;
+  }
+  return -1;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Wait for the active panel's last chunk and end its transaction.
+*/
+/**************************************************************************/
+void ILI9341_BusScheduler::endTurn(void) {
+  if (_active >= 0) {
+    _tft[_active]->dmaWait();
+    _tft[_active]->endWrite();
+    _active = -1;
+  }
+}
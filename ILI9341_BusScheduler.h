@@ -0,0 +1,122 @@
+/*!
+ * @file ILI9341_BusScheduler.h
+ *
+ * Shares one SPI bus between several Adafruit_ILI9341 panels, interleaving
+ * their queued transfers.
+ *
+ * BSD license, all text here must be included in any redistribution.
+ *
+ */
+
+#ifndef _ILI9341_BUSSCHEDULER_H_
+#define _ILI9341_BUSSCHEDULER_H_
+
+#include "Adafruit_ILI9341.h"
+
+#define ILI9341_BUS_PANELS 4  ///< Most panels on one scheduler
+#define ILI9341_BUS_CHUNK 512 ///< Default pixels sent per chunk
+
+/*!
+  @brief  Called when a queued transfer has been sent.
+  @param  panel  Panel the transfer was queued for.
+  @param  arg    Pointer given when the transfer was queued.
+*/
+typedef void (*ILI9341_BusCallback)(uint8_t panel, void *arg);
+
+/*!
+  @brief  Traffic sent to one panel since the last resetStats().
+*/
+typedef struct {
+  uint32_t jobs;   ///< Transfers completed
+  uint32_t chunks; ///< Chunks sent
+  uint32_t pixels; ///< Pixels sent
+  uint32_t turns;  ///< Times the panel was given the bus
+} ILI9341_BusPanelStats;
+
+/**************************************************************************/
+/*!
+@brief  Queues pixel and fill transfers for up to ILI9341_BUS_PANELS
+        panels that share a bus but have their own CS pins, and sends them
+        a chunk at a time from poll().
+
+        Panels take turns: a panel with work is given the bus for its
+        weight in chunks, then the next panel with work gets it, so a long
+        transfer on one panel never holds up the others for more than one
+        turn. Equal weights give plain round-robin; a higher weight gives
+        that panel a bigger share while the bus is contended.
+
+        Each panel keeps its transaction (and CS) open for its whole turn.
+        Its address window is cached by its own Adafruit_ILI9341 instance
+        as usual, and a transfer cut off at the end of a turn carries on
+        with RAMWRC when the panel next gets the bus. Where the core
+        supports DMA, pixel chunks are started without blocking and poll()
+        returns at once while one is in flight.
+
+        Don't draw on a panel directly while it has queued transfers; call
+        flush() first.
+*/
+/**************************************************************************/
+class ILI9341_BusScheduler {
+public:
+  ILI9341_BusScheduler(void);
+  ~ILI9341_BusScheduler(void);
+
+  bool begin(uint8_t maxJobs, uint16_t chunkPixels = ILI9341_BUS_CHUNK);
+  int8_t addPanel(Adafruit_ILI9341 &tft, uint8_t weight = 1);
+  void setWeight(uint8_t panel, uint8_t weight);
+
+  bool queuePixels(uint8_t panel, int16_t x, int16_t y, int16_t w, int16_t h,
+                   uint16_t *pixels, ILI9341_BusCallback done = NULL,
+                   void *arg = NULL);
+  bool queueFill(uint8_t panel, int16_t x, int16_t y, int16_t w, int16_t h,
+                 uint16_t color, ILI9341_BusCallback done = NULL,
+                 void *arg = NULL);
+  bool poll(void);
+  void flush(void);
+
+  uint8_t pending(uint8_t panel) const;
+  /*!
+    @brief  Number of panels added.
+    @return Panels.
+  */
+  uint8_t panels(void) const { return _panelCount; }
+  const ILI9341_BusPanelStats &stats(uint8_t panel) const;
+  void resetStats(void);
+
+private:
+  /// One queued transfer
+  typedef struct {
+    uint16_t *pixels;         ///< Source pixels, or NULL for a fill
+    ILI9341_BusCallback done; ///< Completion callback
+    void *arg;                ///< Callback argument
+    uint32_t seq;             ///< Queue order
+    uint32_t sent;            ///< Pixels sent so far
+    int16_t x, y, w, h;       ///< Window
+    uint16_t color;           ///< Fill colour
+    uint8_t panel;            ///< Destination panel
+    bool used;                ///< Slot holds a transfer
+  } Job;
+
+  bool queue(uint8_t panel, int16_t x, int16_t y, int16_t w, int16_t h,
+             uint16_t *pixels, uint16_t color, ILI9341_BusCallback done,
+             void *arg);
+  Job *oldest(uint8_t panel) const;
+  int8_t nextPanel(void) const;
+  void endTurn(void);
+
+  Adafruit_ILI9341 *_tft[ILI9341_BUS_PANELS];       ///< Panels
+  uint8_t _weight[ILI9341_BUS_PANELS];              ///< Chunks per turn
+  ILI9341_BusPanelStats _stats[ILI9341_BUS_PANELS]; ///< Traffic
+
+  Job *_jobs;          ///< Queue slots
+  uint32_t _seq;       ///< Next queue order
+  uint16_t _chunk;     ///< Pixels per chunk
+  uint8_t _maxJobs;    ///< Queue slots
+  uint8_t _panelCount; ///< Panels added
+  int8_t _active;      ///< Panel with an open transaction, -1 if none
+  uint8_t _last;       ///< Panel given the bus most recently
+  uint8_t _turn;       ///< Chunks left in the active panel's turn
+  bool _resumed;       ///< No chunk sent since the active panel got the bus
+};
+
+#endif // _ILI9341_BUSSCHEDULER_H_
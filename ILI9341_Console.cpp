@@ -0,0 +1,249 @@
+/*!
+ * @file ILI9341_Console.cpp
+ *
+ * Hardware-scrolling text console for Adafruit_ILI9341.
+ *
+ * BSD license, all text here must be included in any redistribution.
+ *
+ */
+
+#include "ILI9341_Console.h"
+
+#define CONSOLE_NORMAL 0 ///< Plain text
+#define CONSOLE_ESC 1    ///< Seen ESC
+#define CONSOLE_CSI 2    ///< Seen ESC [, collecting parameters
+
+static const uint16_t PROGMEM ansiColors[16] = {
+    ILI9341_BLACK,    ILI9341_MAROON, ILI9341_DARKGREEN, ILI9341_OLIVE,
+    ILI9341_NAVY,     ILI9341_PURPLE, ILI9341_DARKCYAN,  ILI9341_LIGHTGREY,
+    ILI9341_DARKGREY, ILI9341_RED,    ILI9341_GREEN,     ILI9341_YELLOW,
+    ILI9341_BLUE,     ILI9341_MAGENTA, ILI9341_CYAN,     ILI9341_WHITE};
+
+/**************************************************************************/
+/*!
+    @brief  Create a console. Nothing is sent to the panel until begin().
+    @param  tft          Display to write to.
+    @param  topFixed     Rows reserved at the top of the portrait screen.
+    @param  bottomFixed  Rows reserved at the bottom.
+    @param  textSize     Font scale, 1 for 6x8 pixel characters.
+*/
+/**************************************************************************/
+ILI9341_Console::ILI9341_Console(Adafruit_ILI9341 &tft, uint16_t topFixed,
+                                 uint16_t bottomFixed, uint8_t textSize)
+    : _tft(tft), _top(topFixed), _bottom(bottomFixed), _lines(0), _first(0),
+      _col(0), _row(0), _state(CONSOLE_NORMAL), _nparams(0) {
+  _size = textSize ? textSize : 1;
+  if (_top > ILI9341_TFTHEIGHT)
+    _top = ILI9341_TFTHEIGHT;
+  if (_bottom > ILI9341_TFTHEIGHT - _top)
+    _bottom = ILI9341_TFTHEIGHT - _top;
+  _cols = ILI9341_TFTWIDTH / charWidth();
+}
+
+/**************************************************************************/
+/*!
+    @brief  Set up the scroll area and clear it. The bottom fixed area is
+            grown by any rows left over after fitting whole text lines.
+    @param  fg  Default text colour.
+    @param  bg  Default background colour.
+*/
+/**************************************************************************/
+void ILI9341_Console::begin(uint16_t fg, uint16_t bg) {
+  _tft.setRotation(0);
+  _lines = (ILI9341_TFTHEIGHT - _top - _bottom) / lineHeight();
+  _tft.setScrollMargins(_top, ILI9341_TFTHEIGHT - bottomAreaTop());
+  _defaultFg = _fg = fg;
+  _defaultBg = _bg = bg;
+  _fgIndex = 0xFF;
+  _bright = false;
+  _state = CONSOLE_NORMAL;
+  clear();
+}
+
+/**************************************************************************/
+/*!
+    @brief  Fill the scroll area with the current background colour and
+            home the cursor. The fixed areas are left alone.
+*/
+/**************************************************************************/
+void ILI9341_Console::clear(void) {
+  if (!_lines)
+    return;
+  _first = 0;
+  _tft.scrollTo(_top);
+  _tft.fillRect(0, _top, ILI9341_TFTWIDTH, _lines * lineHeight(), _bg);
+  _clearBg = _bg;
+  memset(_drawn, 0, sizeof _drawn);
+  _col = _row = 0;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Set the colours for following text, as ESC[...m would.
+    @param  fg  Text colour.
+    @param  bg  Background colour.
+*/
+/**************************************************************************/
+void ILI9341_Console::setTextColor(uint16_t fg, uint16_t bg) {
+  _fg = fg;
+  _bg = bg;
+  _fgIndex = 0xFF;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Print one character or escape-sequence byte.
+    @param  c  Byte to write.
+    @return 1, always.
+*/
+/**************************************************************************/
+size_t ILI9341_Console::write(uint8_t c) {
+  if (!_lines)
+    return 1;
+
+  if (_state == CONSOLE_ESC) {
+    if (c == '[') {
+      _state = CONSOLE_CSI;
+      _nparams = 0;
+      _params[0] = 0;
+    } else {
+      _state = CONSOLE_NORMAL;
+    }
+    return 1;
+  }
+  if (_state == CONSOLE_CSI) {
+    if ((c >= '0') && (c <= '9')) {
+      uint16_t v = _params[_nparams] * 10 + (c - '0');
+      _params[_nparams] = (v > 255) ? 255 : v;
+    } else if (c == ';') {
+      if (_nparams < sizeof(_params) - 1)
+        _nparams++;
+      _params[_nparams] = 0;
+    } else if ((c >= 0x40) && (c <= 0x7E)) {
+      control(c);
+      _state = CONSOLE_NORMAL;
+    }
+    return 1;
+  }
+
+  switch (c) {
+  case 0x1B:
+    _state = CONSOLE_ESC;
+    return 1;
+  case '\n':
+    newline();
+    return 1;
+  case '\r':
+    _col = 0;
+    return 1;
+  case '\b':
+    if (_col)
+      _col--;
+    return 1;
+  case '\t':
+    _col = min((_col | 7) + 1, (int)_cols);
+    return 1;
+  }
+  if (c < ' ')
+    return 1;
+
+  if (_col >= _cols) // Wrap is deferred so a full line plus \n isn't two
+    newline();
+  _tft.drawChar(_col * charWidth(), lineY(_row), c, _fg, _bg, _size);
+  uint8_t mem = (_first + _row) % _lines;
+  if (++_col > _drawn[mem])
+    _drawn[mem] = _col;
+  return 1;
+}
+
+int16_t ILI9341_Console::lineY(uint8_t row) const {
+  return _top + ((_first + row) % _lines) * lineHeight();
+}
+
+// Move to the start of the next line, scrolling the area up by one text
+// line in hardware when the cursor is already on the last one.
+void ILI9341_Console::newline(void) {
+  _col = 0;
+  if (_row + 1 < _lines) {
+    _row++;
+    return;
+  }
+  _first = (_first + 1) % _lines;
+  eraseLine(_row, 0, _cols); // The old top line, about to wrap to the bottom
+  _tft.scrollTo(_top + _first * lineHeight());
+}
+
+// Fill columns [from, to) of a line with the background colour. Cells past
+// a line's drawn width still hold _clearBg, so when that is the colour
+// being written only the drawn part is sent.
+void ILI9341_Console::eraseLine(uint8_t row, uint8_t from, uint8_t to) {
+  uint8_t &drawn = _drawn[(_first + row) % _lines];
+  uint8_t end = to;
+  if (_bg == _clearBg) {
+    if (end > drawn)
+      end = drawn;
+    if ((to >= drawn) && (from < drawn))
+      drawn = from;
+  } else if (to > drawn) {
+    drawn = to;
+  }
+  if (end > from)
+    _tft.fillRect(from * charWidth(), lineY(row), (end - from) * charWidth(),
+                  lineHeight(), _bg);
+}
+
+// Act on the final byte of a CSI sequence.
+void ILI9341_Console::control(uint8_t c) {
+  switch (c) {
+  case 'm':
+    for (uint8_t i = 0; i <= _nparams; i++)
+      selectGraphic(_params[i]);
+    break;
+  case 'K':
+    if (_params[0] == 0)
+      eraseLine(_row, min(_col, _cols), _cols);
+    else if (_params[0] == 1)
+      eraseLine(_row, 0, min(_col + 1, (int)_cols));
+    else if (_params[0] == 2)
+      eraseLine(_row, 0, _cols);
+    break;
+  case 'J':
+    if (_params[0] >= 2)
+      clear();
+    break;
+  }
+}
+
+// Apply one SGR parameter.
+void ILI9341_Console::selectGraphic(uint8_t p) {
+  if (p == 0) {
+    _fg = _defaultFg;
+    _bg = _defaultBg;
+    _fgIndex = 0xFF;
+    _bright = false;
+    return;
+  }
+  if ((p == 1) || (p == 22)) {
+    _bright = (p == 1);
+    if (_fgIndex < 16)
+      p = 30 + (_fgIndex & 7); // Re-select the colour at the new intensity
+    else
+      return;
+  }
+  if ((p >= 30) && (p <= 37)) {
+    _fgIndex = (p - 30) + (_bright ? 8 : 0);
+    _fg = pgm_read_word(&ansiColors[_fgIndex]);
+  } else if ((p >= 90) && (p <= 97)) {
+    _fgIndex = (p - 90) + 8;
+    _fg = pgm_read_word(&ansiColors[_fgIndex]);
+  } else if ((p >= 40) && (p <= 47)) {
+    _bg = pgm_read_word(&ansiColors[p - 40]);
+  } else if ((p >= 100) && (p <= 107)) {
+    _bg = pgm_read_word(&ansiColors[p - 100 + 8]);
+  } else if (p == 39) {
+    _fg = _defaultFg;
+    _fgIndex = 0xFF;
+  } else if (p == 49) {
+    _bg = _defaultBg;
+  }
+}
@@ -0,0 +1,93 @@
+/*!
+ * @file ILI9341_Console.h
+ *
+ * Hardware-scrolling text console for Adafruit_ILI9341.
+ *
+ * BSD license, all text here must be included in any redistribution.
+ *
+ */
+
+#ifndef _ILI9341_CONSOLE_H_
+#define _ILI9341_CONSOLE_H_
+
+#include "Adafruit_ILI9341.h"
+
+/**************************************************************************/
+/*!
+@brief  A Print target that runs a scrolling terminal in the middle of the
+        screen, between fixed top and bottom areas set up with
+        setScrollMargins(). Scrolling only moves the VSCRSADD start line and
+        clears the one text line that came into view; the rest of the
+        screen is never redrawn. Fixed areas can be drawn on through the
+        panel as usual at their normal coordinates.
+
+        Understands \\n, \\r, \\b, \\t and these ANSI escapes:
+        ESC[<n>m  (0 reset, 1 bright, 30-37/90-97 foreground,
+                   40-47/100-107 background, 39/49 defaults),
+        ESC[<n>K  (erase in line), ESC[2J (clear).
+
+        The panel is put in rotation 0, since the scroll area runs along
+        the portrait gate lines. Text uses the built-in 6x8 font.
+*/
+/**************************************************************************/
+class ILI9341_Console : public Print {
+public:
+  ILI9341_Console(Adafruit_ILI9341 &tft, uint16_t topFixed = 0,
+                  uint16_t bottomFixed = 0, uint8_t textSize = 1);
+
+  void begin(uint16_t fg = ILI9341_LIGHTGREY, uint16_t bg = ILI9341_BLACK);
+  void clear(void);
+  void setTextColor(uint16_t fg, uint16_t bg);
+
+  size_t write(uint8_t c);
+  using Print::write;
+
+  /*!
+    @brief  Characters per text line.
+    @return Column count.
+  */
+  uint8_t columns(void) const { return _cols; }
+  /*!
+    @brief  Text lines in the scrolling area.
+    @return Line count.
+  */
+  uint8_t lines(void) const { return _lines; }
+  /*!
+    @brief  First panel row of the bottom fixed area. begin() may grow the
+            bottom area so the scroll area is a whole number of lines.
+    @return Row, equal to the panel height if there is no bottom area.
+  */
+  uint16_t bottomAreaTop(void) const { return _top + _lines * lineHeight(); }
+
+private:
+  uint8_t lineHeight(void) const { return 8 * _size; }
+  uint8_t charWidth(void) const { return 6 * _size; }
+  int16_t lineY(uint8_t row) const;
+  void newline(void);
+  void eraseLine(uint8_t row, uint8_t from, uint8_t to);
+  void control(uint8_t c);
+  void selectGraphic(uint8_t p);
+
+  Adafruit_ILI9341 &_tft; ///< Panel being written
+  uint16_t _top;          ///< Rows in the fixed top area
+  uint16_t _bottom;       ///< Rows requested for the fixed bottom area
+  uint16_t _fg;           ///< Current text colour
+  uint16_t _bg;           ///< Current background colour
+  uint16_t _defaultFg;    ///< Colour restored by ESC[0m / ESC[39m
+  uint16_t _defaultBg;    ///< Colour restored by ESC[0m / ESC[49m
+  uint16_t _clearBg;      ///< Colour unwritten cells are known to hold
+  uint8_t _fgIndex;       ///< ANSI colour 0-15, or 0xFF for _defaultFg
+  bool _bright;           ///< ESC[1m in effect
+  uint8_t _size;          ///< Font scale
+  uint8_t _cols;          ///< Characters per line
+  uint8_t _lines;         ///< Lines in the scroll area
+  uint8_t _first;         ///< Memory line shown at the top of the area
+  uint8_t _col;           ///< Cursor column (may equal _cols: wrap pending)
+  uint8_t _row;           ///< Cursor line, 0 = top of the scroll area
+  uint8_t _state;         ///< Escape sequence parser state
+  uint8_t _nparams;       ///< CSI parameters seen so far
+  uint8_t _params[4];     ///< CSI parameters
+  uint8_t _drawn[ILI9341_TFTHEIGHT / 8]; ///< Used columns per memory line
+};
+
+#endif // _ILI9341_CONSOLE_H_
@@ -0,0 +1,328 @@
+/*!
+ * @file ILI9341_DisplayList.cpp
+ *
+ * Records Adafruit_GFX drawing into a compact byte list that can be
+ * replayed onto an Adafruit_ILI9341 in a single transaction.
+ *
+ * BSD license, all text here must be included in any redistribution.
+ *
+ */
+
+#include "ILI9341_DisplayList.h"
+#include <stdlib.h>
+
+static void pack12(uint8_t *p, uint16_t a, uint16_t b) {
+  p[0] = a >> 4;
+  p[1] = (a << 4) | ((b >> 8) & 0x0F);
+  p[2] = b;
+}
+
+static void unpack12(const uint8_t *p, int16_t &a, int16_t &b) {
+  a = ((uint16_t)p[0] << 4) | (p[1] >> 4);
+  b = ((uint16_t)(p[1] & 0x0F) << 8) | p[2];
+}
+
+/**************************************************************************/
+/*!
+    @brief  Create a recorder. Nothing is allocated until begin().
+    @param  w  Canvas width, normally the panel's width() when replayed.
+    @param  h  Canvas height.
+*/
+/**************************************************************************/
+ILI9341_DisplayList::ILI9341_DisplayList(int16_t w, int16_t h)
+    : Adafruit_GFX(w, h), _list(NULL), _capacity(0), _len(0),
+      _colorValid(false), _overflow(false), _pending(false) {}
+
+ILI9341_DisplayList::~ILI9341_DisplayList(void) { free(_list); }
+
+/**************************************************************************/
+/*!
+    @brief  Allocate the list buffer and start an empty list.
+    @param  capacity  Buffer size in bytes. A filled rectangle takes 7
+                      bytes, a line 6, a pixel 4, a colour change 3.
+    @return true on success, false if there is not enough RAM.
+*/
+/**************************************************************************/
+bool ILI9341_DisplayList::begin(uint32_t capacity) {
+  free(_list);
+  _list = (uint8_t *)malloc(capacity);
+  _capacity = _list ? capacity : 0;
+  clear();
+  return _list != NULL;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Discard everything recorded so far.
+*/
+/**************************************************************************/
+void ILI9341_DisplayList::clear(void) {
+  _len = 0;
+  _colorValid = false;
+  _overflow = false;
+  _pending = false;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Record one pixel.
+    @param  x      X coordinate.
+    @param  y      Y coordinate.
+    @param  color  RGB565 colour.
+*/
+/**************************************************************************/
+void ILI9341_DisplayList::drawPixel(int16_t x, int16_t y, uint16_t color) {
+  record(x, y, 1, 1, color);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Record a filled rectangle.
+    @param  x      Left edge.
+    @param  y      Top edge.
+    @param  w      Width in pixels.
+    @param  h      Height in pixels.
+    @param  color  RGB565 colour.
+*/
+/**************************************************************************/
+void ILI9341_DisplayList::fillRect(int16_t x, int16_t y, int16_t w, int16_t h,
+                                   uint16_t color) {
+  if (w < 0) {
+    x += w + 1;
+    w = -w;
+  }
+  if (h < 0) {
+    y += h + 1;
+    h = -h;
+  }
+  record(x, y, w, h, color);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Record a horizontal line.
+    @param  x      Left end.
+    @param  y      Row.
+    @param  w      Length in pixels.
+    @param  color  RGB565 colour.
+*/
+/**************************************************************************/
+void ILI9341_DisplayList::drawFastHLine(int16_t x, int16_t y, int16_t w,
+                                        uint16_t color) {
+  fillRect(x, y, w, 1, color);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Record a vertical line.
+    @param  x      Column.
+    @param  y      Top end.
+    @param  h      Length in pixels.
+    @param  color  RGB565 colour.
+*/
+/**************************************************************************/
+void ILI9341_DisplayList::drawFastVLine(int16_t x, int16_t y, int16_t h,
+                                        uint16_t color) {
+  fillRect(x, y, 1, h, color);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Record a whole-canvas fill. Since it hides everything drawn
+            before it, the list is restarted from this fill.
+    @param  color  RGB565 colour.
+*/
+/**************************************************************************/
+void ILI9341_DisplayList::fillScreen(uint16_t color) {
+  record(0, 0, _width, _height, color);
+}
+
+// Clip a primitive to the canvas, then try to fold it into the held-back
+// primitive before letting that one go into the list.
+void ILI9341_DisplayList::record(int16_t x, int16_t y, int16_t w, int16_t h,
+                                 uint16_t color) {
+  if (!_list)
+    return;
+  if (x < 0) {
+    w += x;
+    x = 0;
+  }
+  if (y < 0) {
+    h += y;
+    y = 0;
+  }
+  if (x + w > _width)
+    w = _width - x;
+  if (y + h > _height)
+    h = _height - y;
+  if ((w <= 0) || (h <= 0))
+    return;
+
+  if ((w == _width) && (h == _height)) { // Overdraws the entire list
+    _len = 0;
+    _colorValid = false;
+    _overflow = false;
+    _pending = false;
+  }
+
+  if (_pending) {
+    if (color == _pcolor) {
+      if ((y == _py) && (h == _ph) && (x == _px + _pw)) {
+        _pw += w; // Continues the held run to the right
+        return;
+      }
+      if ((x == _px) && (w == _pw) && (y == _py + _ph)) {
+        _ph += h; // Continues it downward
+        return;
+      }
+      if ((x >= _px) && (y >= _py) && (x + w <= _px + _pw) &&
+          (y + h <= _py + _ph))
+        return; // Already covered
+    }
+    if ((x > _px) || (y > _py) || (x + w < _px + _pw) ||
+        (y + h < _py + _ph))
+      emitPending();
+    // else: the held primitive is completely overdrawn, drop it
+  }
+  _px = x;
+  _py = y;
+  _pw = w;
+  _ph = h;
+  _pcolor = color;
+  _pending = true;
+}
+
+// Serialise the held-back primitive, preceded by a colour change if needed.
+void ILI9341_DisplayList::emitPending(void) {
+  if (!_pending)
+    return;
+  _pending = false;
+  uint8_t buf[10], n = 0;
+  if (!_colorValid || (_pcolor != _listColor)) {
+    buf[n++] = ILI9341_DL_COLOR;
+    buf[n++] = _pcolor >> 8;
+    buf[n++] = _pcolor;
+  }
+  uint8_t op = n;
+  pack12(&buf[n + 1], _px, _py);
+  if ((_pw == 1) && (_ph == 1)) {
+    buf[op] = ILI9341_DL_PIXEL;
+    n += 4;
+  } else if ((_ph == 1) || (_pw == 1)) {
+    uint16_t len = (_ph == 1) ? _pw : _ph;
+    buf[op] = (_ph == 1) ? ILI9341_DL_HLINE : ILI9341_DL_VLINE;
+    buf[op + 4] = len >> 8;
+    buf[op + 5] = len;
+    n += 6;
+  } else {
+    buf[op] = ILI9341_DL_RECT;
+    pack12(&buf[op + 4], _pw, _ph);
+    n += 7;
+  }
+  if (put(buf, n)) {
+    _listColor = _pcolor;
+    _colorValid = true;
+  }
+}
+
+// Append one primitive. After the first one that doesn't fit nothing more
+// is added, so the list stays a clean prefix of what was drawn.
+bool ILI9341_DisplayList::put(const uint8_t *bytes, uint8_t n) {
+  if (_overflow || (_len + n > _capacity)) {
+    _overflow = true;
+    return false;
+  }
+  memcpy(&_list[_len], bytes, n);
+  _len += n;
+  return true;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Size of the list so far. Completes any primitive still held
+            back for merging, so call it once drawing is finished.
+    @return Bytes used.
+*/
+/**************************************************************************/
+uint32_t ILI9341_DisplayList::length(void) {
+  emitPending();
+  return _len;
+}
+
+/**************************************************************************/
+/*!
+    @brief  The recorded bytes, e.g. to save them or to replay them with
+            the static replay(). Completes any held-back primitive.
+    @return Pointer to length() bytes, or NULL before a successful begin().
+*/
+/**************************************************************************/
+const uint8_t *ILI9341_DisplayList::getBuffer(void) {
+  emitPending();
+  return _list;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Draw the recorded list on a panel.
+    @param  tft  Display to draw on.
+    @return Number of primitives drawn.
+*/
+/**************************************************************************/
+uint32_t ILI9341_DisplayList::replay(Adafruit_ILI9341 &tft) {
+  emitPending();
+  return replay(tft, _list, _len);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Draw a display list on a panel inside one SPI transaction.
+            Consecutive primitives sharing columns or rows reuse the
+            panel's cached address window. Stops at the first byte that
+            is not a valid opcode.
+    @param  tft   Display to draw on.
+    @param  list  Display list bytes (in RAM).
+    @param  len   Length of the list.
+    @return Number of primitives drawn.
+*/
+/**************************************************************************/
+uint32_t ILI9341_DisplayList::replay(Adafruit_ILI9341 &tft,
+                                     const uint8_t *list, uint32_t len) {
+  static const uint8_t size[] = {0, 3, 4, 6, 6, 7}; // Bytes per opcode
+  uint32_t count = 0, i = 0;
+  uint16_t color = 0;
+  int16_t x, y, w, h;
+  if (!list)
+    return 0;
+  tft.startWrite();
+  while (i < len) {
+    uint8_t op = list[i];
+    if ((op < ILI9341_DL_COLOR) || (op > ILI9341_DL_RECT) ||
+        (i + size[op] > len))
+      break;
+    const uint8_t *p = &list[i + 1];
+    i += size[op];
+    if (op == ILI9341_DL_COLOR) {
+      color = ((uint16_t)p[0] << 8) | p[1];
+      continue;
+    }
+    unpack12(p, x, y);
+    switch (op) {
+    case ILI9341_DL_PIXEL:
+      tft.writePixel(x, y, color);
+      break;
+    case ILI9341_DL_HLINE:
+      tft.writeFastHLine(x, y, ((uint16_t)p[3] << 8) | p[4], color);
+      break;
+    case ILI9341_DL_VLINE:
+      tft.writeFastVLine(x, y, ((uint16_t)p[3] << 8) | p[4], color);
+      break;
+    default:
+      unpack12(&p[3], w, h);
+      tft.writeFillRect(x, y, w, h, color);
+      break;
+    }
+    count++;
+  }
+  tft.endWrite();
+  return count;
+}
@@ -0,0 +1,89 @@
+/*!
+ * @file ILI9341_DisplayList.h
+ *
+ * Records Adafruit_GFX drawing into a compact byte list that can be
+ * replayed onto an Adafruit_ILI9341 in a single transaction.
+ *
+ * BSD license, all text here must be included in any redistribution.
+ *
+ */
+
+#ifndef _ILI9341_DISPLAYLIST_H_
+#define _ILI9341_DISPLAYLIST_H_
+
+#include "Adafruit_ILI9341.h"
+
+// Display list opcodes. Coordinates and sizes are packed two to three
+// bytes: a 12-bit value in the first byte and the top nibble of the second,
+// the other in the low nibble of the second byte and the third byte.
+#define ILI9341_DL_COLOR 0x01 ///< + color (2 bytes, MSB first)
+#define ILI9341_DL_PIXEL 0x02 ///< + x,y (3 bytes)
+#define ILI9341_DL_HLINE 0x03 ///< + x,y (3 bytes), w (2 bytes)
+#define ILI9341_DL_VLINE 0x04 ///< + x,y (3 bytes), h (2 bytes)
+#define ILI9341_DL_RECT 0x05  ///< + x,y (3 bytes), w,h (3 bytes)
+
+/**************************************************************************/
+/*!
+@brief  A GFX canvas that records what is drawn on it instead of drawing.
+        Everything Adafruit_GFX draws comes down to pixels, lines and
+        filled rectangles, and those are stored as a byte stream in which
+        the colour is only written when it changes.
+
+        Recording also tidies the stream: a primitive that continues the
+        previous one in the same colour (the next pixel of a line, the next
+        row of a rectangle) is merged into it, one that lies inside the
+        previous one in the same colour is dropped, and one that completely
+        covers the previous one replaces it. Filling the whole canvas
+        discards everything recorded before.
+
+        The canvas stays at rotation 0; it is replayed onto the panel in
+        whatever rotation the panel has at the time.
+*/
+/**************************************************************************/
+class ILI9341_DisplayList : public Adafruit_GFX {
+public:
+  ILI9341_DisplayList(int16_t w = ILI9341_TFTWIDTH,
+                      int16_t h = ILI9341_TFTHEIGHT);
+  ~ILI9341_DisplayList(void);
+
+  bool begin(uint32_t capacity);
+  void clear(void);
+
+  void drawPixel(int16_t x, int16_t y, uint16_t color);
+  void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+  void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color);
+  void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color);
+  void fillScreen(uint16_t color);
+
+  uint32_t length(void);
+  const uint8_t *getBuffer(void);
+  /*!
+    @brief  Whether anything was dropped because the buffer was full.
+            Recording stops at the first primitive that doesn't fit, so
+            the list holds everything drawn before it.
+    @return true if the list is incomplete.
+  */
+  bool overflowed(void) const { return _overflow; }
+
+  uint32_t replay(Adafruit_ILI9341 &tft);
+  static uint32_t replay(Adafruit_ILI9341 &tft, const uint8_t *list,
+                         uint32_t len);
+
+private:
+  void record(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+  void emitPending(void);
+  bool put(const uint8_t *bytes, uint8_t n);
+
+  uint8_t *_list;        ///< Recorded bytes
+  uint32_t _capacity;    ///< Size of _list
+  uint32_t _len;         ///< Bytes used
+  uint16_t _listColor;   ///< Colour in effect at the end of _list
+  bool _colorValid;      ///< _listColor has been set in _list
+  bool _overflow;        ///< A primitive didn't fit
+  bool _pending;         ///< A primitive is held back for merging
+  int16_t _px, _py;      ///< Held primitive: top-left
+  int16_t _pw, _ph;      ///< Held primitive: size
+  uint16_t _pcolor;      ///< Held primitive: colour
+};
+
+#endif // _ILI9341_DISPLAYLIST_H_
@@ -0,0 +1,275 @@
+/*!
+ * @file ILI9341_Framebuffer.cpp
+ *
+ * RAM shadow framebuffer for Adafruit_ILI9341 with dirty-tile flushing.
+ *
+ * BSD license, all text here must be included in any redistribution.
+ *
+ */
+
+#include "ILI9341_Framebuffer.h"
+#include <stdlib.h>
+
+/**************************************************************************/
+/*!
+    @brief  Create a framebuffer for a panel. Nothing is allocated until
+            begin().
+    @param  tft       Display that flush() writes to.
+    @param  tileSize  Edge of a dirty-tracking tile in pixels; rounded down
+                      to a power of two between 4 and 64.
+*/
+/**************************************************************************/
+ILI9341_Framebuffer::ILI9341_Framebuffer(Adafruit_ILI9341 &tft,
+                                         uint8_t tileSize)
+    : Adafruit_GFX(ILI9341_TFTWIDTH, ILI9341_TFTHEIGHT), _tft(tft),
+      _buffer(NULL), _dirty(NULL), _tilesX(0), _tilesY(0) {
+  if (tileSize > 64)
+    tileSize = 64;
+  for (_tileShift = 2; (2 << _tileShift) <= tileSize; _tileShift++)
+    ;
+}
+
+ILI9341_Framebuffer::~ILI9341_Framebuffer(void) {
+  free(_buffer);
+  free(_dirty);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Allocate the RAM copy, sized to the panel's current rotation
+            (set the panel's rotation first and leave this canvas at
+            rotation 0). The buffer starts black and every tile dirty, so
+            the first flush() paints the whole screen.
+    @return true on success, false if there is not enough RAM.
+*/
+/**************************************************************************/
+bool ILI9341_Framebuffer::begin(void) {
+  free(_buffer);
+  free(_dirty);
+  _width = _tft.width();
+  _height = _tft.height();
+  _tilesX = (_width + (1 << _tileShift) - 1) >> _tileShift;
+  _tilesY = (_height + (1 << _tileShift) - 1) >> _tileShift;
+  _buffer = (uint16_t *)calloc((uint32_t)_width * _height, sizeof(uint16_t));
+  _dirty = (uint8_t *)malloc(((uint32_t)_tilesX * _tilesY + 7) / 8);
+  if (!_buffer || !_dirty) {
+    free(_buffer);
+    free(_dirty);
+    _buffer = NULL;
+    _dirty = NULL;
+    return false;
+  }
+  invalidate();
+  return true;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Mark every tile dirty, e.g. after the panel was reset or drawn
+            on directly, so the next flush() resends the whole buffer.
+*/
+/**************************************************************************/
+void ILI9341_Framebuffer::invalidate(void) {
+  if (_dirty)
+    memset(_dirty, 0xFF, ((uint32_t)_tilesX * _tilesY + 7) / 8);
+}
+
+bool ILI9341_Framebuffer::tileDirty(uint16_t tx, uint16_t ty) const {
+  uint32_t i = (uint32_t)ty * _tilesX + tx;
+  return _dirty[i >> 3] & (1 << (i & 7));
+}
+
+void ILI9341_Framebuffer::setTileDirty(uint16_t tx, uint16_t ty, bool dirty) {
+  uint32_t i = (uint32_t)ty * _tilesX + tx;
+  if (dirty)
+    _dirty[i >> 3] |= (1 << (i & 7));
+  else
+    _dirty[i >> 3] &= ~(1 << (i & 7));
+}
+
+/**************************************************************************/
+/*!
+    @brief  Set one pixel in the RAM copy.
+    @param  x      X coordinate.
+    @param  y      Y coordinate.
+    @param  color  RGB565 colour.
+*/
+/**************************************************************************/
+void ILI9341_Framebuffer::drawPixel(int16_t x, int16_t y, uint16_t color) {
+  if (!_buffer || (x < 0) || (y < 0) || (x >= _width) || (y >= _height))
+    return;
+  uint16_t *p = &_buffer[(uint32_t)y * _width + x];
+  if (*p != color) {
+    *p = color;
+    setTileDirty(x >> _tileShift, y >> _tileShift, true);
+  }
+}
+
+/**************************************************************************/
+/*!
+    @brief  Fill a rectangle in the RAM copy. Only tiles in which at least
+            one pixel changes colour are marked dirty.
+    @param  x      Left edge.
+    @param  y      Top edge.
+    @param  w      Width in pixels.
+    @param  h      Height in pixels.
+    @param  color  RGB565 colour.
+*/
+/**************************************************************************/
+void ILI9341_Framebuffer::fillRect(int16_t x, int16_t y, int16_t w, int16_t h,
+                                   uint16_t color) {
+  if (!_buffer)
+    return;
+  if (w < 0) {
+    x += w + 1;
+    w = -w;
+  }
+  if (h < 0) {
+    y += h + 1;
+    h = -h;
+  }
+  if (x < 0) {
+    w += x;
+    x = 0;
+  }
+  if (y < 0) {
+    h += y;
+    y = 0;
+  }
+  if (x + w > _width)
+    w = _width - x;
+  if (y + h > _height)
+    h = _height - y;
+  if ((w <= 0) || (h <= 0))
+    return;
+
+  const uint8_t tileSize = 1 << _tileShift;
+  for (int16_t row = y; row < y + h; row++) {
+    uint16_t *line = &_buffer[(uint32_t)row * _width];
+    uint16_t ty = row >> _tileShift;
+    // Walk the row one tile-wide segment at a time so each tile's dirty
+    // bit is updated once rather than per pixel.
+    for (int16_t x0 = x; x0 < x + w;) {
+      int16_t x1 = ((x0 >> _tileShift) + 1) * tileSize;
+      if (x1 > x + w)
+        x1 = x + w;
+      bool changed = false;
+      for (int16_t i = x0; i < x1; i++) {
+        if (line[i] != color) {
+          line[i] = color;
+          changed = true;
+        }
+      }
+      if (changed)
+        setTileDirty(x0 >> _tileShift, ty, true);
+      x0 = x1;
+    }
+  }
+}
+
+/**************************************************************************/
+/*!
+    @brief  Draw a horizontal line in the RAM copy.
+    @param  x      Left end.
+    @param  y      Row.
+    @param  w      Length in pixels.
+    @param  color  RGB565 colour.
+*/
+/**************************************************************************/
+void ILI9341_Framebuffer::drawFastHLine(int16_t x, int16_t y, int16_t w,
+                                        uint16_t color) {
+  fillRect(x, y, w, 1, color);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Draw a vertical line in the RAM copy.
+    @param  x      Column.
+    @param  y      Top end.
+    @param  h      Length in pixels.
+    @param  color  RGB565 colour.
+*/
+/**************************************************************************/
+void ILI9341_Framebuffer::drawFastVLine(int16_t x, int16_t y, int16_t h,
+                                        uint16_t color) {
+  fillRect(x, y, 1, h, color);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Read back a pixel from the RAM copy.
+    @param  x  X coordinate.
+    @param  y  Y coordinate.
+    @return RGB565 colour, or 0 if out of bounds.
+*/
+/**************************************************************************/
+uint16_t ILI9341_Framebuffer::getPixel(int16_t x, int16_t y) const {
+  if (!_buffer || (x < 0) || (y < 0) || (x >= _width) || (y >= _height))
+    return 0;
+  return _buffer[(uint32_t)y * _width + x];
+}
+
+/**************************************************************************/
+/*!
+    @brief  Send all dirty tiles to the panel. Dirty tiles are gathered into
+            rectangles greedily: a horizontal run of dirty tiles is grown
+            downward for as long as the rows below are dirty across the
+            same span, and each rectangle is sent as a single
+            setAddrWindow() followed by one writePixels() per row.
+    @return Number of pixels sent.
+*/
+/**************************************************************************/
+uint32_t ILI9341_Framebuffer::flush(void) {
+  if (!_buffer)
+    return 0;
+  uint32_t sent = 0;
+  bool started = false;
+
+  for (uint16_t ty = 0; ty < _tilesY; ty++) {
+    for (uint16_t tx = 0; tx < _tilesX;) {
+      if (!tileDirty(tx, ty)) {
+        tx++;
+        continue;
+      }
+      uint16_t tx1 = tx + 1; // Horizontal run [tx, tx1)
+      while ((tx1 < _tilesX) && tileDirty(tx1, ty))
+        tx1++;
+      uint16_t ty1 = ty + 1; // Grow down while the full span is dirty
+      for (;; ty1++) {
+        if (ty1 >= _tilesY)
+          break;
+        uint16_t i = tx;
+        while ((i < tx1) && tileDirty(i, ty1))
+          i++;
+        if (i < tx1)
+          break;
+      }
+      for (uint16_t j = ty; j < ty1; j++)
+        for (uint16_t i = tx; i < tx1; i++)
+          setTileDirty(i, j, false);
+
+      int16_t x = tx << _tileShift, y = ty << _tileShift;
+      int16_t w = min((int16_t)(tx1 << _tileShift), _width) - x;
+      int16_t h = min((int16_t)(ty1 << _tileShift), _height) - y;
+      if (!started) {
+        _tft.startWrite();
+        started = true;
+      }
+      _tft.dmaWait();
+      _tft.setAddrWindow(x, y, w, h);
+      uint16_t *src = &_buffer[(uint32_t)y * _width + x];
+      for (int16_t row = 0; row < h; row++, src += _width) {
+        _tft.dmaWait();
+        _tft.writePixels(src, w, false);
+      }
+      sent += (uint32_t)w * h;
+      tx = tx1;
+    }
+  }
+
+  if (started) {
+    _tft.dmaWait();
+    _tft.endWrite();
+  }
+  return sent;
+}
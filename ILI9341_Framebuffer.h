@@ -0,0 +1,61 @@
+/*!
+ * @file ILI9341_Framebuffer.h
+ *
+ * RAM shadow framebuffer for Adafruit_ILI9341 with dirty-tile flushing.
+ *
+ * Needs width * height * 2 bytes of RAM (150 KB for a full 240x320 panel),
+ * so it is meant for SAMD51, ESP32 and similar boards.
+ *
+ * BSD license, all text here must be included in any redistribution.
+ *
+ */
+
+#ifndef _ILI9341_FRAMEBUFFER_H_
+#define _ILI9341_FRAMEBUFFER_H_
+
+#include "Adafruit_ILI9341.h"
+
+/**************************************************************************/
+/*!
+@brief  A GFX canvas that mirrors the panel in RAM. Drawing only touches the
+        RAM copy and records which tiles actually changed (a pixel written
+        with the colour it already has is not a change); flush() then sends
+        just those tiles, merged into as few address windows as possible.
+*/
+/**************************************************************************/
+class ILI9341_Framebuffer : public Adafruit_GFX {
+public:
+  ILI9341_Framebuffer(Adafruit_ILI9341 &tft, uint8_t tileSize = 16);
+  ~ILI9341_Framebuffer(void);
+
+  bool begin(void);
+  uint32_t flush(void);
+  void invalidate(void);
+
+  void drawPixel(int16_t x, int16_t y, uint16_t color);
+  void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+  void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color);
+  void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color);
+
+  uint16_t getPixel(int16_t x, int16_t y) const;
+  /*!
+    @brief  Direct access to the RAM copy (row-major, width() per row).
+            Pixels changed through this pointer are not tracked; call
+            invalidate() or draw through GFX instead.
+    @return Pointer to the buffer, or NULL before a successful begin().
+  */
+  uint16_t *getBuffer(void) const { return _buffer; }
+
+private:
+  bool tileDirty(uint16_t tx, uint16_t ty) const;
+  void setTileDirty(uint16_t tx, uint16_t ty, bool dirty);
+
+  Adafruit_ILI9341 &_tft; ///< Panel that flush() writes to
+  uint16_t *_buffer;      ///< width * height RGB565 pixels
+  uint8_t *_dirty;        ///< One bit per tile, row-major
+  uint8_t _tileShift;     ///< log2(tile size)
+  uint16_t _tilesX;       ///< Tiles per row
+  uint16_t _tilesY;       ///< Tile rows
+};
+
+#endif // _ILI9341_FRAMEBUFFER_H_
@@ -0,0 +1,364 @@
+/*!
+ * @file ILI9341_IndexedCanvas.cpp
+ *
+ * 8-bit indexed-colour framebuffer for Adafruit_ILI9341.
+ *
+ * BSD license, all text here must be included in any redistribution.
+ *
+ */
+
+#include "ILI9341_IndexedCanvas.h"
+#include <stdlib.h>
+
+#define ROW_CLEAN 0x7FFF ///< _dirtyX0 value for a row with nothing to send
+
+/**************************************************************************/
+/*!
+    @brief  Create an indexed canvas for a panel. Nothing is allocated
+            until begin(). The palette starts as all black.
+    @param  tft  Display that flush() writes to.
+*/
+/**************************************************************************/
+ILI9341_IndexedCanvas::ILI9341_IndexedCanvas(Adafruit_ILI9341 &tft)
+    : Adafruit_GFX(ILI9341_TFTWIDTH, ILI9341_TFTHEIGHT), _tft(tft),
+      _pixels(NULL), _rowUse(NULL), _dirtyX0(NULL), _dirtyX1(NULL),
+      _rowBytes(0), _paletteChanged(false) {
+  _line[0] = _line[1] = NULL;
+  memset(_palette, 0, sizeof _palette);
+  memset(_changed, 0, sizeof _changed);
+}
+
+ILI9341_IndexedCanvas::~ILI9341_IndexedCanvas(void) {
+  free(_pixels);
+  free(_rowUse);
+  free(_dirtyX0);
+  free(_dirtyX1);
+  free(_line[0]);
+  free(_line[1]);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Allocate the index buffer and bookkeeping, sized to the panel's
+            current rotation (set the panel's rotation first and leave this
+            canvas at rotation 0). The canvas starts filled with index 0 and
+            fully dirty.
+    @return true on success, false if there is not enough RAM.
+*/
+/**************************************************************************/
+bool ILI9341_IndexedCanvas::begin(void) {
+  free(_pixels);
+  free(_rowUse);
+  free(_dirtyX0);
+  free(_dirtyX1);
+  free(_line[0]);
+  free(_line[1]);
+  _width = _tft.width();
+  _height = _tft.height();
+  _rowBytes = (_height + 7) / 8;
+  _pixels = (uint8_t *)calloc((uint32_t)_width * _height, 1);
+  _rowUse = (uint8_t *)calloc(256, _rowBytes);
+  _dirtyX0 = (int16_t *)malloc(_height * sizeof(int16_t));
+  _dirtyX1 = (int16_t *)malloc(_height * sizeof(int16_t));
+  _line[0] = (uint16_t *)malloc(_width * sizeof(uint16_t));
+  _line[1] = (uint16_t *)malloc(_width * sizeof(uint16_t));
+  if (!_pixels || !_rowUse || !_dirtyX0 || !_dirtyX1 || !_line[0] ||
+      !_line[1]) {
+    free(_pixels);
+    free(_rowUse);
+    free(_dirtyX0);
+    free(_dirtyX1);
+    free(_line[0]);
+    free(_line[1]);
+    _pixels = _rowUse = NULL;
+    _dirtyX0 = _dirtyX1 = NULL;
+    _line[0] = _line[1] = NULL;
+    return false;
+  }
+  invalidate();
+  return true;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Mark the whole canvas dirty so the next flush() resends it.
+            Every row is also assumed to use every index, as the buffer may
+            have been written through getBuffer(); later palette changes
+            scan the rows and forget indexes a row turns out not to hold.
+*/
+/**************************************************************************/
+void ILI9341_IndexedCanvas::invalidate(void) {
+  if (!_dirtyX0)
+    return;
+  memset(_rowUse, 0xFF, 256 * _rowBytes);
+  for (int16_t y = 0; y < _height; y++) {
+    _dirtyX0[y] = 0;
+    _dirtyX1[y] = _width - 1;
+  }
+}
+
+// Record that columns x0..x1 of row y changed and now hold 'index'
+void ILI9341_IndexedCanvas::markSpan(int16_t y, int16_t x0, int16_t x1,
+                                     uint8_t index) {
+  if (x0 < _dirtyX0[y])
+    _dirtyX0[y] = x0;
+  if (x1 > _dirtyX1[y])
+    _dirtyX1[y] = x1;
+  _rowUse[index * _rowBytes + (y >> 3)] |= (1 << (y & 7));
+}
+
+/**************************************************************************/
+/*!
+    @brief  Change one palette entry. Takes effect on screen at the next
+            flush(), which resends only the pixels that use this index.
+    @param  index  Palette index.
+    @param  color  New RGB565 colour.
+*/
+/**************************************************************************/
+void ILI9341_IndexedCanvas::setPaletteColor(uint8_t index, uint16_t color) {
+  if (_palette[index] == color)
+    return;
+  _palette[index] = color;
+  _changed[index >> 3] |= (1 << (index & 7));
+  _paletteChanged = true;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Load several palette entries at once.
+    @param  colors  RGB565 colours (RAM).
+    @param  first   First palette index to set.
+    @param  count   Number of entries (clipped at index 255).
+*/
+/**************************************************************************/
+void ILI9341_IndexedCanvas::setPalette(const uint16_t *colors, uint8_t first,
+                                       uint16_t count) {
+  for (uint16_t i = 0; (i < count) && (first + i < 256); i++)
+    setPaletteColor(first + i, colors[i]);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Rotate palette entries first..last by one place (entry first
+            takes the colour of first+1, last takes the colour of first).
+            Classic colour-cycling animation.
+    @param  first  Lowest index of the cycle.
+    @param  last   Highest index of the cycle.
+*/
+/**************************************************************************/
+void ILI9341_IndexedCanvas::rotatePalette(uint8_t first, uint8_t last) {
+  if (last <= first)
+    return;
+  uint16_t wrap = _palette[first];
+  for (uint16_t i = first; i < last; i++)
+    setPaletteColor(i, _palette[i + 1]);
+  setPaletteColor(last, wrap);
+}
+
+// Turn pending palette changes into dirty spans: only rows whose bitmap
+// says they use a changed index are scanned, and only the span covering
+// those pixels is marked. Stale row bits found to be unused are cleared.
+void ILI9341_IndexedCanvas::markPaletteRows(void) {
+  uint8_t rows[(ILI9341_TFTHEIGHT + 7) / 8];
+  memset(rows, 0, _rowBytes);
+  for (uint16_t i = 0; i < 256; i++) {
+    if (_changed[i >> 3] & (1 << (i & 7))) {
+      const uint8_t *use = &_rowUse[i * _rowBytes];
+      for (uint16_t b = 0; b < _rowBytes; b++)
+        rows[b] |= use[b];
+    }
+  }
+  for (int16_t y = 0; y < _height; y++) {
+    if (!(rows[y >> 3] & (1 << (y & 7))))
+      continue;
+    const uint8_t *p = &_pixels[(uint32_t)y * _width];
+    int16_t x0 = ROW_CLEAN, x1 = -1;
+    for (int16_t x = 0; x < _width; x++) {
+      if (_changed[p[x] >> 3] & (1 << (p[x] & 7))) {
+        if (x0 == ROW_CLEAN)
+          x0 = x;
+        x1 = x;
+      }
+    }
+    if (x0 != ROW_CLEAN) {
+      if (x0 < _dirtyX0[y])
+        _dirtyX0[y] = x0;
+      if (x1 > _dirtyX1[y])
+        _dirtyX1[y] = x1;
+    } else {
+      for (uint16_t i = 0; i < 256; i++)
+        if (_changed[i >> 3] & (1 << (i & 7)))
+          _rowUse[i * _rowBytes + (y >> 3)] &= ~(1 << (y & 7));
+    }
+  }
+  memset(_changed, 0, sizeof _changed);
+  _paletteChanged = false;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Set one pixel's palette index.
+    @param  x      X coordinate.
+    @param  y      Y coordinate.
+    @param  color  Palette index (low 8 bits used).
+*/
+/**************************************************************************/
+void ILI9341_IndexedCanvas::drawPixel(int16_t x, int16_t y, uint16_t color) {
+  if (!_pixels || (x < 0) || (y < 0) || (x >= _width) || (y >= _height))
+    return;
+  uint8_t *p = &_pixels[(uint32_t)y * _width + x];
+  if (*p != (uint8_t)color) {
+    *p = color;
+    markSpan(y, x, x, color);
+  }
+}
+
+/**************************************************************************/
+/*!
+    @brief  Fill a rectangle with a palette index.
+    @param  x      Left edge.
+    @param  y      Top edge.
+    @param  w      Width in pixels.
+    @param  h      Height in pixels.
+    @param  color  Palette index (low 8 bits used).
+*/
+/**************************************************************************/
+void ILI9341_IndexedCanvas::fillRect(int16_t x, int16_t y, int16_t w,
+                                     int16_t h, uint16_t color) {
+  if (!_pixels)
+    return;
+  if (w < 0) {
+    x += w + 1;
+    w = -w;
+  }
+  if (h < 0) {
+    y += h + 1;
+    h = -h;
+  }
+  if (x < 0) {
+    w += x;
+    x = 0;
+  }
+  if (y < 0) {
+    h += y;
+    y = 0;
+  }
+  if (x + w > _width)
+    w = _width - x;
+  if (y + h > _height)
+    h = _height - y;
+  if ((w <= 0) || (h <= 0))
+    return;
+  uint8_t index = color;
+  for (int16_t row = y; row < y + h; row++) {
+    uint8_t *p = &_pixels[(uint32_t)row * _width];
+    int16_t x0 = ROW_CLEAN, x1 = -1;
+    for (int16_t i = x; i < x + w; i++) {
+      if (p[i] != index) {
+        p[i] = index;
+        if (x0 == ROW_CLEAN)
+          x0 = i;
+        x1 = i;
+      }
+    }
+    if (x0 != ROW_CLEAN)
+      markSpan(row, x0, x1, index);
+  }
+}
+
+/**************************************************************************/
+/*!
+    @brief  Draw a horizontal line with a palette index.
+    @param  x      Left end.
+    @param  y      Row.
+    @param  w      Length in pixels.
+    @param  color  Palette index.
+*/
+/**************************************************************************/
+void ILI9341_IndexedCanvas::drawFastHLine(int16_t x, int16_t y, int16_t w,
+                                          uint16_t color) {
+  fillRect(x, y, w, 1, color);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Draw a vertical line with a palette index.
+    @param  x      Column.
+    @param  y      Top end.
+    @param  h      Length in pixels.
+    @param  color  Palette index.
+*/
+/**************************************************************************/
+void ILI9341_IndexedCanvas::drawFastVLine(int16_t x, int16_t y, int16_t h,
+                                          uint16_t color) {
+  fillRect(x, y, 1, h, color);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Read back a pixel's palette index.
+    @param  x  X coordinate.
+    @param  y  Y coordinate.
+    @return Palette index, or 0 if out of bounds.
+*/
+/**************************************************************************/
+uint8_t ILI9341_IndexedCanvas::getPixel(int16_t x, int16_t y) const {
+  if (!_pixels || (x < 0) || (y < 0) || (x >= _width) || (y >= _height))
+    return 0;
+  return _pixels[(uint32_t)y * _width + x];
+}
+
+/**************************************************************************/
+/*!
+    @brief  Send everything that changed since the last flush(): drawn
+            spans plus the pixels of any palette entries that changed.
+            Consecutive rows with identical spans share one address window;
+            rows are expanded to RGB565 into alternating line buffers so
+            expansion overlaps DMA where available.
+    @return Number of pixels sent.
+*/
+/**************************************************************************/
+uint32_t ILI9341_IndexedCanvas::flush(void) {
+  if (!_pixels)
+    return 0;
+  if (_paletteChanged)
+    markPaletteRows();
+
+  uint32_t sent = 0;
+  uint8_t idx = 0;
+  bool started = false;
+  for (int16_t y = 0; y < _height;) {
+    if (_dirtyX0[y] == ROW_CLEAN) {
+      y++;
+      continue;
+    }
+    int16_t x0 = _dirtyX0[y], x1 = _dirtyX1[y];
+    int16_t y1 = y + 1;
+    while ((y1 < _height) && (_dirtyX0[y1] == x0) && (_dirtyX1[y1] == x1))
+      y1++;
+    int16_t w = x1 - x0 + 1;
+    if (!started) {
+      _tft.startWrite();
+      started = true;
+    }
+    _tft.dmaWait();
+    _tft.setAddrWindow(x0, y, w, y1 - y);
+    for (; y < y1; y++) {
+      const uint8_t *src = &_pixels[(uint32_t)y * _width + x0];
+      uint16_t *dst = _line[idx];
+      for (int16_t i = 0; i < w; i++)
+        dst[i] = _palette[src[i]];
+      _tft.dmaWait();
+      _tft.writePixels(dst, w, false);
+      idx ^= 1;
+      _dirtyX0[y] = ROW_CLEAN;
+      _dirtyX1[y] = -1;
+      sent += w;
+    }
+  }
+  if (started) {
+    _tft.dmaWait();
+    _tft.endWrite();
+  }
+  return sent;
+}
@@ -0,0 +1,79 @@
+/*!
+ * @file ILI9341_IndexedCanvas.h
+ *
+ * 8-bit indexed-colour framebuffer for Adafruit_ILI9341 with a 256-entry
+ * RGB565 palette and palette animation.
+ *
+ * BSD license, all text here must be included in any redistribution.
+ *
+ */
+
+#ifndef _ILI9341_INDEXEDCANVAS_H_
+#define _ILI9341_INDEXEDCANVAS_H_
+
+#include "Adafruit_ILI9341.h"
+
+/**************************************************************************/
+/*!
+@brief  A GFX canvas storing one palette index per pixel (76.8 KB for a
+        full panel, half an RGB565 framebuffer). The "color" argument of
+        every drawing call is a palette index (0-255). flush() expands the
+        changed spans of each row through the palette into a line buffer
+        and streams them to the panel.
+
+        For each palette index the canvas keeps a bitmap of the rows that
+        use it, so changing palette entries (colour cycling) resends only
+        the rows, and within them the span, holding those indexes, with no
+        redraw needed.
+*/
+/**************************************************************************/
+class ILI9341_IndexedCanvas : public Adafruit_GFX {
+public:
+  ILI9341_IndexedCanvas(Adafruit_ILI9341 &tft);
+  ~ILI9341_IndexedCanvas(void);
+
+  bool begin(void);
+  uint32_t flush(void);
+  void invalidate(void);
+
+  void setPaletteColor(uint8_t index, uint16_t color);
+  void setPalette(const uint16_t *colors, uint8_t first = 0,
+                  uint16_t count = 256);
+  void rotatePalette(uint8_t first, uint8_t last);
+  /*!
+    @brief  Look up a palette entry.
+    @param  index  Palette index.
+    @return RGB565 colour.
+  */
+  uint16_t getPaletteColor(uint8_t index) const { return _palette[index]; }
+
+  void drawPixel(int16_t x, int16_t y, uint16_t color);
+  void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+  void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color);
+  void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color);
+  uint8_t getPixel(int16_t x, int16_t y) const;
+  /*!
+    @brief  Direct access to the index buffer (row-major, width() per row).
+            Changes made through this pointer are not tracked; call
+            invalidate() afterwards.
+    @return Pointer to the buffer, or NULL before a successful begin().
+  */
+  uint8_t *getBuffer(void) const { return _pixels; }
+
+private:
+  void markSpan(int16_t y, int16_t x0, int16_t x1, uint8_t index);
+  void markPaletteRows(void);
+
+  Adafruit_ILI9341 &_tft;  ///< Panel that flush() writes to
+  uint8_t *_pixels;        ///< width * height palette indexes
+  uint8_t *_rowUse;        ///< 256 row bitmaps, _rowBytes each
+  int16_t *_dirtyX0;       ///< Per row: first dirty column (0x7FFF: clean)
+  int16_t *_dirtyX1;       ///< Per row: last dirty column (-1: clean)
+  uint16_t *_line[2];      ///< Expansion line buffers
+  uint16_t _rowBytes;      ///< Bytes per row bitmap
+  uint16_t _palette[256];  ///< RGB565 palette
+  uint8_t _changed[32];    ///< Palette entries changed since last flush()
+  bool _paletteChanged;    ///< Any bit set in _changed
+};
+
+#endif // _ILI9341_INDEXEDCANVAS_H_
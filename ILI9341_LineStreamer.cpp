@@ -0,0 +1,122 @@
+/*!
+ * @file ILI9341_LineStreamer.cpp
+ *
+ * Line-by-line streaming of computed pixels to Adafruit_ILI9341, overlapping
+ * rendering with DMA transfers where the board supports it.
+ *
+ * BSD license, all text here must be included in any redistribution.
+ *
+ */
+
+#include "ILI9341_LineStreamer.h"
+#include <stdlib.h>
+
+/**************************************************************************/
+/*!
+    @brief  Create a streamer. Nothing is allocated until begin().
+    @param  tft      Display to write to.
+    @param  buffers  Line buffers to cycle through (at least 2). Two are
+                     enough for a single DMA channel; more give the
+                     callback longer before its buffer is reused. Boards
+                     without DMA only ever allocate one.
+*/
+/**************************************************************************/
+ILI9341_LineStreamer::ILI9341_LineStreamer(Adafruit_ILI9341 &tft,
+                                           uint8_t buffers)
+    : _tft(tft), _lines(NULL), _maxWidth(0),
+      _count(ILI9341_LINESTREAMER_DMA ? max(buffers, (uint8_t)2) : 1),
+      _blocking(!ILI9341_LINESTREAMER_DMA) {
+  resetStats();
+}
+
+ILI9341_LineStreamer::~ILI9341_LineStreamer(void) { free(_lines); }
+
+/**************************************************************************/
+/*!
+    @brief  Allocate the line buffers.
+    @param  maxWidth  Widest rectangle that will be streamed.
+    @return true on success, false if there is not enough RAM.
+*/
+/**************************************************************************/
+bool ILI9341_LineStreamer::begin(uint16_t maxWidth) {
+  free(_lines);
+  _lines = (uint16_t *)malloc((uint32_t)_count * maxWidth * sizeof(uint16_t));
+  _maxWidth = _lines ? maxWidth : 0;
+  return _lines != NULL;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Use blocking writes even where DMA is available, e.g. to compare
+            timings or when the callback needs exclusive use of the bus.
+            Has no effect on boards without DMA, which always block.
+    @param  blocking  true for blocking writes.
+*/
+/**************************************************************************/
+void ILI9341_LineStreamer::setBlocking(bool blocking) {
+  _blocking = blocking || !ILI9341_LINESTREAMER_DMA;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Clear the accumulated statistics.
+*/
+/**************************************************************************/
+void ILI9341_LineStreamer::resetStats(void) {
+  memset(&_stats, 0, sizeof _stats);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Render and send a rectangle. Every line of the rectangle is
+            rendered at its full width; parts outside the screen are
+            rendered but not sent, so the callback never has to clip.
+    @param  x     Left edge.
+    @param  y     Top edge.
+    @param  w     Width in pixels, at most the begin() maxWidth.
+    @param  h     Height in pixels.
+    @param  fill  Callback that renders each line.
+    @param  arg   User pointer handed to the callback.
+    @return Number of pixels sent.
+*/
+/**************************************************************************/
+uint32_t ILI9341_LineStreamer::stream(int16_t x, int16_t y, uint16_t w,
+                                      uint16_t h, ILI9341_LineCallback fill,
+                                      void *arg) {
+  if (!_lines || !fill || (w > _maxWidth))
+    return 0;
+  int16_t x0 = max(x, (int16_t)0), y0 = max(y, (int16_t)0);
+  int16_t x1 = min((int16_t)(x + w), _tft.width());
+  int16_t y1 = min((int16_t)(y + h), _tft.height());
+  if ((x1 <= x0) || (y1 <= y0))
+    return 0;
+  uint16_t skip = x0 - x, cw = x1 - x0;
+
+  _tft.startWrite();
+  _tft.dmaWait();
+  _tft.setAddrWindow(x0, y0, cw, y1 - y0);
+  uint8_t next = 0;
+  for (int16_t row = y0; row < y1; row++) {
+    uint16_t *line = &_lines[(uint32_t)next * _maxWidth];
+    uint32_t t = micros();
+    fill(line, row, w, arg);
+    uint32_t t1 = micros();
+    _stats.renderMicros += t1 - t;
+
+    if (_blocking) {
+      _tft.writePixels(line + skip, cw, true);
+    } else {
+      if ((row > y0) && !_tft.dmaBusy())
+        _stats.starvedLines++;
+      _tft.dmaWait();
+      _stats.dmaWaitMicros += micros() - t1;
+      _tft.writePixels(line + skip, cw, false);
+      if (++next >= _count)
+        next = 0;
+    }
+    _stats.lines++;
+  }
+  _tft.dmaWait();
+  _tft.endWrite();
+  return (uint32_t)cw * (y1 - y0);
+}
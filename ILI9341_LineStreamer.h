@@ -0,0 +1,82 @@
+/*!
+ * @file ILI9341_LineStreamer.h
+ *
+ * Line-by-line streaming of computed pixels to Adafruit_ILI9341, overlapping
+ * rendering with DMA transfers where the board supports it.
+ *
+ * BSD license, all text here must be included in any redistribution.
+ *
+ */
+
+#ifndef _ILI9341_LINESTREAMER_H_
+#define _ILI9341_LINESTREAMER_H_
+
+#include "Adafruit_ILI9341.h"
+
+#if defined(USE_SPI_DMA)
+#define ILI9341_LINESTREAMER_DMA 1 ///< Non-blocking writePixels() available
+#else
+#define ILI9341_LINESTREAMER_DMA 0 ///< writePixels() always blocks
+#endif
+
+/*!
+  @brief  Produces one line of a streamed rectangle.
+  @param  line  Buffer to fill with w RGB565 pixels; line[0] is the
+                rectangle's left edge.
+  @param  y     Screen row being rendered.
+  @param  w     Rectangle width.
+  @param  arg   User pointer passed to ILI9341_LineStreamer::stream().
+*/
+typedef void (*ILI9341_LineCallback)(uint16_t *line, int16_t y, uint16_t w,
+                                     void *arg);
+
+/*!
+  @brief  Where the time went in ILI9341_LineStreamer::stream() calls.
+*/
+typedef struct {
+  uint32_t lines;         ///< Lines sent
+  uint32_t renderMicros;  ///< Time spent in the fill callback
+  uint32_t dmaWaitMicros; ///< Time spent waiting for the previous transfer
+  uint32_t starvedLines;  ///< Lines whose predecessor had already finished
+                          ///< sending before this one was ready
+} ILI9341_StreamStats;
+
+/**************************************************************************/
+/*!
+@brief  Streams a rectangle to the panel one line at a time from a fill
+        callback, so a full-screen effect needs only a few lines of RAM.
+        With DMA, line k+1 is rendered while line k is being sent; without
+        it each line is sent with a blocking write into a single buffer.
+
+        The statistics tell which side is the bottleneck: a scene is
+        bus-bound when dmaWaitMicros is large, and CPU-bound when most
+        lines are starved (the bus sat idle waiting for the renderer).
+*/
+/**************************************************************************/
+class ILI9341_LineStreamer {
+public:
+  ILI9341_LineStreamer(Adafruit_ILI9341 &tft, uint8_t buffers = 2);
+  ~ILI9341_LineStreamer(void);
+
+  bool begin(uint16_t maxWidth = ILI9341_TFTHEIGHT);
+  uint32_t stream(int16_t x, int16_t y, uint16_t w, uint16_t h,
+                  ILI9341_LineCallback fill, void *arg = NULL);
+  void setBlocking(bool blocking);
+
+  /*!
+    @brief  Accumulated timing since the last resetStats().
+    @return Reference to the statistics.
+  */
+  const ILI9341_StreamStats &stats(void) const { return _stats; }
+  void resetStats(void);
+
+private:
+  Adafruit_ILI9341 &_tft;     ///< Panel being written
+  uint16_t *_lines;           ///< _count buffers of _maxWidth pixels
+  uint16_t _maxWidth;         ///< Widest rectangle accepted
+  uint8_t _count;             ///< Line buffers allocated
+  bool _blocking;             ///< Force blocking writes
+  ILI9341_StreamStats _stats; ///< Accumulated timing
+};
+
+#endif // _ILI9341_LINESTREAMER_H_
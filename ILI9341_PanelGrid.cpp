@@ -0,0 +1,370 @@
+/*!
+ * @file ILI9341_PanelGrid.cpp
+ *
+ * One Adafruit_GFX canvas spread over a grid of Adafruit_ILI9341 panels.
+ *
+ * BSD license, all text here must be included in any redistribution.
+ *
+ */
+
+#include "ILI9341_PanelGrid.h"
+#include <string.h>
+
+/*!
+  @brief  Panel width in a rotation.
+  @param  r  Rotation, 0 to 3.
+  @return Pixels.
+*/
+static inline int16_t rotatedWidth(uint8_t r) {
+  return (r & 1) ? ILI9341_TFTHEIGHT : ILI9341_TFTWIDTH;
+}
+
+/*!
+  @brief  Panels down the grid, limited so the grid fits in
+          ILI9341_GRID_PANELS.
+  @param  cols  Panels across, at most ILI9341_GRID_PANELS.
+  @param  rows  Panels down as asked for.
+  @return Panels down.
+*/
+static inline uint8_t fitRows(uint8_t cols, uint8_t rows) {
+  return (cols * rows > ILI9341_GRID_PANELS) ? ILI9341_GRID_PANELS / cols
+                                             : rows;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Create a grid. The panels are not touched until begin().
+    @param  panels         cols * rows panels, row by row as seen with all
+                           of them in panelRotation. Each needs its own CS
+                           pin.
+    @param  cols           Panels across, at most ILI9341_GRID_PANELS.
+    @param  rows           Panels down; cols * rows is limited to
+                           ILI9341_GRID_PANELS.
+    @param  panelRotation  Rotation the panels are used in while the grid
+                           is in rotation 0.
+*/
+/**************************************************************************/
+ILI9341_PanelGrid::ILI9341_PanelGrid(Adafruit_ILI9341 **panels, uint8_t cols,
+                                     uint8_t rows, uint8_t panelRotation)
+    : Adafruit_GFX(min(cols, (uint8_t)ILI9341_GRID_PANELS) *
+                       rotatedWidth(panelRotation),
+                   fitRows(min(cols, (uint8_t)ILI9341_GRID_PANELS), rows) *
+                       rotatedWidth(panelRotation + 1)),
+      _cols(min(cols, (uint8_t)ILI9341_GRID_PANELS)),
+      _rows(fitRows(_cols, rows)), _panelRotation(panelRotation & 3),
+      _tileCols(_cols), _tileW(rotatedWidth(panelRotation)),
+      _tileH(rotatedWidth(panelRotation + 1)), _active(-1), _depth(0) {
+  for (uint8_t i = 0; i < ILI9341_GRID_PANELS; i++) {
+    _panels[i] = (i < _cols * _rows) ? panels[i] : NULL;
+    _tiles[i] = i;
+  }
+}
+
+/**************************************************************************/
+/*!
+    @brief  Start every panel and put it in the grid's rotation.
+    @param  freq  SPI clock for each panel, or 0 for the default.
+*/
+/**************************************************************************/
+void ILI9341_PanelGrid::begin(uint32_t freq) {
+  deselect();
+  for (uint8_t i = 0; i < _cols * _rows; i++)
+    _panels[i]->begin(freq);
+  setRotation(rotation);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Draw one pixel.
+    @param  x      Canvas x.
+    @param  y      Canvas y.
+    @param  color  RGB565 colour.
+*/
+/**************************************************************************/
+void ILI9341_PanelGrid::drawPixel(int16_t x, int16_t y, uint16_t color) {
+  startWrite();
+  writePixel(x, y, color);
+  endWrite();
+}
+
+/**************************************************************************/
+/*!
+    @brief  Begin a batch of drawing. No panel is selected until something
+            is drawn on it. Calls nest.
+*/
+/**************************************************************************/
+void ILI9341_PanelGrid::startWrite(void) { _depth++; }
+
+/**************************************************************************/
+/*!
+    @brief  Draw one pixel inside a startWrite() batch.
+    @param  x      Canvas x.
+    @param  y      Canvas y.
+    @param  color  RGB565 colour.
+*/
+/**************************************************************************/
+void ILI9341_PanelGrid::writePixel(int16_t x, int16_t y, uint16_t color) {
+  if ((x < 0) || (y < 0) || (x >= _width) || (y >= _height))
+    return;
+  int16_t tx = x / _tileW, ty = y / _tileH;
+  select(ty * _tileCols + tx).writePixel(x - tx * _tileW, y - ty * _tileH,
+                                         color);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Fill a rectangle inside a startWrite() batch. Each panel it
+            covers gets one fill of its own part.
+    @param  x      Canvas x of one corner.
+    @param  y      Canvas y of that corner.
+    @param  w      Width; negative extends left from x.
+    @param  h      Height; negative extends up from y.
+    @param  color  RGB565 colour.
+*/
+/**************************************************************************/
+void ILI9341_PanelGrid::writeFillRect(int16_t x, int16_t y, int16_t w,
+                                      int16_t h, uint16_t color) {
+  if (w < 0) {
+    x += w + 1;
+    w = -w;
+  }
+  if (h < 0) {
+    y += h + 1;
+    h = -h;
+  }
+  int16_t x2 = min((int32_t)x + w, (int32_t)_width);
+  int16_t y2 = min((int32_t)y + h, (int32_t)_height);
+  x = max(x, (int16_t)0);
+  y = max(y, (int16_t)0);
+  if ((x2 <= x) || (y2 <= y))
+    return;
+
+  for (int16_t ty = y / _tileH, oy = ty * _tileH; oy < y2;
+       ty++, oy += _tileH) {
+    int16_t y1 = max(y, oy), ye = min(y2, (int16_t)(oy + _tileH));
+    for (int16_t tx = x / _tileW, ox = tx * _tileW; ox < x2;
+         tx++, ox += _tileW) {
+      int16_t x1 = max(x, ox), xe = min(x2, (int16_t)(ox + _tileW));
+      select(ty * _tileCols + tx)
+          .writeFillRect(x1 - ox, y1 - oy, xe - x1, ye - y1, color);
+    }
+  }
+}
+
+/**************************************************************************/
+/*!
+    @brief  Draw a horizontal line inside a startWrite() batch.
+    @param  x      Canvas x of the left end.
+    @param  y      Canvas y.
+    @param  w      Length.
+    @param  color  RGB565 colour.
+*/
+/**************************************************************************/
+void ILI9341_PanelGrid::writeFastHLine(int16_t x, int16_t y, int16_t w,
+                                       uint16_t color) {
+  writeFillRect(x, y, w, 1, color);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Draw a vertical line inside a startWrite() batch.
+    @param  x      Canvas x.
+    @param  y      Canvas y of the top end.
+    @param  h      Length.
+    @param  color  RGB565 colour.
+*/
+/**************************************************************************/
+void ILI9341_PanelGrid::writeFastVLine(int16_t x, int16_t y, int16_t h,
+                                       uint16_t color) {
+  writeFillRect(x, y, 1, h, color);
+}
+
+/**************************************************************************/
+/*!
+    @brief  End a batch of drawing. The outermost call ends the open panel
+            transaction, releasing the bus.
+*/
+/**************************************************************************/
+void ILI9341_PanelGrid::endWrite(void) {
+  if (!_depth || !--_depth)
+    deselect();
+}
+
+/**************************************************************************/
+/*!
+    @brief  Fill a rectangle.
+    @param  x      Canvas x of one corner.
+    @param  y      Canvas y of that corner.
+    @param  w      Width; negative extends left from x.
+    @param  h      Height; negative extends up from y.
+    @param  color  RGB565 colour.
+*/
+/**************************************************************************/
+void ILI9341_PanelGrid::fillRect(int16_t x, int16_t y, int16_t w, int16_t h,
+                                 uint16_t color) {
+  startWrite();
+  writeFillRect(x, y, w, h, color);
+  endWrite();
+}
+
+/**************************************************************************/
+/*!
+    @brief  Draw a horizontal line.
+    @param  x      Canvas x of the left end.
+    @param  y      Canvas y.
+    @param  w      Length.
+    @param  color  RGB565 colour.
+*/
+/**************************************************************************/
+void ILI9341_PanelGrid::drawFastHLine(int16_t x, int16_t y, int16_t w,
+                                      uint16_t color) {
+  fillRect(x, y, w, 1, color);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Draw a vertical line.
+    @param  x      Canvas x.
+    @param  y      Canvas y of the top end.
+    @param  h      Length.
+    @param  color  RGB565 colour.
+*/
+/**************************************************************************/
+void ILI9341_PanelGrid::drawFastVLine(int16_t x, int16_t y, int16_t h,
+                                      uint16_t color) {
+  fillRect(x, y, 1, h, color);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Turn the whole wall. Every panel is set to the grid rotation
+            plus panelRotation, and each quarter turn makes the wired
+            columns of panels the canvas rows.
+    @param  r  Rotation, 0 to 3, as for a single panel.
+*/
+/**************************************************************************/
+void ILI9341_PanelGrid::setRotation(uint8_t r) {
+  deselect();
+  Adafruit_GFX::setRotation(r);
+
+  uint8_t cols = _cols, rows = _rows, turned[ILI9341_GRID_PANELS];
+  for (uint8_t i = 0; i < ILI9341_GRID_PANELS; i++)
+    _tiles[i] = i;
+  for (uint8_t k = 0; k < rotation; k++) {
+    // A quarter turn maps canvas point (x, y) to (width - 1 - y, x) of
+    // the previous layout, so tile (c, r) shows its tile (cols - 1 - r, c)
+    for (uint8_t tr = 0; tr < cols; tr++)
+      for (uint8_t tc = 0; tc < rows; tc++)
+        turned[tr * rows + tc] = _tiles[tc * cols + (cols - 1 - tr)];
+    memcpy(_tiles, turned, cols * rows);
+    uint8_t t = cols;
+    cols = rows;
+    rows = t;
+  }
+  _tileCols = cols;
+
+  uint8_t panelRotation = (_panelRotation + rotation) & 3;
+  _tileW = rotatedWidth(panelRotation);
+  _tileH = rotatedWidth(panelRotation + 1);
+  for (uint8_t i = 0; i < _cols * _rows; i++)
+    _panels[i]->setRotation(panelRotation);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Invert the colours of every panel.
+    @param  i  true to invert, false for normal colours.
+*/
+/**************************************************************************/
+void ILI9341_PanelGrid::invertDisplay(bool i) {
+  deselect();
+  for (uint8_t p = 0; p < _cols * _rows; p++)
+    _panels[p]->invertDisplay(i);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Draw an RGB565 image from RAM. Each panel it covers gets one
+            address window and its part of the image.
+    @param  x        Canvas x of the top-left corner.
+    @param  y        Canvas y of the top-left corner.
+    @param  pcolors  w * h pixels, row by row.
+    @param  w        Width.
+    @param  h        Height.
+*/
+/**************************************************************************/
+void ILI9341_PanelGrid::drawRGBBitmap(int16_t x, int16_t y, uint16_t *pcolors,
+                                      int16_t w, int16_t h) {
+  int16_t x2 = min((int32_t)x + w, (int32_t)_width);
+  int16_t y2 = min((int32_t)y + h, (int32_t)_height);
+  int16_t cx = max(x, (int16_t)0), cy = max(y, (int16_t)0);
+  if ((x2 <= cx) || (y2 <= cy))
+    return;
+
+  startWrite();
+  for (int16_t ty = cy / _tileH, oy = ty * _tileH; oy < y2;
+       ty++, oy += _tileH) {
+    int16_t y1 = max(cy, oy), ye = min(y2, (int16_t)(oy + _tileH));
+    for (int16_t tx = cx / _tileW, ox = tx * _tileW; ox < x2;
+         tx++, ox += _tileW) {
+      int16_t x1 = max(cx, ox), xe = min(x2, (int16_t)(ox + _tileW));
+      Adafruit_ILI9341 &tft = select(ty * _tileCols + tx);
+      uint16_t *src = pcolors + (int32_t)(y1 - y) * w + (x1 - x);
+      tft.setAddrWindow(x1 - ox, y1 - oy, xe - x1, ye - y1);
+      if (xe - x1 == w) { // Whole rows: one run
+        tft.writePixels(src, (uint32_t)w * (ye - y1));
+      } else {
+        for (int16_t j = y1; j < ye; j++, src += w)
+          tft.writePixels(src, xe - x1);
+      }
+    }
+  }
+  endWrite();
+}
+
+/**************************************************************************/
+/*!
+    @brief  Panel showing a canvas point, e.g. to use its own drawing
+            functions. End any startWrite() batch on the grid first.
+    @param  x  Canvas x.
+    @param  y  Canvas y.
+    @return Panel, or NULL if the point is off the canvas. The point is
+            at (x % panelWidth(), y % panelHeight()) on that panel.
+*/
+/**************************************************************************/
+Adafruit_ILI9341 *ILI9341_PanelGrid::panelAt(int16_t x, int16_t y) const {
+  if ((x < 0) || (y < 0) || (x >= _width) || (y >= _height))
+    return NULL;
+  return _panels[_tiles[(y / _tileH) * _tileCols + x / _tileW]];
+}
+
+/**************************************************************************/
+/*!
+    @brief  Make a canvas tile's panel the one with the open transaction,
+            ending the transaction of any other panel first so only one CS
+            is low at a time.
+    @param  tile  Canvas tile, row by row.
+    @return The tile's panel.
+*/
+/**************************************************************************/
+Adafruit_ILI9341 &ILI9341_PanelGrid::select(uint8_t tile) {
+  uint8_t p = _tiles[tile];
+  if (p != _active) {
+    deselect();
+    _panels[p]->startWrite();
+    _active = p;
+  }
+  return *_panels[p];
+}
+
+/**************************************************************************/
+/*!
+    @brief  End the open panel transaction, if any.
+*/
+/**************************************************************************/
+void ILI9341_PanelGrid::deselect(void) {
+  if (_active >= 0) {
+    _panels[_active]->endWrite();
+    _active = -1;
+  }
+}
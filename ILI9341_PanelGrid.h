@@ -0,0 +1,90 @@
+/*!
+ * @file ILI9341_PanelGrid.h
+ *
+ * One Adafruit_GFX canvas spread over a grid of Adafruit_ILI9341 panels.
+ *
+ * BSD license, all text here must be included in any redistribution.
+ *
+ */
+
+#ifndef _ILI9341_PANELGRID_H_
+#define _ILI9341_PANELGRID_H_
+
+#include "Adafruit_ILI9341.h"
+
+#define ILI9341_GRID_PANELS 16 ///< Most panels in one grid
+
+/**************************************************************************/
+/*!
+@brief  Presents cols x rows ILI9341 panels sharing a bus as one large
+        Adafruit_GFX canvas, e.g. for a video wall.
+
+        Every primitive is clipped to each panel it touches, translated into
+        that panel's coordinates and sent only to those panels, using the
+        panel's own accelerated fills and window cache. Transactions are
+        opened lazily: a panel is selected when the first pixel for it
+        arrives and stays selected until drawing moves to another panel or
+        the outermost endWrite(). Wrap a whole frame in startWrite() and
+        endWrite() to send it with one transaction per panel change.
+
+        setRotation() turns the whole wall: each panel is rotated the same
+        way and the panels are reassigned to their new places on the
+        canvas.
+*/
+/**************************************************************************/
+class ILI9341_PanelGrid : public Adafruit_GFX {
+public:
+  ILI9341_PanelGrid(Adafruit_ILI9341 **panels, uint8_t cols, uint8_t rows,
+                    uint8_t panelRotation = 0);
+
+  void begin(uint32_t freq = 0);
+
+  // Adafruit_GFX
+  void drawPixel(int16_t x, int16_t y, uint16_t color);
+  void startWrite(void);
+  void writePixel(int16_t x, int16_t y, uint16_t color);
+  void writeFillRect(int16_t x, int16_t y, int16_t w, int16_t h,
+                     uint16_t color);
+  void writeFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color);
+  void writeFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color);
+  void endWrite(void);
+  void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+  void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color);
+  void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color);
+  void setRotation(uint8_t r);
+  void invertDisplay(bool i);
+
+  using Adafruit_GFX::drawRGBBitmap;
+  void drawRGBBitmap(int16_t x, int16_t y, uint16_t *pcolors, int16_t w,
+                     int16_t h);
+
+  Adafruit_ILI9341 *panelAt(int16_t x, int16_t y) const;
+  /*!
+    @brief  Width of one panel on the canvas in the current rotation.
+    @return Pixels.
+  */
+  int16_t panelWidth(void) const { return _tileW; }
+  /*!
+    @brief  Height of one panel on the canvas in the current rotation.
+    @return Pixels.
+  */
+  int16_t panelHeight(void) const { return _tileH; }
+
+private:
+  Adafruit_ILI9341 &select(uint8_t tile);
+  void deselect(void);
+
+  Adafruit_ILI9341 *_panels[ILI9341_GRID_PANELS]; ///< As wired, row by row
+  uint8_t _tiles[ILI9341_GRID_PANELS];             ///< Panel at each tile
+
+  uint8_t _cols;          ///< Panels across, as wired
+  uint8_t _rows;          ///< Panels down, as wired
+  uint8_t _panelRotation; ///< Panel rotation when the grid is in rotation 0
+  uint8_t _tileCols;      ///< Panels across the canvas
+  int16_t _tileW;         ///< Panel width on the canvas
+  int16_t _tileH;         ///< Panel height on the canvas
+  int8_t _active;         ///< Panel with an open transaction, -1 if none
+  uint8_t _depth;         ///< startWrite() nesting
+};
+
+#endif // _ILI9341_PANELGRID_H_
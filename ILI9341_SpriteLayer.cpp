@@ -0,0 +1,512 @@
+/*!
+ * @file ILI9341_SpriteLayer.cpp
+ *
+ * Sprites drawn over a background on Adafruit_ILI9341 without a frame
+ * buffer, redrawing only the rectangles that change.
+ *
+ * BSD license, all text here must be included in any redistribution.
+ *
+ */
+
+#include "ILI9341_SpriteLayer.h"
+#include <stdlib.h>
+
+/**************************************************************************/
+/*!
+    @brief  Create a sprite layer. Nothing is allocated until begin().
+    @param  tft  Display the sprites are drawn on.
+*/
+/**************************************************************************/
+ILI9341_SpriteLayer::ILI9341_SpriteLayer(Adafruit_ILI9341 &tft)
+    : _tft(tft), _streamer(tft), _fill(NULL), _fillArg(NULL), _sprites(NULL),
+      _rects(NULL), _band(NULL), _maxWidth(0), _max(0), _count(0),
+      _lineX(0) {}
+
+ILI9341_SpriteLayer::~ILI9341_SpriteLayer(void) {
+  for (uint8_t i = 0; i < _count; i++)
+    free(_sprites[i].saved);
+  free(_sprites);
+  free(_rects);
+  free(_band);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Allocate the sprite table and line buffers, dropping any
+            sprites added before.
+    @param  maxSprites  Most sprites that will be added.
+    @param  maxWidth    Widest line sent at once. Wider dirty rectangles
+                        are sent as several strips. In save-under mode a
+                        read buffer of maxWidth * ILI9341_SPRITE_BAND
+                        pixels is also allocated with the first sprite.
+    @return true on success, false if there is not enough RAM.
+*/
+/**************************************************************************/
+bool ILI9341_SpriteLayer::begin(uint8_t maxSprites, uint16_t maxWidth) {
+  for (uint8_t i = 0; i < _count; i++)
+    free(_sprites[i].saved);
+  free(_sprites);
+  free(_rects);
+  free(_band);
+  _band = NULL;
+  _count = 0;
+  _sprites = (Sprite *)calloc(maxSprites, sizeof(Sprite));
+  _rects = (Rect *)malloc(maxSprites * sizeof(Rect));
+  if (!maxSprites || !maxWidth || !_sprites || !_rects ||
+      !_streamer.begin(maxWidth)) {
+    free(_sprites);
+    free(_rects);
+    _sprites = NULL;
+    _rects = NULL;
+    _max = 0;
+    return false;
+  }
+  _max = maxSprites;
+  _maxWidth = maxWidth;
+  return true;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Choose where the background comes from. Call before adding
+            sprites: the mode decides whether each sprite gets a
+            save-under buffer.
+    @param  fill  Callback rendering the background, or NULL to read it
+                  back from the panel (save-under).
+    @param  arg   User pointer handed to the callback.
+*/
+/**************************************************************************/
+void ILI9341_SpriteLayer::setBackground(ILI9341_BackgroundCallback fill,
+                                        void *arg) {
+  _fill = fill;
+  _fillArg = arg;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Add an RGB565 sprite. It starts visible at (0, 0) and appears
+            at the next update().
+    @param  image        w * h pixels in RAM, row by row. Not copied.
+    @param  w            Width in pixels.
+    @param  h            Height in pixels.
+    @param  transparent  Colour that is not drawn, or -1 for none.
+    @return Sprite id, or -1 if the table is full or RAM ran out.
+*/
+/**************************************************************************/
+int8_t ILI9341_SpriteLayer::addSprite(const uint16_t *image, int16_t w,
+                                      int16_t h, int32_t transparent) {
+  Sprite s;
+  memset(&s, 0, sizeof s);
+  s.image = image;
+  s.w = w;
+  s.h = h;
+  s.transparent = transparent;
+  return add(s);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Add an indexed sprite, stored as for drawIndexedBitmap(). It
+            starts visible at (0, 0) and appears at the next update().
+    @param  bitmap       Packed pixels (PROGMEM on AVR). Not copied.
+    @param  bpp          Bits per pixel: 1, 2, 4 or 8.
+    @param  w            Width in pixels.
+    @param  h            Height in pixels.
+    @param  palette      RGB565 colour for each index, in RAM. Changes show
+                         after invalidate() and update().
+    @param  transparent  Index that is not drawn, or -1 for none.
+    @return Sprite id, or -1 if the table is full or RAM ran out.
+*/
+/**************************************************************************/
+int8_t ILI9341_SpriteLayer::addSprite(const uint8_t bitmap[], uint8_t bpp,
+                                      int16_t w, int16_t h,
+                                      const uint16_t *palette,
+                                      int16_t transparent) {
+  Sprite s;
+  memset(&s, 0, sizeof s);
+  s.bitmap = bitmap;
+  s.palette = palette;
+  s.bpp = bpp;
+  s.w = w;
+  s.h = h;
+  s.transparent = transparent;
+  return add(s);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Store a new sprite, with its save-under buffer if needed.
+    @param  s  Sprite with image and size filled in.
+    @return Sprite id, or -1 on failure.
+*/
+/**************************************************************************/
+int8_t ILI9341_SpriteLayer::add(Sprite &s) {
+  if (!_sprites || (_count >= _max) || (s.w <= 0) || (s.h <= 0))
+    return -1;
+  if (!_fill) {
+    if (!_band)
+      _band = (uint16_t *)malloc((uint32_t)_maxWidth * ILI9341_SPRITE_BAND *
+                                 sizeof(uint16_t));
+    s.saved = (uint16_t *)malloc((uint32_t)s.w * s.h * sizeof(uint16_t));
+    if (!_band || !s.saved) {
+      free(s.saved);
+      return -1;
+    }
+  }
+  s.visible = true;
+  s.dirty = true;
+  _sprites[_count] = s;
+  return _count++;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Swap a sprite's RGB565 image for another of the same size.
+    @param  id     Sprite id from addSprite().
+    @param  image  w * h pixels in RAM.
+*/
+/**************************************************************************/
+void ILI9341_SpriteLayer::setImage(uint8_t id, const uint16_t *image) {
+  if (id >= _count)
+    return;
+  _sprites[id].image = image;
+  _sprites[id].bitmap = NULL;
+  _sprites[id].dirty = true;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Swap an indexed sprite's bitmap and palette for others of the
+            same size and depth.
+    @param  id       Sprite id from addSprite().
+    @param  bitmap   Packed pixels (PROGMEM on AVR).
+    @param  palette  RGB565 colour for each index, in RAM.
+*/
+/**************************************************************************/
+void ILI9341_SpriteLayer::setImage(uint8_t id, const uint8_t bitmap[],
+                                   const uint16_t *palette) {
+  if ((id >= _count) || !_sprites[id].bpp)
+    return;
+  _sprites[id].image = NULL;
+  _sprites[id].bitmap = bitmap;
+  _sprites[id].palette = palette;
+  _sprites[id].dirty = true;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Move a sprite at the next update(). Sprites may be partly or
+            wholly off screen.
+    @param  id  Sprite id from addSprite().
+    @param  x   New left edge.
+    @param  y   New top edge.
+*/
+/**************************************************************************/
+void ILI9341_SpriteLayer::moveTo(uint8_t id, int16_t x, int16_t y) {
+  if (id >= _count)
+    return;
+  Sprite &s = _sprites[id];
+  if ((s.x != x) || (s.y != y)) {
+    s.x = x;
+    s.y = y;
+    s.dirty = true;
+  }
+}
+
+/**************************************************************************/
+/*!
+    @brief  Show or hide a sprite at the next update().
+    @param  id       Sprite id from addSprite().
+    @param  visible  true to show.
+*/
+/**************************************************************************/
+void ILI9341_SpriteLayer::show(uint8_t id, bool visible) {
+  if ((id >= _count) || (_sprites[id].visible == visible))
+    return;
+  _sprites[id].visible = visible;
+  _sprites[id].dirty = true;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Redraw a sprite at the next update() even if it did not move,
+            e.g. after its pixels or palette were changed in place.
+    @param  id  Sprite id from addSprite().
+*/
+/**************************************************************************/
+void ILI9341_SpriteLayer::invalidate(uint8_t id) {
+  if (id < _count)
+    _sprites[id].dirty = true;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Bring the screen up to date with the sprites' positions,
+            images and visibility.
+    @return Number of pixels sent.
+*/
+/**************************************************************************/
+uint32_t ILI9341_SpriteLayer::update(void) {
+  if (!_sprites)
+    return 0;
+  if (!_fill)
+    return updateSaved();
+
+  uint8_t n = 0;
+  for (uint8_t i = 0; i < _count; i++) {
+    Sprite &s = _sprites[i];
+    if (!s.dirty)
+      continue;
+    if (dirtyRect(s, _rects[n]))
+      n++;
+    s.sx = s.x;
+    s.sy = s.y;
+    s.shown = s.visible;
+    s.dirty = false;
+  }
+
+  // Merge rectangles whose bounding box costs no more pixels than sending
+  // both, saving a window. Overlaps that fail this test, such as two thin
+  // rectangles crossing, are left apart and the shared area is sent twice
+  for (bool merged = true; merged;) {
+    merged = false;
+    for (uint8_t i = 0; i < n; i++) {
+      for (uint8_t j = i + 1; j < n; j++) {
+        Rect &a = _rects[i], &b = _rects[j];
+        int16_t x0 = min(a.x, b.x), y0 = min(a.y, b.y);
+        int16_t x1 = max(a.x + a.w, b.x + b.w), y1 = max(a.y + a.h, b.y + b.h);
+        if ((int32_t)(x1 - x0) * (y1 - y0) >
+            (int32_t)a.w * a.h + (int32_t)b.w * b.h)
+          continue;
+        a.x = x0;
+        a.y = y0;
+        a.w = x1 - x0;
+        a.h = y1 - y0;
+        _rects[j--] = _rects[--n];
+        merged = true;
+      }
+    }
+  }
+
+  uint32_t sent = 0;
+  for (uint8_t i = 0; i < n; i++) {
+    const Rect &r = _rects[i];
+    for (int16_t x = r.x; x < r.x + r.w; x += _maxWidth) {
+      _lineX = x;
+      sent += _streamer.stream(x, r.y, min(r.x + r.w - x, (int)_maxWidth),
+                               r.h, renderLine, this);
+    }
+  }
+  return sent;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Union of a sprite's on-screen and wanted bounds, clipped.
+    @param  s  Sprite.
+    @param  r  Receives the rectangle.
+    @return false if nothing on screen needs redrawing.
+*/
+/**************************************************************************/
+bool ILI9341_SpriteLayer::dirtyRect(const Sprite &s, Rect &r) const {
+  int16_t x0 = _tft.width(), y0 = _tft.height(), x1 = 0, y1 = 0;
+  if (s.shown) {
+    x0 = max((int16_t)0, s.sx);
+    y0 = max((int16_t)0, s.sy);
+    x1 = s.sx + s.w;
+    y1 = s.sy + s.h;
+  }
+  if (s.visible) {
+    x0 = min(x0, max((int16_t)0, s.x));
+    y0 = min(y0, max((int16_t)0, s.y));
+    x1 = max(x1, (int16_t)(s.x + s.w));
+    y1 = max(y1, (int16_t)(s.y + s.h));
+  }
+  x1 = min(x1, _tft.width());
+  y1 = min(y1, _tft.height());
+  if ((x1 <= x0) || (y1 <= y0))
+    return false;
+  r.x = x0;
+  r.y = y0;
+  r.w = x1 - x0;
+  r.h = y1 - y0;
+  return true;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Draw every sprite crossing part of a line, lowest id first.
+    @param  line    Background pixels to draw over.
+    @param  x       Screen column of line[0].
+    @param  y       Screen row.
+    @param  w       Number of pixels.
+    @param  moving  Sprite drawn at its wanted rather than on-screen
+                    position, or -1.
+*/
+/**************************************************************************/
+void ILI9341_SpriteLayer::compose(uint16_t *line, int16_t x, int16_t y,
+                                  uint16_t w, int8_t moving) const {
+  for (uint8_t i = 0; i < _count; i++) {
+    const Sprite &s = _sprites[i];
+    if ((int8_t)i == moving) {
+      if (s.visible)
+        drawSprite(s, s.x, s.y, line, x, y, w);
+    } else if (s.shown) {
+      drawSprite(s, s.sx, s.sy, line, x, y, w);
+    }
+  }
+}
+
+/**************************************************************************/
+/*!
+    @brief  Draw one sprite's pixels into part of a line.
+    @param  s     Sprite.
+    @param  sx    Sprite left edge.
+    @param  sy    Sprite top edge.
+    @param  line  Pixels to draw over.
+    @param  x     Screen column of line[0].
+    @param  y     Screen row.
+    @param  w     Number of pixels.
+*/
+/**************************************************************************/
+void ILI9341_SpriteLayer::drawSprite(const Sprite &s, int16_t sx, int16_t sy,
+                                     uint16_t *line, int16_t x, int16_t y,
+                                     uint16_t w) const {
+  if ((y < sy) || (y >= sy + s.h))
+    return;
+  int16_t a = max(x, sx), b = min(x + w, sx + s.w);
+  if (b <= a)
+    return;
+  uint16_t *dst = line + (a - x);
+  uint16_t count = b - a;
+  int16_t from = a - sx;
+  if (s.image) {
+    const uint16_t *src = s.image + (uint32_t)(y - sy) * s.w + from;
+    if (s.transparent < 0) {
+      memcpy(dst, src, count * sizeof(uint16_t));
+    } else {
+      const uint16_t key = s.transparent;
+      for (uint16_t i = 0; i < count; i++)
+        if (src[i] != key)
+          dst[i] = src[i];
+    }
+  } else if (s.bitmap) {
+    const uint8_t *row = s.bitmap + (uint32_t)(y - sy) *
+                                        Adafruit_ILI9341::indexedStride(
+                                            s.w, s.bpp);
+    if (s.transparent < 0)
+      Adafruit_ILI9341::expandIndexed(dst, row, s.bpp, from, count, s.palette);
+    else
+      Adafruit_ILI9341::expandIndexed(dst, row, s.bpp, from, count, s.palette,
+                                      s.transparent);
+  }
+}
+
+/**************************************************************************/
+/*!
+    @brief  LineStreamer callback: background then sprites.
+    @param  line  Buffer to fill.
+    @param  y     Screen row.
+    @param  w     Width of the strip being streamed.
+    @param  arg   The sprite layer.
+*/
+/**************************************************************************/
+void ILI9341_SpriteLayer::renderLine(uint16_t *line, int16_t y, uint16_t w,
+                                     void *arg) {
+  ILI9341_SpriteLayer *layer = (ILI9341_SpriteLayer *)arg;
+  layer->_fill(line, layer->_lineX, y, w, layer->_fillArg);
+  layer->compose(line, layer->_lineX, y, w, -1);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Copy the overlap of a sprite-sized block and a band, either
+            way.
+    @param  block    w * h pixels.
+    @param  bx       Block left edge.
+    @param  by       Block top edge.
+    @param  bw       Block width.
+    @param  bh       Block height.
+    @param  band     Band pixels.
+    @param  x        Band left edge.
+    @param  y        Band top edge.
+    @param  w        Band width.
+    @param  h        Band height.
+    @param  toBand   true to copy block to band, false band to block.
+*/
+/**************************************************************************/
+static void copyOverlap(uint16_t *block, int16_t bx, int16_t by, int16_t bw,
+                        int16_t bh, uint16_t *band, int16_t x, int16_t y,
+                        int16_t w, int16_t h, bool toBand) {
+  int16_t x0 = max(bx, x), x1 = min(bx + bw, x + w);
+  int16_t y0 = max(by, y), y1 = min(by + bh, y + h);
+  if ((x1 <= x0) || (y1 <= y0))
+    return;
+  for (int16_t row = y0; row < y1; row++) {
+    uint16_t *b = block + (uint32_t)(row - by) * bw + (x0 - bx);
+    uint16_t *p = band + (uint32_t)(row - y) * w + (x0 - x);
+    if (toBand)
+      memcpy(p, b, (x1 - x0) * sizeof(uint16_t));
+    else
+      memcpy(b, p, (x1 - x0) * sizeof(uint16_t));
+  }
+}
+
+/**************************************************************************/
+/*!
+    @brief  update() without a background callback. Dirty sprites are
+            redrawn one at a time, band by band: the band is read back,
+            the save-under buffers of all sprites on screen are laid over
+            it to recover the background, the moving sprite saves its new
+            position from that, and the band is composed and written.
+            Rectangles wider than the read buffer are split into strips
+            first. Strips and bands are taken in the direction the sprite
+            moved so its save buffer can be updated in place.
+    @return Number of pixels sent.
+*/
+/**************************************************************************/
+uint32_t ILI9341_SpriteLayer::updateSaved(void) {
+  const uint32_t cap = (uint32_t)_maxWidth * ILI9341_SPRITE_BAND;
+  uint32_t sent = 0;
+  for (uint8_t i = 0; i < _count; i++) {
+    Sprite &s = _sprites[i];
+    Rect r;
+    if (!s.dirty)
+      continue;
+    if (s.saved && dirtyRect(s, r)) {
+      const int16_t sw = min((uint32_t)r.w, cap), rows = cap / sw;
+      const bool left = s.shown && s.visible && (s.x < s.sx);
+      const bool up = s.shown && s.visible && (s.y < s.sy);
+      for (int16_t m = 0; m < r.w; m += sw) {
+        int16_t bw = min((int)sw, r.w - m);
+        int16_t bx = left ? (r.x + r.w - m - bw) : (r.x + m);
+        for (int16_t k = 0; k < r.h; k += rows) {
+          int16_t bh = min((int)rows, r.h - k);
+          int16_t by = up ? (r.y + r.h - k - bh) : (r.y + k);
+          _tft.readPixels(bx, by, bw, bh, _band);
+          for (uint8_t j = 0; j < _count; j++) {
+            const Sprite &o = _sprites[j];
+            if (o.shown && o.saved)
+              copyOverlap(o.saved, o.sx, o.sy, o.w, o.h, _band, bx, by, bw,
+                          bh, true);
+          }
+          if (s.visible)
+            copyOverlap(s.saved, s.x, s.y, s.w, s.h, _band, bx, by, bw, bh,
+                        false);
+          for (int16_t row = 0; row < bh; row++)
+            compose(_band + (uint32_t)row * bw, bx, by + row, bw, i);
+          _tft.startWrite();
+          _tft.setAddrWindow(bx, by, bw, bh);
+          _tft.writePixels(_band, (uint32_t)bw * bh);
+          _tft.endWrite();
+          sent += (uint32_t)bw * bh;
+        }
+      }
+    }
+    s.sx = s.x;
+    s.sy = s.y;
+    s.shown = s.visible;
+    s.dirty = false;
+  }
+  return sent;
+}
@@ -0,0 +1,121 @@
+/*!
+ * @file ILI9341_SpriteLayer.h
+ *
+ * Sprites drawn over a background on Adafruit_ILI9341 without a frame
+ * buffer, redrawing only the rectangles that change.
+ *
+ * BSD license, all text here must be included in any redistribution.
+ *
+ */
+
+#ifndef _ILI9341_SPRITELAYER_H_
+#define _ILI9341_SPRITELAYER_H_
+
+#include "ILI9341_LineStreamer.h"
+
+#define ILI9341_SPRITE_BAND 8 ///< Save-under read buffer, in maxWidth lines
+
+/*!
+  @brief  Renders part of one background line under the sprites.
+  @param  line  Buffer to fill with w RGB565 pixels.
+  @param  x     Screen column of line[0].
+  @param  y     Screen row.
+  @param  w     Number of pixels.
+  @param  arg   User pointer passed to ILI9341_SpriteLayer::setBackground().
+*/
+typedef void (*ILI9341_BackgroundCallback)(uint16_t *line, int16_t x,
+                                           int16_t y, uint16_t w, void *arg);
+
+/**************************************************************************/
+/*!
+@brief  A set of sprites composited over a background. update() works out,
+        for each sprite that moved, changed or was shown/hidden, the union
+        of its old and new bounds, merges rectangles that overlap, then
+        rebuilds each one line by line from the background plus every
+        sprite crossing it and streams it out as a single address window.
+
+        The background comes from a callback when one is set. Otherwise
+        each sprite saves the pixels it covers (read back from the panel,
+        so MISO must be connected) and puts them back when it moves away;
+        draw the background before showing any sprites.
+
+        Sprites are RGB565 images in RAM or packed indexed bitmaps (as for
+        drawIndexedBitmap()) with an optional transparent colour/index.
+        Higher ids are drawn on top.
+*/
+/**************************************************************************/
+class ILI9341_SpriteLayer {
+public:
+  ILI9341_SpriteLayer(Adafruit_ILI9341 &tft);
+  ~ILI9341_SpriteLayer(void);
+
+  bool begin(uint8_t maxSprites, uint16_t maxWidth = ILI9341_TFTHEIGHT);
+  void setBackground(ILI9341_BackgroundCallback fill, void *arg = NULL);
+
+  int8_t addSprite(const uint16_t *image, int16_t w, int16_t h,
+                   int32_t transparent = -1);
+  int8_t addSprite(const uint8_t bitmap[], uint8_t bpp, int16_t w, int16_t h,
+                   const uint16_t *palette, int16_t transparent = -1);
+  void setImage(uint8_t id, const uint16_t *image);
+  void setImage(uint8_t id, const uint8_t bitmap[], const uint16_t *palette);
+  void moveTo(uint8_t id, int16_t x, int16_t y);
+  void show(uint8_t id, bool visible = true);
+  /*!
+    @brief  Hide a sprite at the next update().
+    @param  id  Sprite id from addSprite().
+  */
+  void hide(uint8_t id) { show(id, false); }
+  void invalidate(uint8_t id);
+  uint32_t update(void);
+
+  /*!
+    @brief  Number of sprites added so far.
+    @return Sprite count.
+  */
+  uint8_t count(void) const { return _count; }
+
+private:
+  /// One sprite: what is wanted and what is on the screen
+  typedef struct {
+    const uint16_t *image;   ///< RGB565 pixels, or NULL if indexed
+    const uint8_t *bitmap;   ///< Packed indexed pixels
+    const uint16_t *palette; ///< Colours for bitmap
+    uint16_t *saved;         ///< Background under the sprite (save-under)
+    int32_t transparent;     ///< Colour key or index, -1 for none
+    int16_t x, y;            ///< Wanted position
+    int16_t sx, sy;          ///< Position on screen
+    int16_t w, h;            ///< Size
+    uint8_t bpp;             ///< Bits per pixel of bitmap
+    bool visible;            ///< Wanted visibility
+    bool shown;              ///< Currently on screen at sx, sy
+    bool dirty;              ///< Needs redrawing
+  } Sprite;
+
+  /// Screen rectangle
+  typedef struct {
+    int16_t x, y, w, h; ///< Position and size
+  } Rect;
+
+  int8_t add(Sprite &s);
+  bool dirtyRect(const Sprite &s, Rect &r) const;
+  void compose(uint16_t *line, int16_t x, int16_t y, uint16_t w,
+               int8_t moving) const;
+  void drawSprite(const Sprite &s, int16_t sx, int16_t sy, uint16_t *line,
+                  int16_t x, int16_t y, uint16_t w) const;
+  uint32_t updateSaved(void);
+  static void renderLine(uint16_t *line, int16_t y, uint16_t w, void *arg);
+
+  Adafruit_ILI9341 &_tft;             ///< Panel being drawn
+  ILI9341_LineStreamer _streamer;     ///< Line output (callback mode)
+  ILI9341_BackgroundCallback _fill;   ///< Background source, or NULL
+  void *_fillArg;                     ///< User pointer for _fill
+  Sprite *_sprites;                   ///< _max sprite slots
+  Rect *_rects;                       ///< Dirty rectangles for update()
+  uint16_t *_band;                    ///< Save-under read buffer
+  uint16_t _maxWidth;                 ///< Widest line streamed at once
+  uint8_t _max;                       ///< Sprite slots
+  uint8_t _count;                     ///< Sprites added
+  int16_t _lineX;                     ///< Left edge of the rect streaming
+};
+
+#endif // _ILI9341_SPRITELAYER_H_
@@ -0,0 +1,216 @@
+/*!
+ * @file ILI9341_StripChart.cpp
+ *
+ * Hardware-scrolled strip chart and waterfall for Adafruit_ILI9341.
+ *
+ * BSD license, all text here must be included in any redistribution.
+ *
+ */
+
+#include "ILI9341_StripChart.h"
+
+/**************************************************************************/
+/*!
+    @brief  Create a strip chart.
+    @param  tft    Display to draw on.
+    @param  left   Fixed columns left of the plot (axis labels).
+    @param  right  Fixed columns right of the plot (legend).
+*/
+/**************************************************************************/
+ILI9341_StripChart::ILI9341_StripChart(Adafruit_ILI9341 &tft, uint16_t left,
+                                       uint16_t right)
+    : _tft(tft), _left(left), _right(right), _width(0), _next(0),
+      _bg(ILI9341_BLACK), _gridColor(ILI9341_DARKGREY), _gridRows(0),
+      _gridColumns(0), _gridPhase(0), _lo(0), _hi(1) {
+  static const uint16_t colors[ILI9341_STRIPCHART_SERIES] = {
+      ILI9341_YELLOW, ILI9341_CYAN, ILI9341_MAGENTA, ILI9341_GREEN};
+  for (uint8_t i = 0; i < ILI9341_STRIPCHART_SERIES; i++) {
+    _colors[i] = colors[i];
+    _last[i] = -1;
+  }
+}
+
+/**************************************************************************/
+/*!
+    @brief  Set up the scroll area and clear the plot. The panel is put in
+            rotation 1 unless it is already in a landscape rotation (1 or
+            3). Draw axes and legends in the fixed columns afterwards.
+    @param  bg  Plot background colour.
+*/
+/**************************************************************************/
+void ILI9341_StripChart::begin(uint16_t bg) {
+  if (!(_tft.getRotation() & 1))
+    _tft.setRotation(1);
+  if (_left + _right >= ILI9341_TFTHEIGHT)
+    _left = _right = 0;
+  _width = ILI9341_TFTHEIGHT - _left - _right;
+  _bg = bg;
+  _next = 0;
+  _gridPhase = 0;
+  for (uint8_t i = 0; i < ILI9341_STRIPCHART_SERIES; i++)
+    _last[i] = -1;
+
+  // Gate line 0 is the left edge in rotation 1 and the right edge in 3
+  if (_tft.getRotation() == 1)
+    _tft.setScrollMargins(_left, _right);
+  else
+    _tft.setScrollMargins(_right, _left);
+  _tft.scrollTo(_tft.getRotation() == 1 ? _left : _right);
+  _tft.fillRect(_left, 0, _width, _tft.height(), _bg);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Set the values at the bottom and top of the plot. Samples
+            outside are drawn at the edge. Takes effect for new samples.
+    @param  lo  Value at the bottom row.
+    @param  hi  Value at the top row.
+*/
+/**************************************************************************/
+void ILI9341_StripChart::setRange(float lo, float hi) {
+  if (hi != lo) {
+    _lo = lo;
+    _hi = hi;
+  }
+}
+
+/**************************************************************************/
+/*!
+    @brief  Set the colour of one trace.
+    @param  series  Trace, 0 to ILI9341_STRIPCHART_SERIES - 1.
+    @param  color   RGB565 colour.
+*/
+/**************************************************************************/
+void ILI9341_StripChart::setSeriesColor(uint8_t series, uint16_t color) {
+  if (series < ILI9341_STRIPCHART_SERIES)
+    _colors[series] = color;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Draw a grid behind the traces of new samples.
+    @param  color    RGB565 grid colour.
+    @param  rows     Rows between horizontal lines, counted from the
+                     bottom; at least ILI9341_STRIPCHART_MIN_GRID, or 0
+                     for none.
+    @param  columns  Samples between vertical lines, or 0 for none.
+*/
+/**************************************************************************/
+void ILI9341_StripChart::setGrid(uint16_t color, uint8_t rows,
+                                 uint8_t columns) {
+  _gridColor = color;
+  _gridRows = rows ? max(rows, (uint8_t)ILI9341_STRIPCHART_MIN_GRID) : 0;
+  _gridColumns = columns;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Add one sample of every trace: a column with the grid and each
+            trace joined to its previous value.
+    @param  values  One value per trace. NAN leaves a gap in that trace.
+    @param  count   Number of traces, at most ILI9341_STRIPCHART_SERIES.
+*/
+/**************************************************************************/
+void ILI9341_StripChart::addSample(const float *values, uint8_t count) {
+  ILI9341_VSpan spans[ILI9341_TFTWIDTH / ILI9341_STRIPCHART_MIN_GRID + 1 +
+                      ILI9341_STRIPCHART_SERIES];
+  const int16_t x = nextColumn(), h = _tft.height();
+  uint8_t n = 0;
+
+  if (_gridColumns && !_gridPhase) {
+    spans[n].x = x;
+    spans[n].y0 = 0;
+    spans[n].y1 = h - 1;
+    spans[n++].color = _gridColor;
+  } else if (_gridRows) {
+    for (int16_t y = h - 1; y >= 0; y -= _gridRows) {
+      spans[n].x = x;
+      spans[n].y0 = spans[n].y1 = y;
+      spans[n++].color = _gridColor;
+    }
+  }
+  if (_gridColumns && (++_gridPhase >= _gridColumns))
+    _gridPhase = 0;
+
+  count = min(count, (uint8_t)ILI9341_STRIPCHART_SERIES);
+  for (uint8_t i = 0; i < count; i++) {
+    if (isnan(values[i])) {
+      _last[i] = -1;
+      continue;
+    }
+    int16_t y = valueRow(values[i]);
+    int16_t prev = (_last[i] < 0) ? y : _last[i];
+    spans[n].x = x;
+    spans[n].y0 = min(y, prev);
+    spans[n].y1 = max(y, prev);
+    spans[n++].color = _colors[i];
+    _last[i] = y;
+  }
+
+  _tft.drawVSpans(spans, n, 0, h, _bg);
+  advance();
+}
+
+/**************************************************************************/
+/*!
+    @brief  Add a column of pixels, e.g. one line of a waterfall display.
+            Traces restart after it.
+    @param  colors  tft.height() RGB565 pixels, top to bottom.
+*/
+/**************************************************************************/
+void ILI9341_StripChart::addColumn(uint16_t *colors) {
+  _tft.startWrite();
+  _tft.setAddrWindow(nextColumn(), 0, 1, _tft.height());
+  _tft.writePixels(colors, _tft.height());
+  _tft.endWrite();
+  for (uint8_t i = 0; i < ILI9341_STRIPCHART_SERIES; i++)
+    _last[i] = -1;
+  advance();
+}
+
+/**************************************************************************/
+/*!
+    @brief  Row for a value, clamped to the plot.
+    @param  value  Sample value.
+    @return Screen row.
+*/
+/**************************************************************************/
+int16_t ILI9341_StripChart::valueRow(float value) const {
+  const int16_t h = _tft.height();
+  float row = (h - 1) * (_hi - value) / (_hi - _lo);
+  return (row < 0) ? 0 : (row > h - 1) ? h - 1 : (int16_t)(row + 0.5f);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Screen column, in the panel's current rotation, of the memory
+            line the next sample is written to.
+    @return Column.
+*/
+/**************************************************************************/
+int16_t ILI9341_StripChart::nextColumn(void) const {
+  if (_tft.getRotation() == 1) // Gate line = screen x
+    return _left + _next;
+  return ILI9341_TFTHEIGHT - 1 - (_right + _next); // Gate line = 319 - x
+}
+
+/**************************************************************************/
+/*!
+    @brief  Scroll so the line just written is the rightmost plot column,
+            and pick the line for the next sample.
+*/
+/**************************************************************************/
+void ILI9341_StripChart::advance(void) {
+  if (_tft.getRotation() == 1) {
+    // Screen columns run up the gate lines: the oldest line, shown at the
+    // left edge, is the one after the newest
+    if (++_next >= _width)
+      _next = 0;
+    _tft.scrollTo(_left + _next);
+  } else {
+    // Screen columns run down the gate lines: the newest line is shown at
+    // the right edge, which is the top of the scroll area
+    _tft.scrollTo(_right + _next);
+    _next = _next ? _next - 1 : _width - 1;
+  }
+}
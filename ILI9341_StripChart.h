@@ -0,0 +1,85 @@
+/*!
+ * @file ILI9341_StripChart.h
+ *
+ * Hardware-scrolled strip chart and waterfall for Adafruit_ILI9341.
+ *
+ * BSD license, all text here must be included in any redistribution.
+ *
+ */
+
+#ifndef _ILI9341_STRIPCHART_H_
+#define _ILI9341_STRIPCHART_H_
+
+#include "Adafruit_ILI9341.h"
+
+#define ILI9341_STRIPCHART_SERIES 4   ///< Most traces in one chart
+#define ILI9341_STRIPCHART_MIN_GRID 8 ///< Closest horizontal grid spacing
+
+/**************************************************************************/
+/*!
+@brief  A rolling plot in a landscape rotation. New samples appear at the
+        right-hand edge and older ones move left. Each sample writes one
+        column of pixels and moves the VSCRSADD start line by one, so the
+        history is never redrawn.
+
+        In landscape the panel's gate lines run across the screen, so the
+        scroll area set with setScrollMargins() is a band of columns. The
+        columns left and right of the plot stay fixed and can be drawn on
+        through the panel as usual for axes and legends. The plot owns the
+        full height of its columns.
+
+        Samples can be series of values (drawn as connected traces over
+        an optional grid) or whole columns of pixels, as for a waterfall
+        display.
+*/
+/**************************************************************************/
+class ILI9341_StripChart {
+public:
+  ILI9341_StripChart(Adafruit_ILI9341 &tft, uint16_t left = 0,
+                     uint16_t right = 0);
+
+  void begin(uint16_t bg = ILI9341_BLACK);
+  void setRange(float lo, float hi);
+  void setSeriesColor(uint8_t series, uint16_t color);
+  void setGrid(uint16_t color, uint8_t rows, uint8_t columns);
+  void addSample(const float *values, uint8_t count);
+  /*!
+    @brief  Add a sample to a single-series chart.
+    @param  value  Sample value.
+  */
+  void addSample(float value) { addSample(&value, 1); }
+  void addColumn(uint16_t *colors);
+
+  /*!
+    @brief  Screen column of the plot's left edge.
+    @return Column.
+  */
+  uint16_t plotLeft(void) const { return _left; }
+  /*!
+    @brief  Width of the plot: the number of samples visible at once.
+    @return Columns.
+  */
+  uint16_t plotWidth(void) const { return _width; }
+
+private:
+  int16_t valueRow(float value) const;
+  int16_t nextColumn(void) const;
+  void advance(void);
+
+  Adafruit_ILI9341 &_tft; ///< Panel being drawn
+  uint16_t _left;         ///< Fixed columns on the left
+  uint16_t _right;        ///< Fixed columns on the right
+  uint16_t _width;        ///< Plot columns
+  uint16_t _next;         ///< Scroll-area line for the next sample
+  uint16_t _bg;           ///< Plot background
+  uint16_t _gridColor;    ///< Grid colour
+  uint8_t _gridRows;      ///< Rows between horizontal grid lines, 0 = none
+  uint8_t _gridColumns;   ///< Samples between vertical grid lines, 0 = none
+  uint16_t _gridPhase;    ///< Samples since the last vertical grid line
+  float _lo;              ///< Value at the bottom row
+  float _hi;              ///< Value at the top row
+  uint16_t _colors[ILI9341_STRIPCHART_SERIES]; ///< Trace colours
+  int16_t _last[ILI9341_STRIPCHART_SERIES];    ///< Previous row, -1 if none
+};
+
+#endif // _ILI9341_STRIPCHART_H_
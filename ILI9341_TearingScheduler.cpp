@@ -0,0 +1,265 @@
+/*!
+ * @file ILI9341_TearingScheduler.cpp
+ *
+ * Tear-free rectangle updates for Adafruit_ILI9341, synchronised to the
+ * panel refresh through the TE pin or a frame-rate model.
+ *
+ * BSD license, all text here must be included in any redistribution.
+ *
+ */
+
+#include "ILI9341_TearingScheduler.h"
+
+#define ILI9341_TE_GUARD_LINES 2 ///< Slack for error in the scan estimate
+
+/**************************************************************************/
+/*!
+    @brief  Create a scheduler for a panel.
+    @param  tft    Display to update.
+    @param  tePin  Arduino pin wired to the panel's TE output, or -1 to rely
+                   on the frame-rate model alone.
+*/
+/**************************************************************************/
+ILI9341_TearingScheduler::ILI9341_TearingScheduler(Adafruit_ILI9341 &tft,
+                                                   int8_t tePin)
+    : _tft(tft), _now(micros), _origin(0), _nsPerPixel(0), _waited(0),
+      _tePin(tePin), _bandLines(32) {}
+
+/**************************************************************************/
+/*!
+    @brief  Enable the panel's TE output (if a TE pin was given) and lock
+            onto the refresh. Call after the panel's begin().
+*/
+/**************************************************************************/
+void ILI9341_TearingScheduler::begin(void) {
+  _origin = _now();
+  if (_tePin >= 0) {
+    pinMode(_tePin, INPUT);
+    _tft.setTearingEffect(true);
+    waitVSync();
+  }
+}
+
+/**************************************************************************/
+/*!
+    @brief  Replace the microsecond clock used to track the scan position
+            (micros() by default).
+    @param  fn  Clock function.
+*/
+/**************************************************************************/
+void ILI9341_TearingScheduler::setTimeSource(ILI9341_TimeSource fn) {
+  if (fn)
+    _now = fn;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Set how many gate lines are scheduled as one unit. Smaller
+            bands track the scan more closely but cost more address-window
+            setup.
+    @param  lines  Gate lines per band, at least 1 (default 32).
+*/
+/**************************************************************************/
+void ILI9341_TearingScheduler::setBandLines(uint8_t lines) {
+  _bandLines = lines ? lines : 1;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Wait for the start of vertical blanking. With a TE pin this is
+            the rising edge of TE, and the scan model is re-locked to it;
+            otherwise it is the model's prediction.
+    @return true if a TE edge was seen, false if the model was used (no TE
+            pin, or no edge within two frame periods).
+*/
+/**************************************************************************/
+bool ILI9341_TearingScheduler::waitVSync(void) {
+  if (_tePin >= 0) {
+    uint32_t timeout = _tft.framePeriodMicros() * 2, start = _now();
+    bool timedOut = false;
+    while (!timedOut && digitalRead(_tePin)) { // Let a V-blank in progress end
+      yield();
+      timedOut = (_now() - start) > timeout;
+    }
+    while (!timedOut && !digitalRead(_tePin)) {
+      yield();
+      timedOut = (_now() - start) > timeout;
+    }
+    if (!timedOut) {
+      _origin = _now();
+      return true;
+    }
+  }
+  uint16_t s = scanLine();
+  waitLines((ILI9341_TFTHEIGHT - s + ILI9341_FRAME_LINES) %
+            ILI9341_FRAME_LINES);
+  return false;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Estimate the gate line being refreshed right now.
+    @return 0 to ILI9341_TFTHEIGHT - 1 while scanning, higher values during
+            vertical blanking.
+*/
+/**************************************************************************/
+uint16_t ILI9341_TearingScheduler::scanLine(void) const {
+  uint32_t period = _tft.framePeriodMicros();
+  uint32_t t = (_now() - _origin) % period;
+  return (ILI9341_TFTHEIGHT + t * ILI9341_FRAME_LINES / period) %
+         ILI9341_FRAME_LINES;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Write a frame update. Rectangles are sent band by band in scan
+            order; within a band they are sent in array order, so later
+            rectangles still win where they overlap earlier ones.
+    @param  rects  Rectangles to write.
+    @param  count  Number of rectangles.
+    @return Number of pixels sent.
+*/
+/**************************************************************************/
+uint32_t ILI9341_TearingScheduler::submit(const ILI9341_Rect *rects,
+                                          uint8_t count) {
+  _waited = 0;
+  if (!count)
+    return 0;
+  if (_tePin >= 0)
+    waitVSync();
+
+  uint32_t sent = 0;
+  int16_t x, y, w, h;
+  for (int16_t b = 0; b < ILI9341_TFTHEIGHT; b += _bandLines) {
+    int16_t bEnd = min(b + _bandLines - 1, ILI9341_TFTHEIGHT - 1);
+    int16_t lo = ILI9341_TFTHEIGHT, hi = -1, r0, r1;
+    uint32_t pixels = 0;
+    for (uint8_t i = 0; i < count; i++) {
+      if (nativeRows(rects[i], r0, r1) && (r0 <= bEnd) && (r1 >= b)) {
+        lo = min(lo, max(r0, b));
+        hi = max(hi, min(r1, bEnd));
+        clipToRows(rects[i], b, bEnd, x, y, w, h);
+        pixels += (uint32_t)w * h;
+      }
+    }
+    if (hi < 0)
+      continue;
+
+    // Each band has its own transaction so the bus is free for others
+    // while waiting for the scan
+    waitForRows(lo, hi, pixels);
+    uint32_t t0 = _now();
+    _tft.startWrite();
+    for (uint8_t i = 0; i < count; i++) {
+      const ILI9341_Rect &r = rects[i];
+      if (!clipToRows(r, b, bEnd, x, y, w, h))
+        continue;
+      _tft.setAddrWindow(x, y, w, h);
+      const uint16_t *src = r.pixels + (int32_t)(y - r.y) * r.w + (x - r.x);
+      for (int16_t row = 0; row < h; row++, src += r.w) {
+        _tft.dmaWait();
+        _tft.writePixels((uint16_t *)src, w, false);
+      }
+    }
+    _tft.dmaWait();
+    _tft.endWrite();
+    uint32_t ns = (_now() - t0) * 1000UL / pixels;
+    _nsPerPixel = _nsPerPixel ? (_nsPerPixel * 3 + ns) / 4 : ns;
+    sent += pixels;
+  }
+  return sent;
+}
+
+// Clip a rectangle to the screen and to gate lines [n0, n1]. Gate lines
+// run down the screen in rotation 0, so in the other rotations they map to
+// columns (1, 3) and/or count from the opposite edge (2, 3).
+bool ILI9341_TearingScheduler::clipToRows(const ILI9341_Rect &r, int16_t n0,
+                                          int16_t n1, int16_t &x, int16_t &y,
+                                          int16_t &w, int16_t &h) const {
+  int16_t x1 = min(r.x + r.w, _tft.width()), y1 = min(r.y + r.h, _tft.height());
+  x = max(r.x, 0);
+  y = max(r.y, 0);
+  const int16_t last = ILI9341_TFTHEIGHT - 1;
+  switch (_tft.getRotation()) {
+  case 0:
+    y = max(y, n0);
+    y1 = min(y1, n1 + 1);
+    break;
+  case 1:
+    x = max(x, n0);
+    x1 = min(x1, n1 + 1);
+    break;
+  case 2:
+    y = max(y, last - n1);
+    y1 = min(y1, last - n0 + 1);
+    break;
+  case 3:
+    x = max(x, last - n1);
+    x1 = min(x1, last - n0 + 1);
+    break;
+  }
+  w = x1 - x;
+  h = y1 - y;
+  return (w > 0) && (h > 0) && r.pixels;
+}
+
+// Range of gate lines [r0, r1] a rectangle covers on screen.
+bool ILI9341_TearingScheduler::nativeRows(const ILI9341_Rect &r, int16_t &r0,
+                                          int16_t &r1) const {
+  int16_t x, y, w, h;
+  if (!clipToRows(r, 0, ILI9341_TFTHEIGHT - 1, x, y, w, h))
+    return false;
+  const int16_t last = ILI9341_TFTHEIGHT - 1;
+  switch (_tft.getRotation()) {
+  case 0:
+    r0 = y;
+    r1 = y + h - 1;
+    break;
+  case 1:
+    r0 = x;
+    r1 = x + w - 1;
+    break;
+  case 2:
+    r0 = last - (y + h - 1);
+    r1 = last - y;
+    break;
+  default:
+    r0 = last - (x + w - 1);
+    r1 = last - x;
+    break;
+  }
+  return true;
+}
+
+// Rounded up, so the scan has really reached the line waited for
+void ILI9341_TearingScheduler::waitLines(uint16_t lines) {
+  uint32_t us = ((uint32_t)lines * _tft.framePeriodMicros() +
+                 ILI9341_FRAME_LINES - 1) /
+                ILI9341_FRAME_LINES;
+  _waited += us;
+  while (us > 10000) { // delayMicroseconds() is only exact up to ~16 ms
+    delay(10);
+    us -= 10000;
+  }
+  delayMicroseconds(us);
+}
+
+// Hold off until writing gate lines [r0, r1] cannot meet the scan. The scan
+// must be clear of the band by a few guard lines, which absorb error in the
+// scan and write-time estimates, and must not come round to it again before
+// a write of this many pixels is expected to finish. Until a write has been
+// timed, the band waits for the scan to pass it so that a whole frame is
+// available. A band too slow to write within one refresh will tear
+// regardless and is sent straight away.
+void ILI9341_TearingScheduler::waitForRows(int16_t r0, int16_t r1,
+                                           uint32_t pixels) {
+  const uint16_t lines = ILI9341_FRAME_LINES;
+  const uint16_t clear = r1 - r0 + 1 + ILI9341_TE_GUARD_LINES;
+  uint16_t past = (scanLine() + lines - r0) % lines; // Scan lines past r0
+  uint32_t period = _tft.framePeriodMicros();
+  uint32_t est = (pixels * _nsPerPixel / 1000 * lines + period - 1) / period +
+                 ILI9341_TE_GUARD_LINES;
+  if ((past < clear) || !_nsPerPixel ||
+      ((est >= (uint32_t)(lines - past)) && (est < (uint32_t)(lines - clear))))
+    waitLines((clear - past + lines) % lines);
+}
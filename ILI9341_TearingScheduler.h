@@ -0,0 +1,82 @@
+/*!
+ * @file ILI9341_TearingScheduler.h
+ *
+ * Tear-free rectangle updates for Adafruit_ILI9341, synchronised to the
+ * panel refresh through the TE pin or a frame-rate model.
+ *
+ * BSD license, all text here must be included in any redistribution.
+ *
+ */
+
+#ifndef _ILI9341_TEARINGSCHEDULER_H_
+#define _ILI9341_TEARINGSCHEDULER_H_
+
+#include "Adafruit_ILI9341.h"
+
+/*!
+  @brief  One rectangle of a frame update: w * h RGB565 pixels, row-major,
+          in the panel's current rotation.
+*/
+typedef struct {
+  int16_t x;              ///< Left edge
+  int16_t y;              ///< Top edge
+  int16_t w;              ///< Width in pixels
+  int16_t h;              ///< Height in pixels
+  const uint16_t *pixels; ///< w * h pixels in native byte order
+} ILI9341_Rect;
+
+/*!
+  @brief  Clock used for scan-line estimates.
+  @return Free-running microsecond count (wrapping like micros()).
+*/
+typedef uint32_t (*ILI9341_TimeSource)(void);
+
+/**************************************************************************/
+/*!
+@brief  Writes a frame's worth of rectangles so that the panel never scans
+        out a band while it is being written. Rectangles are cut into bands
+        of panel gate lines and sent in scan order; each band is started
+        only when the predicted scan position, give or take a couple of
+        lines, leaves it alone for as long as the write is expected to take
+        (write time is measured as it goes).
+
+        With a TE pin the scan phase is re-locked at every submit(); without
+        one it is extrapolated from begin() using the panel's cached frame
+        rate, which only keeps pace with the refresh and cannot know its
+        true phase. Both assume vertical scrolling is not in use.
+*/
+/**************************************************************************/
+class ILI9341_TearingScheduler {
+public:
+  ILI9341_TearingScheduler(Adafruit_ILI9341 &tft, int8_t tePin = -1);
+
+  void begin(void);
+  void setTimeSource(ILI9341_TimeSource fn);
+  void setBandLines(uint8_t lines);
+  bool waitVSync(void);
+  uint16_t scanLine(void) const;
+  uint32_t submit(const ILI9341_Rect *rects, uint8_t count);
+
+  /*!
+    @brief  Time spent waiting for the scan in the last submit().
+    @return Microseconds.
+  */
+  uint32_t lastWaitMicros(void) const { return _waited; }
+
+private:
+  bool nativeRows(const ILI9341_Rect &r, int16_t &r0, int16_t &r1) const;
+  bool clipToRows(const ILI9341_Rect &r, int16_t n0, int16_t n1, int16_t &x,
+                  int16_t &y, int16_t &w, int16_t &h) const;
+  void waitLines(uint16_t lines);
+  void waitForRows(int16_t r0, int16_t r1, uint32_t pixels);
+
+  Adafruit_ILI9341 &_tft;   ///< Panel being updated
+  ILI9341_TimeSource _now;  ///< Microsecond clock
+  uint32_t _origin;         ///< Time at which the scan entered V-blank
+  uint32_t _nsPerPixel;     ///< Measured write cost, 0 until known
+  uint32_t _waited;         ///< Wait time in the last submit()
+  int8_t _tePin;            ///< TE input, or -1 for the model only
+  uint8_t _bandLines;       ///< Gate lines per scheduled band
+};
+
+#endif // _ILI9341_TEARINGSCHEDULER_H_
@@ -0,0 +1,262 @@
+/*!
+ * @file ILI9341_TileMap.cpp
+ *
+ * Scanline tile-map renderer for Adafruit_ILI9341, using the controller's
+ * hardware scroll where possible.
+ *
+ * BSD license, all text here must be included in any redistribution.
+ *
+ */
+
+#include "ILI9341_TileMap.h"
+
+#define GATE_LINES ILI9341_TFTHEIGHT ///< Lines in the hardware scroll area
+
+/*!
+  @brief  Non-negative remainder.
+  @param  v  Value.
+  @param  m  Modulus, greater than zero.
+  @return v mod m in [0, m).
+*/
+static inline int32_t wrap(int32_t v, int32_t m) {
+  v %= m;
+  return (v < 0) ? v + m : v;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Create a tile map. Nothing is allocated until begin().
+    @param  tft  Display to draw on.
+*/
+/**************************************************************************/
+ILI9341_TileMap::ILI9341_TileMap(Adafruit_ILI9341 &tft)
+    : _tft(tft), _streamer(tft), _tiles(NULL), _bitmap(NULL),
+      _palette(NULL), _map(NULL), _mapW(0), _mapH(0), _tileSize(0),
+      _shift(0), _bpp(0), _hardware(true), _valid(false), _drawnRot(0),
+      _x(0), _y(0), _drawnX(0), _drawnY(0), _alongX(false), _gate(0),
+      _across(0), _origin(0), _lineX(0) {}
+
+/**************************************************************************/
+/*!
+    @brief  Allocate the line buffers.
+    @param  hardwareScroll  Scroll along the gate axis with VSCRSADD. When
+                            false every scroll redraws the whole screen and
+                            the panel's scroll registers are left alone, so
+                            its start line should be 0.
+    @return true on success, false if there is not enough RAM.
+*/
+/**************************************************************************/
+bool ILI9341_TileMap::begin(bool hardwareScroll) {
+  _hardware = hardwareScroll;
+  _valid = false;
+  return _streamer.begin(ILI9341_TFTHEIGHT);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Use RGB565 tiles.
+    @param  tiles     tileSize * tileSize pixels per tile, row by row, tile
+                      after tile (PROGMEM on AVR).
+    @param  tileSize  Tile width and height: a power of two, usually 8 or
+                      16.
+*/
+/**************************************************************************/
+void ILI9341_TileMap::setTiles(const uint16_t tiles[], uint8_t tileSize) {
+  _tiles = tiles;
+  _bitmap = NULL;
+  _tileSize = tileSize;
+  for (_shift = 0; (1 << _shift) < tileSize; _shift++)
+    ;
+  _valid = false;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Use packed indexed tiles, each stored as for
+            drawIndexedBitmap(), tile after tile.
+    @param  tiles     Packed pixels (PROGMEM on AVR).
+    @param  bpp       Bits per pixel: 1, 2, 4 or 8.
+    @param  tileSize  Tile width and height: a power of two, usually 8 or
+                      16.
+    @param  palette   RGB565 colour for each index, in RAM. Changes show
+                      after invalidate() and update().
+*/
+/**************************************************************************/
+void ILI9341_TileMap::setTiles(const uint8_t tiles[], uint8_t bpp,
+                               uint8_t tileSize, const uint16_t *palette) {
+  setTiles((const uint16_t *)NULL, tileSize);
+  _bitmap = tiles;
+  _bpp = bpp;
+  _palette = palette;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Set the map. It repeats in both directions beyond its edges.
+    @param  map  w * h tile numbers, row by row, in RAM. Not copied; call
+                 invalidate() after changing it.
+    @param  w    Width in tiles.
+    @param  h    Height in tiles.
+*/
+/**************************************************************************/
+void ILI9341_TileMap::setMap(const uint8_t *map, uint16_t w, uint16_t h) {
+  _map = map;
+  _mapW = w;
+  _mapH = h;
+  _valid = false;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Scroll at the next update().
+    @param  x  Map pixel to show at the screen's left edge.
+    @param  y  Map pixel to show at the screen's top edge.
+*/
+/**************************************************************************/
+void ILI9341_TileMap::scrollTo(int32_t x, int32_t y) {
+  _x = x;
+  _y = y;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Redraw the whole screen at the next update().
+*/
+/**************************************************************************/
+void ILI9341_TileMap::invalidate(void) { _valid = false; }
+
+/**************************************************************************/
+/*!
+    @brief  Bring the screen up to date with the scroll position.
+    @return Number of pixels sent.
+*/
+/**************************************************************************/
+uint32_t ILI9341_TileMap::update(void) {
+  if (!_map || !_mapW || !_mapH || !_tileSize || (!_tiles && !_bitmap))
+    return 0;
+  uint8_t rot = _tft.getRotation();
+  if (_valid && (rot == _drawnRot) && (_x == _drawnX) && (_y == _drawnY))
+    return 0;
+
+  _alongX = rot & 1;
+  int32_t before = _alongX ? _drawnX : _drawnY;
+  _gate = _alongX ? _x : _y;
+  _across = _alongX ? _y : _x;
+  int32_t step = _gate - before;
+  bool partial = _valid && _hardware && (rot == _drawnRot) &&
+                 (_across == (_alongX ? _drawnY : _drawnX)) &&
+                 (step > -GATE_LINES) && (step < GATE_LINES);
+  _origin = _hardware ? wrap(_gate, GATE_LINES) : 0;
+
+  uint32_t sent;
+  if (!partial) {
+    if (_hardware)
+      _tft.setScrollMargins(0, 0);
+    sent = fill(0, GATE_LINES);
+  } else if (step > 0) { // Lines after the old last one came into view
+    sent = fill(wrap(before, GATE_LINES), step);
+  } else { // Lines before the old first one
+    sent = fill(_origin, -step);
+  }
+  if (_hardware) // Gate rows run backwards in rotations 2 and 3
+    _tft.scrollTo((rot < 2) ? _origin
+                            : (GATE_LINES - _origin) % GATE_LINES);
+
+  _drawnX = _x;
+  _drawnY = _y;
+  _drawnRot = rot;
+  _valid = true;
+  return sent;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Render memory lines along the gate axis, wrapping at the end.
+    @param  from   First memory line.
+    @param  count  Number of lines.
+    @return Number of pixels sent.
+*/
+/**************************************************************************/
+uint32_t ILI9341_TileMap::fill(int16_t from, int16_t count) {
+  uint32_t sent = 0;
+  while (count > 0) {
+    int16_t n = min((int)count, GATE_LINES - from);
+    if (_alongX) {
+      _lineX = from;
+      sent += _streamer.stream(from, 0, n, ILI9341_TFTWIDTH, renderLine, this);
+    } else {
+      _lineX = 0;
+      sent += _streamer.stream(0, from, ILI9341_TFTWIDTH, n, renderLine, this);
+    }
+    count -= n;
+    from = 0;
+  }
+  return sent;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Copy a horizontal run of map pixels, wrapping around the map.
+    @param  dst    Destination pixels.
+    @param  mx     Map x of the first pixel.
+    @param  my     Map y.
+    @param  count  Number of pixels.
+*/
+/**************************************************************************/
+void ILI9341_TileMap::renderSpan(uint16_t *dst, int32_t mx, int32_t my,
+                                 uint16_t count) const {
+  mx = wrap(mx, (int32_t)_mapW << _shift);
+  my = wrap(my, (int32_t)_mapH << _shift);
+  const uint8_t mask = _tileSize - 1, row = my & mask;
+  const uint8_t *cell = _map + (uint32_t)(my >> _shift) * _mapW;
+  const uint16_t stride = Adafruit_ILI9341::indexedStride(_tileSize, _bpp);
+  uint16_t tx = mx >> _shift;
+  uint8_t col = mx & mask;
+  while (count) {
+    uint8_t n = min(count, (uint16_t)(_tileSize - col));
+    uint32_t line = (uint32_t)cell[tx] * _tileSize + row;
+    if (_tiles) {
+      const uint16_t *src = _tiles + (line << _shift) + col;
+      for (uint8_t i = 0; i < n; i++)
+        dst[i] = pgm_read_word(&src[i]);
+    } else {
+      Adafruit_ILI9341::expandIndexed(dst, _bitmap + line * stride, _bpp, col,
+                                      n, _palette);
+    }
+    dst += n;
+    count -= n;
+    col = 0;
+    if (++tx >= _mapW)
+      tx = 0;
+  }
+}
+
+/**************************************************************************/
+/*!
+    @brief  LineStreamer callback: one screen row of the strip being sent.
+    @param  line  Buffer to fill.
+    @param  y     Screen row.
+    @param  w     Strip width.
+    @param  arg   The tile map.
+*/
+/**************************************************************************/
+void ILI9341_TileMap::renderLine(uint16_t *line, int16_t y, uint16_t w,
+                                 void *arg) {
+  ILI9341_TileMap *m = (ILI9341_TileMap *)arg;
+  if (!m->_alongX) { // Rows are memory lines
+    m->renderSpan(line, m->_across + m->_lineX,
+                  m->_gate + wrap(y - m->_origin, GATE_LINES), w);
+    return;
+  }
+  // Columns are memory lines: the row is contiguous in the map except
+  // where memory wraps back to line 0
+  int16_t x = m->_lineX;
+  while (w) {
+    int16_t offset = wrap(x - m->_origin, GATE_LINES);
+    uint16_t n = min(w, (uint16_t)(GATE_LINES - offset));
+    m->renderSpan(line, m->_gate + offset, m->_across + y, n);
+    line += n;
+    x += n;
+    w -= n;
+  }
+}
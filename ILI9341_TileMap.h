@@ -0,0 +1,87 @@
+/*!
+ * @file ILI9341_TileMap.h
+ *
+ * Scanline tile-map renderer for Adafruit_ILI9341, using the controller's
+ * hardware scroll where possible.
+ *
+ * BSD license, all text here must be included in any redistribution.
+ *
+ */
+
+#ifndef _ILI9341_TILEMAP_H_
+#define _ILI9341_TILEMAP_H_
+
+#include "ILI9341_LineStreamer.h"
+
+/**************************************************************************/
+/*!
+@brief  Draws a scrolling map of square tiles over the whole screen without
+        a frame buffer. Each line is composed straight from the tile data
+        into a line buffer (O(width) per line) and streamed out with
+        ILI9341_LineStreamer.
+
+        The panel's gate lines run along y in rotations 0/2 and along x in
+        rotations 1/3. Scrolling along that axis only moves the VSCRSADD
+        start line and renders the lines that came into view; scrolling
+        across it, or by a screen or more, redraws everything. The map
+        wraps around at its edges, so it can be scrolled for ever.
+
+        With hardware scroll on, the whole screen is one scroll area and
+        the panel's start line is changed, so other drawing on the panel
+        lands in scrolled memory positions. Call tft.scrollTo(0) and
+        redraw to leave the map.
+*/
+/**************************************************************************/
+class ILI9341_TileMap {
+public:
+  ILI9341_TileMap(Adafruit_ILI9341 &tft);
+
+  bool begin(bool hardwareScroll = true);
+  void setTiles(const uint16_t tiles[], uint8_t tileSize);
+  void setTiles(const uint8_t tiles[], uint8_t bpp, uint8_t tileSize,
+                const uint16_t *palette);
+  void setMap(const uint8_t *map, uint16_t w, uint16_t h);
+  void scrollTo(int32_t x, int32_t y);
+  /*!
+    @brief  Map pixel at the screen's left edge.
+    @return Horizontal scroll position.
+  */
+  int32_t scrollX(void) const { return _x; }
+  /*!
+    @brief  Map pixel at the screen's top edge.
+    @return Vertical scroll position.
+  */
+  int32_t scrollY(void) const { return _y; }
+  void invalidate(void);
+  uint32_t update(void);
+
+private:
+  uint32_t fill(int16_t from, int16_t count);
+  void renderSpan(uint16_t *dst, int32_t mx, int32_t my, uint16_t count) const;
+  static void renderLine(uint16_t *line, int16_t y, uint16_t w, void *arg);
+
+  Adafruit_ILI9341 &_tft;         ///< Panel being drawn
+  ILI9341_LineStreamer _streamer; ///< Line output
+  const uint16_t *_tiles;         ///< RGB565 tiles (PROGMEM on AVR)
+  const uint8_t *_bitmap;         ///< Packed indexed tiles (PROGMEM on AVR)
+  const uint16_t *_palette;       ///< Colours for _bitmap
+  const uint8_t *_map;            ///< Tile numbers, row by row
+  uint16_t _mapW;                 ///< Map width in tiles
+  uint16_t _mapH;                 ///< Map height in tiles
+  uint8_t _tileSize;              ///< Tile width and height in pixels
+  uint8_t _shift;                 ///< log2(_tileSize)
+  uint8_t _bpp;                   ///< Bits per pixel of _bitmap
+  bool _hardware;                 ///< Use VSCRSADD for gate-axis scrolling
+  bool _valid;                    ///< Screen shows _drawnX, _drawnY
+  uint8_t _drawnRot;              ///< Rotation the screen was drawn in
+  int32_t _x, _y;                 ///< Wanted scroll position
+  int32_t _drawnX, _drawnY;       ///< Scroll position on screen
+  // Mapping used while rendering
+  bool _alongX;    ///< Gate axis is screen x
+  int32_t _gate;   ///< Scroll position along the gate axis
+  int32_t _across; ///< Scroll position across it
+  int16_t _origin; ///< Memory line holding map line _gate
+  int16_t _lineX;  ///< Left edge of the strip being streamed
+};
+
+#endif // _ILI9341_TILEMAP_H_
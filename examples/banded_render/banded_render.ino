@@ -0,0 +1,56 @@
+// ILI9341 banded renderer example: a full-screen scene composed without a
+// framebuffer. The draw callback is replayed for each 240x40 band, so the
+// whole frame needs only 19 KB of RAM (38 KB double-buffered) and never
+// shows half-drawn objects.
+
+#include "SPI.h"
+#include "Adafruit_GFX.h"
+#include "Adafruit_ILI9341.h"
+#include "ILI9341_BandRenderer.h"
+
+// For the Adafruit shield, these are the default.
+#define TFT_DC 9
+#define TFT_CS 10
+
+Adafruit_ILI9341 tft = Adafruit_ILI9341(TFT_CS, TFT_DC);
+ILI9341_BandRenderer bands(tft, 40, true);
+
+float angle = 0.0;
+
+void drawScene(Adafruit_GFX &gfx, void *arg) {
+  ILI9341_BandRenderer &band = (ILI9341_BandRenderer &)gfx;
+  float a = *(float *)arg;
+  int16_t cx = gfx.width() / 2, cy = gfx.height() / 2;
+
+  // Objects entirely outside the band can be skipped cheaply
+  for (int16_t y = 0; y < gfx.height(); y += 20) {
+    if (band.inBand(y, 1))
+      gfx.drawFastHLine(0, y, gfx.width(), ILI9341_DARKGREY);
+  }
+  for (int8_t i = 0; i < 6; i++) {
+    float t = a + i * 1.047;
+    int16_t x = cx + cos(t) * 80, y = cy + sin(t) * 80;
+    if (band.inBand(y - 20, 41))
+      gfx.fillCircle(x, y, 20, (i & 1) ? ILI9341_RED : ILI9341_YELLOW);
+  }
+  gfx.drawLine(cx, cy, cx + cos(a) * 100, cy + sin(a) * 100, ILI9341_WHITE);
+}
+
+void setup() {
+  Serial.begin(9600);
+  tft.begin();
+  if (!bands.begin()) {
+    Serial.println(F("Not enough RAM for the band buffers"));
+    while (1) yield();
+  }
+  bands.setClearColor(ILI9341_NAVY);
+}
+
+void loop() {
+  uint32_t t = micros();
+  bands.render(drawScene, &angle);
+  t = micros() - t;
+  angle += 0.05;
+  Serial.print(1000000.0 / t, 1);
+  Serial.println(F(" fps"));
+}
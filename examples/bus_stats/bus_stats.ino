@@ -0,0 +1,86 @@
+// ILI9341 bus statistics example: draws a typical screen and prints how
+// many commands, address windows, pixel bytes and transactions each kind
+// of drawing call cost.
+//
+// The counters are compiled out unless the whole build (library included)
+// sees ILI9341_ENABLE_STATS=1. Defining it in the sketch is not enough;
+// add it to the compiler flags, e.g. in platformio.ini:
+//   build_flags = -DILI9341_ENABLE_STATS=1
+// or with arduino-cli:
+//   --build-property "build.extra_flags=-DILI9341_ENABLE_STATS=1"
+
+#include "SPI.h"
+#include "Adafruit_GFX.h"
+#include "Adafruit_ILI9341.h"
+
+// For the Adafruit shield, these are the default.
+#define TFT_DC 9
+#define TFT_CS 10
+
+Adafruit_ILI9341 tft = Adafruit_ILI9341(TFT_CS, TFT_DC);
+
+void drawScreen(void) {
+  tft.fillScreen(ILI9341_BLACK);
+  tft.fillRect(0, 0, tft.width(), 24, ILI9341_NAVY);
+  tft.setCursor(4, 4);
+  tft.setTextColor(ILI9341_WHITE);
+  tft.setTextSize(2);
+  tft.print(F("Status: OK"));
+  for (int16_t i = 0; i < 10; i++)
+    tft.drawLine(0, 40 + i * 8, tft.width() - 1, 120 - i * 8, ILI9341_GREEN);
+  tft.drawCircle(tft.width() / 2, 200, 50, ILI9341_YELLOW);
+  tft.fillRoundRect(20, 270, 200, 40, 8, ILI9341_DARKGREEN);
+}
+
+#if ILI9341_ENABLE_STATS
+void printStats(const ILI9341_BusStats &s) {
+  Serial.print('\t');
+  Serial.print(s.calls);
+  Serial.print('\t');
+  Serial.print(s.commands);
+  Serial.print('\t');
+  Serial.print(s.windows);
+  Serial.print('/');
+  Serial.print(s.windowsCached);
+  Serial.print('\t');
+  Serial.print(s.pixelBytes);
+  Serial.print('\t');
+  Serial.print(s.dataBytes);
+  Serial.print('\t');
+  Serial.print(s.transactions);
+  Serial.print('\t');
+  Serial.println(s.dmaWaitMicros);
+}
+#endif
+
+void setup() {
+  Serial.begin(9600);
+  tft.begin();
+
+#if ILI9341_ENABLE_STATS
+  tft.resetStats();
+  uint32_t t = micros();
+  drawScreen();
+  t = micros() - t;
+
+  ILI9341_Stats stats;
+  tft.getStats(stats);
+  Serial.println(F("api\tcalls\tcmds\twin/cached\tpixel\tparam\ttx\tdma us"));
+  for (uint8_t a = 0; a < ILI9341_API_COUNT; a++) {
+    if (!stats.api[a].calls && !stats.api[a].transactions)
+      continue;
+    Serial.print(Adafruit_ILI9341::statsApiName(a));
+    printStats(stats.api[a]);
+  }
+  Serial.print(F("total"));
+  printStats(stats.total);
+  Serial.print(F("Drawing took "));
+  Serial.print(t);
+  Serial.println(F(" us"));
+#else
+  drawScreen();
+  Serial.println(F("Build with -DILI9341_ENABLE_STATS=1 to get statistics."));
+#endif
+}
+
+void loop(void) {}
@@ -0,0 +1,59 @@
+// ILI9341 compressed bitmap example: draws the pictureEmbed dragon from
+// raw RGB565 and from the palette + RLE format, and prints flash size and
+// drawing time for each. dragon_rle.h was made with:
+//   extras/rle_encode/rle_encode dragon.h dragonRLE > dragon_rle.h
+// WILL NOT FIT ON ARDUINO UNO OR OTHER AVR BOARDS (the raw copy is 15 KB).
+
+#include "SPI.h"
+#include "Adafruit_GFX.h"
+#include "Adafruit_ILI9341.h"
+#include "dragon.h"
+#include "dragon_rle.h"
+
+// For the Adafruit shield, these are the default.
+#define TFT_DC 9
+#define TFT_CS 10
+
+#define DRAWS 20
+
+Adafruit_ILI9341 tft = Adafruit_ILI9341(TFT_CS, TFT_DC);
+
+uint32_t timeDraws(bool compressed) {
+  tft.fillScreen(ILI9341_BLACK);
+  uint32_t t = micros();
+  for (uint8_t i = 0; i < DRAWS; i++) {
+    int16_t x = random(-DRAGON_WIDTH / 2, tft.width() - DRAGON_WIDTH / 2);
+    int16_t y = random(-DRAGON_HEIGHT / 2, tft.height() - DRAGON_HEIGHT / 2);
+    if (compressed)
+      tft.drawCompressedBitmap(x, y, dragonRLE);
+    else
+      tft.drawRGBBitmap(x, y, dragonBitmap, DRAGON_WIDTH, DRAGON_HEIGHT);
+  }
+  return (micros() - t) / DRAWS;
+}
+
+void setup() {
+  Serial.begin(9600);
+  tft.begin();
+
+  Serial.print(F("Raw RGB565: "));
+  Serial.print(sizeof(dragonBitmap));
+  Serial.println(F(" bytes of flash"));
+  Serial.print(F("Palette + RLE: "));
+  Serial.print(sizeof(dragonRLE));
+  Serial.println(F(" bytes of flash"));
+}
+
+void loop() {
+  randomSeed(1);
+  uint32_t raw = timeDraws(false);
+  randomSeed(1); // Same positions for a fair comparison
+  uint32_t rle = timeDraws(true);
+
+  Serial.print(F("Average draw: raw "));
+  Serial.print(raw);
+  Serial.print(F(" us, compressed "));
+  Serial.print(rle);
+  Serial.println(F(" us"));
+  delay(1000);
+}
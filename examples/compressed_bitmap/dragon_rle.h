@@ -0,0 +1,325 @@
+// Generated by extras/rle_encode from dragon.h:
+// 110x70, 119 colours, 15400 bytes raw RGB565, 3830 bytes compressed.
+// Draw with tft.drawCompressedBitmap(x, y, dragonRLE).
+
+const PROGMEM uint8_t dragonRLE[3830] = {
+    0x52, 0x4C, 0x00, 0x6E, 0x00, 0x46, 0x77, 0xFF, 0xFF, 0x8C, 0x10, 0xBD,
+    0x14, 0xAC, 0x92, 0xDE, 0xFB, 0xB4, 0x31, 0xA1, 0xC9, 0xAA, 0x4B, 0xCE,
+    0x18, 0x9A, 0x2A, 0x90, 0x44, 0xEF, 0x7D, 0xB3, 0xB0, 0xA1, 0x48, 0xB8,
+    0x65, 0xC0, 0x66, 0xAB, 0x2E, 0x98, 0x64, 0xA8, 0x65, 0xAA, 0xAC, 0x72,
+    0x8B, 0xA3, 0xAF, 0xA4, 0x11, 0xA8, 0xE6, 0xD0, 0x86, 0x70, 0x43, 0xCE,
+    0x79, 0xB4, 0x93, 0x83, 0x0D, 0x80, 0xC5, 0xB8, 0xE7, 0xDE, 0x9A, 0xBD,
+    0xF7, 0xAD, 0x14, 0x71, 0xA8, 0xC5, 0x15, 0xB1, 0x48, 0xB1, 0xCA, 0x93,
+    0x2D, 0x78, 0xC5, 0xA0, 0xC6, 0x42, 0x08, 0x21, 0x04, 0x89, 0x47, 0x89,
+    0xA8, 0x7B, 0x8E, 0xBD, 0x96, 0x80, 0x44, 0xA3, 0x2E, 0x91, 0x47, 0x82,
+    0x2A, 0xCD, 0x96, 0x9C, 0x92, 0x58, 0x22, 0x5A, 0x08, 0x82, 0xAB, 0x92,
+    0xAC, 0x9C, 0xF3, 0x48, 0x22, 0x39, 0x86, 0x90, 0xC6, 0x99, 0xC9, 0x68,
+    0x43, 0x7B, 0x0C, 0x9A, 0xAC, 0x79, 0x26, 0x8A, 0x2A, 0x8B, 0x8E, 0x69,
+    0x26, 0x84, 0x10, 0x8C, 0x71, 0x05, 0x47, 0x04, 0xA6, 0x31, 0xC3, 0x23,
+    0x05, 0x81, 0x45, 0x0C, 0x66, 0x05, 0x06, 0x91, 0x05, 0x80, 0xE5, 0x59,
+    0xE5, 0x1B, 0x65, 0x69, 0x85, 0x0C, 0x05, 0x1A, 0xC4, 0x04, 0x05, 0x42,
+    0x85, 0x0B, 0xA5, 0x32, 0x64, 0x98, 0xA5, 0x71, 0x45, 0x1B, 0xC5, 0x49,
+    0x84, 0x80, 0xA4, 0x04, 0x45, 0x4A, 0x25, 0xA8, 0xC5, 0x32, 0xC5, 0x69,
+    0x44, 0x90, 0xA4, 0x58, 0xE3, 0x1A, 0x63, 0x41, 0x83, 0x59, 0x24, 0x42,
+    0x24, 0x22, 0xC4, 0x0B, 0x64, 0x70, 0xE4, 0x68, 0xE4, 0x23, 0x65, 0x70,
+    0xA4, 0x32, 0x24, 0x1B, 0x04, 0x68, 0x83, 0x49, 0xC4, 0x58, 0x83, 0x59,
+    0x84, 0x22, 0x64, 0x1A, 0x03, 0xFF, 0x00, 0xFF, 0x00, 0xF4, 0x00, 0x00,
+    0x01, 0x9B, 0x00, 0x01, 0x02, 0x03, 0xCB, 0x00, 0x03, 0x04, 0x05, 0x06,
+    0x07, 0x99, 0x00, 0x03, 0x08, 0x09, 0x0A, 0x04, 0x8F, 0x00, 0x00, 0x0B,
+    0xB7, 0x00, 0x06, 0x04, 0x0C, 0x0D, 0x0E, 0x0F, 0x0F, 0x07, 0x97, 0x00,
+    0x04, 0x0B, 0x10, 0x11, 0x12, 0x13, 0x8D, 0x00, 0x03, 0x0B, 0x03, 0x14,
+    0x04, 0xAD, 0x00, 0x01, 0x08, 0x10, 0x82, 0x07, 0x00, 0x15, 0x82, 0x05,
+    0x08, 0x16, 0x17, 0x18, 0x0E, 0x19, 0x12, 0x18, 0x07, 0x1A, 0x95, 0x00,
+    0x05, 0x1B, 0x17, 0x11, 0x0F, 0x18, 0x1B, 0x8B, 0x00, 0x03, 0x1A, 0x1C,
+    0x1D, 0x10, 0xAE, 0x00, 0x01, 0x05, 0x0F, 0x87, 0x18, 0x07, 0x11, 0x18,
+    0x0E, 0x11, 0x0F, 0x18, 0x1E, 0x1B, 0x94, 0x00, 0x03, 0x1F, 0x06, 0x0E,
+    0x11, 0x82, 0x18, 0x00, 0x20, 0x88, 0x00, 0x05, 0x0B, 0x21, 0x22, 0x11,
+    0x0F, 0x23, 0xAA, 0x00, 0x08, 0x04, 0x20, 0x02, 0x16, 0x05, 0x24, 0x18,
+    0x0F, 0x11, 0x84, 0x18, 0x07, 0x0F, 0x18, 0x12, 0x0E, 0x18, 0x18, 0x25,
+    0x04, 0x93, 0x00, 0x04, 0x0B, 0x0C, 0x0E, 0x12, 0x0E, 0x83, 0x18, 0x00,
+    0x02, 0x86, 0x00, 0x06, 0x1A, 0x26, 0x27, 0x12, 0x18, 0x0F, 0x23, 0xA8,
+    0x00, 0x03, 0x04, 0x10, 0x28, 0x0E, 0x82, 0x18, 0x06, 0x11, 0x18, 0x0E,
+    0x27, 0x29, 0x2A, 0x2B, 0x82, 0x11, 0x06, 0x18, 0x18, 0x12, 0x11, 0x18,
+    0x0E, 0x04, 0x93, 0x00, 0x04, 0x08, 0x24, 0x0F, 0x12, 0x0E, 0x84, 0x18,
+    0x00, 0x07, 0x83, 0x00, 0x08, 0x0B, 0x1B, 0x2C, 0x0A, 0x0E, 0x18, 0x18,
+    0x0F, 0x23, 0x8D, 0x00, 0x00, 0x2D, 0x91, 0x00, 0x01, 0x21, 0x04, 0x85,
+    0x00, 0x01, 0x05, 0x0E, 0x83, 0x18, 0x02, 0x0F, 0x12, 0x11, 0x82, 0x18,
+    0x02, 0x07, 0x09, 0x0F, 0x83, 0x18, 0x05, 0x0F, 0x0A, 0x11, 0x11, 0x0A,
+    0x08, 0x91, 0x00, 0x04, 0x0B, 0x0C, 0x0F, 0x0E, 0x12, 0x87, 0x18, 0x06,
+    0x13, 0x2E, 0x21, 0x13, 0x2F, 0x11, 0x0E, 0x83, 0x18, 0x00, 0x05, 0x8D,
+    0x00, 0x01, 0x0C, 0x07, 0x91, 0x00, 0x03, 0x2E, 0x1E, 0x05, 0x0B, 0x82,
+    0x00, 0x0C, 0x30, 0x11, 0x11, 0x07, 0x07, 0x31, 0x0E, 0x0A, 0x18, 0x12,
+    0x18, 0x0F, 0x0F, 0x87, 0x18, 0x00, 0x11, 0x82, 0x18, 0x00, 0x07, 0x90,
+    0x00, 0x04, 0x1F, 0x24, 0x18, 0x12, 0x0E, 0x87, 0x18, 0x05, 0x12, 0x11,
+    0x11, 0x12, 0x11, 0x0F, 0x84, 0x18, 0x00, 0x0D, 0x8D, 0x00, 0x02, 0x23,
+    0x0F, 0x07, 0x92, 0x00, 0x06, 0x07, 0x18, 0x12, 0x10, 0x2E, 0x0B, 0x1A,
+    0x84, 0x00, 0x08, 0x04, 0x25, 0x18, 0x18, 0x11, 0x32, 0x20, 0x1B, 0x24,
+    0x85, 0x18, 0x01, 0x12, 0x11, 0x82, 0x18, 0x01, 0x07, 0x02, 0x8D, 0x00,
+    0x04, 0x05, 0x0E, 0x18, 0x11, 0x0F, 0x85, 0x18, 0x06, 0x0F, 0x11, 0x11,
+    0x0F, 0x12, 0x11, 0x0F, 0x86, 0x18, 0x00, 0x0C, 0x8C, 0x00, 0x03, 0x33,
+    0x0F, 0x18, 0x07, 0x92, 0x00, 0x01, 0x1F, 0x0E, 0x82, 0x18, 0x02, 0x12,
+    0x31, 0x34, 0x84, 0x00, 0x08, 0x08, 0x1D, 0x35, 0x36, 0x04, 0x00, 0x00,
+    0x1A, 0x28, 0x84, 0x18, 0x01, 0x0A, 0x0E, 0x84, 0x18, 0x00, 0x10, 0x8A,
+    0x00, 0x04, 0x0B, 0x07, 0x18, 0x0F, 0x11, 0x85, 0x18, 0x06, 0x12, 0x11,
+    0x12, 0x18, 0x11, 0x11, 0x0F, 0x88, 0x18, 0x00, 0x10, 0x8B, 0x00, 0x04,
+    0x1F, 0x1E, 0x18, 0x18, 0x07, 0x93, 0x00, 0x05, 0x23, 0x0F, 0x18, 0x0E,
+    0x2F, 0x37, 0x85, 0x20, 0x09, 0x03, 0x15, 0x38, 0x10, 0x07, 0x06, 0x11,
+    0x0E, 0x12, 0x0F, 0x84, 0x18, 0x00, 0x11, 0x82, 0x18, 0x02, 0x25, 0x02,
+    0x39, 0x89, 0x00, 0x04, 0x08, 0x17, 0x18, 0x0F, 0x12, 0x83, 0x18, 0x06,
+    0x0F, 0x11, 0x11, 0x0F, 0x18, 0x11, 0x11, 0x8B, 0x18, 0x01, 0x0F, 0x23,
+    0x89, 0x00, 0x01, 0x1F, 0x1E, 0x82, 0x18, 0x00, 0x07, 0x94, 0x00, 0x03,
+    0x0C, 0x18, 0x12, 0x0F, 0x8A, 0x18, 0x05, 0x0F, 0x12, 0x2F, 0x3A, 0x0A,
+    0x0A, 0x83, 0x18, 0x01, 0x2F, 0x11, 0x82, 0x18, 0x01, 0x07, 0x08, 0x89,
+    0x00, 0x04, 0x1B, 0x0F, 0x18, 0x0F, 0x12, 0x82, 0x18, 0x06, 0x12, 0x11,
+    0x12, 0x18, 0x0F, 0x11, 0x11, 0x8D, 0x18, 0x03, 0x11, 0x0A, 0x3B, 0x1A,
+    0x86, 0x00, 0x06, 0x1F, 0x1E, 0x18, 0x18, 0x0F, 0x18, 0x07, 0x95, 0x00,
+    0x02, 0x05, 0x0F, 0x3C, 0x83, 0x07, 0x00, 0x3D, 0x82, 0x11, 0x0E, 0x3E,
+    0x3E, 0x35, 0x3A, 0x19, 0x0A, 0x0F, 0x11, 0x19, 0x0F, 0x0E, 0x18, 0x19,
+    0x2F, 0x0F, 0x83, 0x18, 0x01, 0x0F, 0x05, 0x86, 0x00, 0x0E, 0x0B, 0x10,
+    0x18, 0x18, 0x0F, 0x12, 0x18, 0x18, 0x11, 0x0A, 0x0F, 0x18, 0x0F, 0x11,
+    0x12, 0x88, 0x18, 0x00, 0x0E, 0x82, 0x11, 0x05, 0x0A, 0x3E, 0x3E, 0x2F,
+    0x3F, 0x1A, 0x86, 0x00, 0x07, 0x1F, 0x1E, 0x18, 0x11, 0x0F, 0x11, 0x18,
+    0x07, 0x96, 0x00, 0x02, 0x23, 0x17, 0x08, 0x86, 0x00, 0x00, 0x0D, 0x83,
+    0x18, 0x09, 0x24, 0x02, 0x09, 0x18, 0x11, 0x11, 0x3E, 0x18, 0x0F, 0x0F,
+    0x82, 0x18, 0x03, 0x12, 0x0F, 0x12, 0x0B, 0x84, 0x00, 0x01, 0x0B, 0x25,
+    0x82, 0x18, 0x08, 0x11, 0x0F, 0x11, 0x11, 0x18, 0x18, 0x0F, 0x11, 0x12,
+    0x84, 0x18, 0x00, 0x0F, 0x88, 0x11, 0x03, 0x12, 0x18, 0x06, 0x1F, 0x87,
+    0x00, 0x08, 0x1F, 0x1E, 0x18, 0x18, 0x11, 0x18, 0x11, 0x18, 0x07, 0x97,
+    0x00, 0x01, 0x04, 0x08, 0x86, 0x00, 0x0B, 0x07, 0x18, 0x0F, 0x18, 0x13,
+    0x0B, 0x00, 0x26, 0x0E, 0x0E, 0x0F, 0x19, 0x84, 0x18, 0x04, 0x24, 0x0B,
+    0x02, 0x0D, 0x20, 0x84, 0x00, 0x00, 0x07, 0x82, 0x18, 0x0A, 0x2F, 0x11,
+    0x12, 0x18, 0x18, 0x0F, 0x11, 0x12, 0x18, 0x18, 0x12, 0x83, 0x11, 0x02,
+    0x12, 0x18, 0x0E, 0x82, 0x11, 0x00, 0x0E, 0x83, 0x18, 0x00, 0x10, 0x88,
+    0x00, 0x09, 0x1F, 0x1E, 0x18, 0x18, 0x0F, 0x12, 0x18, 0x11, 0x18, 0x28,
+    0x94, 0x00, 0x02, 0x01, 0x05, 0x0B, 0x88, 0x00, 0x0B, 0x02, 0x18, 0x06,
+    0x1D, 0x0B, 0x00, 0x05, 0x18, 0x0E, 0x11, 0x2F, 0x11, 0x84, 0x18, 0x00,
+    0x07, 0x87, 0x00, 0x00, 0x02, 0x82, 0x18, 0x04, 0x12, 0x0E, 0x18, 0x18,
+    0x0F, 0x82, 0x11, 0x06, 0x0A, 0x11, 0x11, 0x0F, 0x18, 0x18, 0x0E, 0x82,
+    0x11, 0x00, 0x0E, 0x86, 0x18, 0x00, 0x10, 0x88, 0x00, 0x01, 0x1F, 0x1E,
+    0x82, 0x18, 0x05, 0x11, 0x18, 0x18, 0x11, 0x18, 0x11, 0x94, 0x00, 0x02,
+    0x0B, 0x24, 0x06, 0x88, 0x00, 0x06, 0x20, 0x18, 0x02, 0x0B, 0x00, 0x00,
+    0x0D, 0x82, 0x18, 0x01, 0x11, 0x11, 0x84, 0x18, 0x02, 0x0F, 0x05, 0x0B,
+    0x85, 0x00, 0x00, 0x07, 0x82, 0x18, 0x06, 0x11, 0x18, 0x18, 0x0F, 0x19,
+    0x11, 0x12, 0x82, 0x18, 0x00, 0x0F, 0x82, 0x11, 0x00, 0x0E, 0x89, 0x18,
+    0x00, 0x13, 0x89, 0x00, 0x00, 0x30, 0x82, 0x07, 0x07, 0x10, 0x0A, 0x18,
+    0x12, 0x11, 0x18, 0x18, 0x20, 0x8E, 0x00, 0x02, 0x0B, 0x20, 0x04, 0x82,
+    0x00, 0x04, 0x05, 0x0E, 0x03, 0x00, 0x0B, 0x85, 0x00, 0x0B, 0x0B, 0x2B,
+    0x0B, 0x00, 0x00, 0x0B, 0x0A, 0x18, 0x18, 0x0E, 0x0E, 0x11, 0x86, 0x18,
+    0x01, 0x28, 0x0B, 0x84, 0x00, 0x03, 0x11, 0x18, 0x18, 0x11, 0x86, 0x18,
+    0x82, 0x11, 0x00, 0x12, 0x8C, 0x18, 0x01, 0x17, 0x0B, 0x8D, 0x00, 0x07,
+    0x08, 0x0F, 0x18, 0x06, 0x05, 0x18, 0x18, 0x1B, 0x8E, 0x00, 0x0B, 0x0B,
+    0x10, 0x0E, 0x0C, 0x00, 0x00, 0x40, 0x0E, 0x0D, 0x00, 0x40, 0x33, 0x89,
+    0x00, 0x06, 0x07, 0x0E, 0x11, 0x11, 0x2F, 0x0A, 0x2F, 0x84, 0x18, 0x03,
+    0x06, 0x3C, 0x18, 0x0C, 0x84, 0x00, 0x03, 0x11, 0x18, 0x18, 0x11, 0x83,
+    0x18, 0x82, 0x11, 0x90, 0x18, 0x00, 0x10, 0x85, 0x00, 0x10, 0x04, 0x0C,
+    0x07, 0x11, 0x11, 0x06, 0x10, 0x2E, 0x00, 0x07, 0x18, 0x18, 0x1B, 0x00,
+    0x10, 0x0F, 0x13, 0x90, 0x00, 0x09, 0x2B, 0x11, 0x09, 0x00, 0x11, 0x18,
+    0x0D, 0x0B, 0x17, 0x05, 0x88, 0x00, 0x01, 0x1A, 0x0F, 0x82, 0x18, 0x02,
+    0x0A, 0x19, 0x2F, 0x83, 0x18, 0x04, 0x11, 0x00, 0x00, 0x02, 0x38, 0x84,
+    0x00, 0x07, 0x11, 0x18, 0x0E, 0x0E, 0x18, 0x18, 0x2F, 0x3E, 0x83, 0x11,
+    0x8F, 0x18, 0x00, 0x2E, 0x84, 0x00, 0x01, 0x05, 0x0E, 0x86, 0x18, 0x09,
+    0x31, 0x12, 0x18, 0x0F, 0x1A, 0x00, 0x00, 0x33, 0x41, 0x0B, 0x8F, 0x00,
+    0x09, 0x11, 0x18, 0x0F, 0x39, 0x0F, 0x18, 0x42, 0x2B, 0x18, 0x02, 0x88,
+    0x00, 0x01, 0x21, 0x0F, 0x82, 0x18, 0x02, 0x11, 0x11, 0x2F, 0x83, 0x18,
+    0x01, 0x0E, 0x04, 0x87, 0x00, 0x02, 0x11, 0x18, 0x11, 0x88, 0x18, 0x86,
+    0x11, 0x00, 0x0F, 0x87, 0x18, 0x00, 0x20, 0x83, 0x00, 0x00, 0x1B, 0x89,
+    0x18, 0x02, 0x0F, 0x12, 0x0D, 0x95, 0x00, 0x09, 0x07, 0x18, 0x18, 0x22,
+    0x18, 0x18, 0x0A, 0x18, 0x11, 0x20, 0x87, 0x00, 0x09, 0x1F, 0x0E, 0x12,
+    0x12, 0x18, 0x18, 0x19, 0x11, 0x0A, 0x12, 0x83, 0x18, 0x01, 0x17, 0x1B,
+    0x86, 0x00, 0x02, 0x11, 0x0E, 0x0E, 0x82, 0x18, 0x87, 0x11, 0x84, 0x18,
+    0x00, 0x12, 0x83, 0x11, 0x83, 0x18, 0x00, 0x20, 0x83, 0x00, 0x00, 0x28,
+    0x82, 0x18, 0x03, 0x12, 0x1D, 0x11, 0x0F, 0x83, 0x18, 0x01, 0x0F, 0x43,
+    0x95, 0x00, 0x09, 0x1B, 0x18, 0x18, 0x11, 0x12, 0x12, 0x0F, 0x18, 0x17,
+    0x0B, 0x87, 0x00, 0x09, 0x13, 0x18, 0x18, 0x0F, 0x11, 0x2F, 0x12, 0x0A,
+    0x0F, 0x2F, 0x85, 0x18, 0x00, 0x09, 0x84, 0x00, 0x02, 0x0B, 0x12, 0x11,
+    0x83, 0x18, 0x02, 0x11, 0x11, 0x0F, 0x83, 0x18, 0x00, 0x0F, 0x87, 0x11,
+    0x01, 0x18, 0x18, 0x82, 0x11, 0x01, 0x0F, 0x10, 0x83, 0x00, 0x08, 0x11,
+    0x18, 0x18, 0x3C, 0x1A, 0x00, 0x00, 0x34, 0x11, 0x83, 0x18, 0x00, 0x10,
+    0x95, 0x00, 0x08, 0x0B, 0x28, 0x18, 0x18, 0x0E, 0x11, 0x18, 0x25, 0x1F,
+    0x88, 0x00, 0x00, 0x07, 0x83, 0x18, 0x04, 0x11, 0x19, 0x12, 0x0A, 0x0A,
+    0x83, 0x18, 0x02, 0x25, 0x05, 0x37, 0x84, 0x00, 0x02, 0x02, 0x12, 0x0F,
+    0x85, 0x18, 0x02, 0x12, 0x11, 0x0F, 0x8A, 0x18, 0x84, 0x11, 0x02, 0x19,
+    0x2F, 0x04, 0x82, 0x00, 0x03, 0x11, 0x18, 0x18, 0x30, 0x83, 0x00, 0x01,
+    0x14, 0x0E, 0x82, 0x18, 0x00, 0x11, 0x96, 0x00, 0x06, 0x0B, 0x07, 0x18,
+    0x18, 0x0E, 0x3C, 0x0B, 0x88, 0x00, 0x02, 0x23, 0x0A, 0x0F, 0x82, 0x18,
+    0x05, 0x11, 0x2F, 0x0F, 0x2F, 0x0A, 0x0F, 0x82, 0x18, 0x00, 0x20, 0x85,
+    0x00, 0x02, 0x0B, 0x44, 0x0F, 0x82, 0x18, 0x01, 0x0A, 0x0E, 0x83, 0x18,
+    0x01, 0x12, 0x11, 0x8C, 0x18, 0x04, 0x17, 0x13, 0x05, 0x45, 0x46, 0x82,
+    0x00, 0x09, 0x13, 0x18, 0x18, 0x12, 0x30, 0x05, 0x05, 0x2B, 0x0F, 0x11,
+    0x82, 0x18, 0x01, 0x0F, 0x1A, 0x96, 0x00, 0x00, 0x05, 0x82, 0x18, 0x01,
+    0x1E, 0x04, 0x88, 0x00, 0x02, 0x28, 0x18, 0x12, 0x82, 0x11, 0x05, 0x0A,
+    0x0A, 0x12, 0x11, 0x12, 0x11, 0x82, 0x18, 0x07, 0x0C, 0x00, 0x0B, 0x20,
+    0x05, 0x13, 0x0D, 0x12, 0x82, 0x18, 0x06, 0x0F, 0x18, 0x0E, 0x0A, 0x11,
+    0x11, 0x0F, 0x82, 0x18, 0x01, 0x11, 0x0E, 0x88, 0x18, 0x02, 0x1E, 0x1B,
+    0x0B, 0x86, 0x00, 0x01, 0x1F, 0x1E, 0x86, 0x18, 0x00, 0x11, 0x83, 0x18,
+    0x00, 0x20, 0x96, 0x00, 0x00, 0x13, 0x83, 0x18, 0x00, 0x0C, 0x87, 0x00,
+    0x01, 0x04, 0x0E, 0x84, 0x18, 0x0B, 0x2F, 0x11, 0x0E, 0x2F, 0x0F, 0x3E,
+    0x18, 0x18, 0x11, 0x28, 0x3D, 0x12, 0x87, 0x18, 0x0D, 0x2F, 0x0E, 0x18,
+    0x0F, 0x12, 0x18, 0x12, 0x11, 0x11, 0x18, 0x18, 0x0E, 0x11, 0x0F, 0x85,
+    0x18, 0x01, 0x25, 0x04, 0x89, 0x00, 0x08, 0x04, 0x10, 0x11, 0x0F, 0x18,
+    0x0F, 0x11, 0x2C, 0x12, 0x82, 0x18, 0x01, 0x12, 0x0B, 0x96, 0x00, 0x00,
+    0x07, 0x83, 0x18, 0x00, 0x0D, 0x87, 0x00, 0x00, 0x20, 0x85, 0x18, 0x07,
+    0x19, 0x0F, 0x3E, 0x18, 0x19, 0x0F, 0x0A, 0x11, 0x89, 0x18, 0x07, 0x12,
+    0x18, 0x11, 0x0E, 0x0E, 0x18, 0x0F, 0x12, 0x82, 0x18, 0x05, 0x11, 0x11,
+    0x0F, 0x18, 0x12, 0x12, 0x83, 0x18, 0x01, 0x12, 0x34, 0x83, 0x20, 0x89,
+    0x00, 0x04, 0x1A, 0x20, 0x1A, 0x0B, 0x13, 0x83, 0x18, 0x00, 0x06, 0x97,
+    0x00, 0x00, 0x0D, 0x83, 0x18, 0x01, 0x0E, 0x04, 0x86, 0x00, 0x01, 0x33,
+    0x2F, 0x84, 0x18, 0x13, 0x3E, 0x0A, 0x11, 0x12, 0x12, 0x0A, 0x0E, 0x18,
+    0x18, 0x0E, 0x11, 0x2F, 0x0F, 0x18, 0x18, 0x0E, 0x18, 0x12, 0x0A, 0x18,
+    0x82, 0x0E, 0x03, 0x12, 0x18, 0x0E, 0x0E, 0x83, 0x18, 0x04, 0x12, 0x11,
+    0x0E, 0x0F, 0x11, 0x82, 0x18, 0x00, 0x11, 0x84, 0x18, 0x05, 0x11, 0x11,
+    0x06, 0x10, 0x02, 0x1A, 0x84, 0x00, 0x02, 0x1A, 0x1B, 0x24, 0x84, 0x18,
+    0x00, 0x02, 0x97, 0x00, 0x00, 0x11, 0x84, 0x18, 0x00, 0x20, 0x86, 0x00,
+    0x01, 0x0D, 0x18, 0x87, 0x11, 0x18, 0x19, 0x11, 0x18, 0x18, 0x12, 0x11,
+    0x0E, 0x18, 0x11, 0x18, 0x0F, 0x19, 0x18, 0x18, 0x11, 0x0F, 0x12, 0x18,
+    0x11, 0x18, 0x0F, 0x12, 0x18, 0x12, 0x0F, 0x84, 0x18, 0x05, 0x0F, 0x11,
+    0x0A, 0x11, 0x0F, 0x11, 0x8A, 0x18, 0x00, 0x0F, 0x84, 0x11, 0x00, 0x0E,
+    0x85, 0x18, 0x00, 0x06, 0x97, 0x00, 0x02, 0x23, 0x0F, 0x12, 0x83, 0x18,
+    0x00, 0x21, 0x86, 0x00, 0x00, 0x11, 0x85, 0x18, 0x1B, 0x0A, 0x2F, 0x11,
+    0x12, 0x18, 0x12, 0x11, 0x0F, 0x18, 0x18, 0x12, 0x0F, 0x0F, 0x12, 0x11,
+    0x18, 0x12, 0x0F, 0x18, 0x11, 0x18, 0x11, 0x18, 0x18, 0x0E, 0x0E, 0x18,
+    0x11, 0x87, 0x18, 0x02, 0x11, 0x2F, 0x2F, 0x83, 0x18, 0x01, 0x11, 0x12,
+    0x90, 0x18, 0x01, 0x1E, 0x04, 0x8D, 0x00, 0x88, 0x47, 0x09, 0x48, 0x0E,
+    0x18, 0x49, 0x0F, 0x18, 0x18, 0x11, 0x0E, 0x4A, 0x85, 0x47, 0x00, 0x11,
+    0x85, 0x18, 0x05, 0x3E, 0x11, 0x12, 0x0E, 0x11, 0x0F, 0x83, 0x18, 0x0B,
+    0x11, 0x0F, 0x12, 0x18, 0x11, 0x18, 0x11, 0x18, 0x18, 0x12, 0x0F, 0x11,
+    0x82, 0x18, 0x03, 0x0F, 0x12, 0x0E, 0x0E, 0x87, 0x18, 0x02, 0x0F, 0x2F,
+    0x2F, 0x84, 0x18, 0x01, 0x11, 0x0F, 0x8D, 0x18, 0x01, 0x4B, 0x4C, 0x96,
+    0x47, 0x0A, 0x4D, 0x4B, 0x18, 0x4E, 0x4D, 0x4F, 0x18, 0x18, 0x11, 0x18,
+    0x11, 0x85, 0x47, 0x00, 0x4F, 0x85, 0x18, 0x03, 0x2F, 0x0E, 0x11, 0x0E,
+    0x84, 0x18, 0x07, 0x12, 0x0F, 0x11, 0x18, 0x18, 0x11, 0x0F, 0x12, 0x82,
+    0x18, 0x01, 0x11, 0x11, 0x83, 0x18, 0x02, 0x0F, 0x12, 0x11, 0x84, 0x18,
+    0x05, 0x12, 0x11, 0x11, 0x19, 0x11, 0x12, 0x85, 0x18, 0x01, 0x12, 0x0F,
+    0x8A, 0x18, 0x02, 0x0F, 0x50, 0x4D, 0x97, 0x47, 0x0C, 0x4A, 0x0E, 0x18,
+    0x4A, 0x47, 0x51, 0x18, 0x18, 0x0E, 0x0E, 0x11, 0x52, 0x51, 0x83, 0x47,
+    0x01, 0x53, 0x11, 0x83, 0x18, 0x02, 0x0A, 0x2F, 0x11, 0x86, 0x18, 0x01,
+    0x11, 0x11, 0x82, 0x18, 0x01, 0x11, 0x11, 0x83, 0x18, 0x01, 0x11, 0x11,
+    0x84, 0x18, 0x0A, 0x0E, 0x12, 0x12, 0x18, 0x18, 0x12, 0x11, 0x0F, 0x18,
+    0x18, 0x11, 0x88, 0x18, 0x01, 0x12, 0x0F, 0x88, 0x18, 0x01, 0x4F, 0x53,
+    0x99, 0x47, 0x12, 0x51, 0x0F, 0x2F, 0x48, 0x47, 0x47, 0x4F, 0x18, 0x18,
+    0x11, 0x12, 0x18, 0x18, 0x54, 0x55, 0x47, 0x47, 0x56, 0x0F, 0x83, 0x11,
+    0x05, 0x2F, 0x12, 0x18, 0x18, 0x0F, 0x12, 0x83, 0x18, 0x01, 0x19, 0x0F,
+    0x82, 0x18, 0x01, 0x11, 0x11, 0x83, 0x18, 0x02, 0x12, 0x12, 0x0E, 0x84,
+    0x18, 0x04, 0x0E, 0x2F, 0x18, 0x12, 0x0F, 0x83, 0x18, 0x01, 0x0F, 0x12,
+    0x88, 0x18, 0x00, 0x11, 0x85, 0x18, 0x02, 0x12, 0x50, 0x57, 0x99, 0x47,
+    0x04, 0x4D, 0x58, 0x59, 0x5A, 0x48, 0x82, 0x47, 0x0B, 0x5B, 0x0F, 0x18,
+    0x18, 0x11, 0x18, 0x18, 0x11, 0x18, 0x5A, 0x5C, 0x5D, 0x84, 0x18, 0x05,
+    0x11, 0x19, 0x11, 0x11, 0x0E, 0x11, 0x82, 0x18, 0x01, 0x2F, 0x12, 0x83,
+    0x18, 0x01, 0x0A, 0x12, 0x84, 0x18, 0x01, 0x11, 0x11, 0x85, 0x18, 0x02,
+    0x11, 0x2F, 0x0F, 0x85, 0x18, 0x01, 0x12, 0x0F, 0x88, 0x18, 0x06, 0x0A,
+    0x12, 0x11, 0x52, 0x56, 0x51, 0x4D, 0x9C, 0x47, 0x01, 0x5E, 0x5E, 0x85,
+    0x47, 0x00, 0x5F, 0x82, 0x18, 0x06, 0x11, 0x11, 0x0F, 0x18, 0x18, 0x11,
+    0x11, 0x85, 0x18, 0x00, 0x11, 0x82, 0x18, 0x04, 0x11, 0x18, 0x0E, 0x11,
+    0x3A, 0x84, 0x18, 0x00, 0x3E, 0x85, 0x18, 0x05, 0x11, 0x11, 0x18, 0x0F,
+    0x11, 0x2F, 0x82, 0x11, 0x00, 0x2F, 0x87, 0x18, 0x01, 0x12, 0x11, 0x88,
+    0x18, 0x02, 0x60, 0x61, 0x4D, 0xA8, 0x47, 0x00, 0x5F, 0x82, 0x18, 0x05,
+    0x12, 0x11, 0x0E, 0x18, 0x11, 0x11, 0x84, 0x18, 0x00, 0x11, 0x83, 0x18,
+    0x04, 0x11, 0x12, 0x0E, 0x18, 0x2F, 0x84, 0x18, 0x0C, 0x3E, 0x18, 0x0A,
+    0x11, 0x0A, 0x11, 0x0E, 0x11, 0x11, 0x0E, 0x12, 0x18, 0x11, 0x82, 0x18,
+    0x01, 0x12, 0x0E, 0x86, 0x18, 0x05, 0x0F, 0x11, 0x12, 0x11, 0x0A, 0x12,
+    0x86, 0x18, 0x01, 0x59, 0x61, 0xA8, 0x47, 0x01, 0x61, 0x0F, 0x82, 0x18,
+    0x04, 0x0E, 0x11, 0x2F, 0x11, 0x2F, 0x83, 0x18, 0x00, 0x11, 0x83, 0x18,
+    0x14, 0x11, 0x0F, 0x12, 0x11, 0x11, 0x12, 0x11, 0x0A, 0x11, 0x18, 0x3E,
+    0x11, 0x0F, 0x12, 0x18, 0x18, 0x0E, 0x2F, 0x19, 0x0E, 0x18, 0x84, 0x11,
+    0x01, 0x12, 0x0E, 0x82, 0x11, 0x00, 0x12, 0x82, 0x18, 0x09, 0x0A, 0x18,
+    0x18, 0x0F, 0x12, 0x0F, 0x11, 0x11, 0x0A, 0x11, 0x84, 0x18, 0x01, 0x4F,
+    0x5B, 0xA7, 0x47, 0x00, 0x56, 0x86, 0x18, 0x00, 0x11, 0x83, 0x18, 0x01,
+    0x0E, 0x0E, 0x83, 0x18, 0x0C, 0x0A, 0x19, 0x18, 0x2F, 0x0A, 0x18, 0x18,
+    0x0A, 0x11, 0x3E, 0x18, 0x18, 0x11, 0x82, 0x18, 0x05, 0x11, 0x18, 0x18,
+    0x0E, 0x12, 0x11, 0x86, 0x18, 0x04, 0x52, 0x48, 0x5F, 0x5D, 0x12, 0x82,
+    0x18, 0x00, 0x11, 0x82, 0x18, 0x0B, 0x11, 0x18, 0x18, 0x11, 0x2F, 0x11,
+    0x0F, 0x18, 0x18, 0x0F, 0x52, 0x4C, 0xA6, 0x47, 0x00, 0x5F, 0x85, 0x18,
+    0x00, 0x11, 0x83, 0x18, 0x12, 0x12, 0x0A, 0x0E, 0x12, 0x11, 0x0A, 0x11,
+    0x0E, 0x0A, 0x0F, 0x11, 0x18, 0x18, 0x11, 0x18, 0x12, 0x18, 0x18, 0x11,
+    0x82, 0x18, 0x05, 0x11, 0x0F, 0x11, 0x0E, 0x18, 0x11, 0x85, 0x18, 0x09,
+    0x5F, 0x4D, 0x47, 0x47, 0x5B, 0x60, 0x18, 0x18, 0x0E, 0x0E, 0x82, 0x18,
+    0x00, 0x11, 0x82, 0x18, 0x03, 0x11, 0x18, 0x11, 0x0E, 0x82, 0x18, 0x01,
+    0x0E, 0x61, 0xA5, 0x47, 0x01, 0x4D, 0x4B, 0x84, 0x18, 0x12, 0x0F, 0x12,
+    0x18, 0x18, 0x0E, 0x0E, 0x18, 0x0E, 0x2F, 0x0E, 0x12, 0x2F, 0x12, 0x18,
+    0x18, 0x11, 0x18, 0x18, 0x11, 0x83, 0x18, 0x09, 0x11, 0x18, 0x18, 0x2F,
+    0x19, 0x19, 0x0F, 0x18, 0x0F, 0x12, 0x84, 0x18, 0x00, 0x52, 0x84, 0x47,
+    0x03, 0x48, 0x4A, 0x61, 0x62, 0x82, 0x18, 0x0F, 0x11, 0x0F, 0x18, 0x18,
+    0x11, 0x18, 0x18, 0x11, 0x0E, 0x0E, 0x18, 0x0F, 0x0E, 0x18, 0x5A, 0x4C,
+    0xA4, 0x47, 0x01, 0x4C, 0x0E, 0x84, 0x18, 0x03, 0x12, 0x0F, 0x18, 0x11,
+    0x82, 0x18, 0x02, 0x0A, 0x0E, 0x0A, 0x82, 0x18, 0x04, 0x0F, 0x12, 0x18,
+    0x18, 0x11, 0x82, 0x18, 0x09, 0x0E, 0x12, 0x18, 0x0E, 0x0E, 0x18, 0x18,
+    0x0E, 0x11, 0x19, 0x85, 0x18, 0x00, 0x61, 0x88, 0x47, 0x13, 0x55, 0x4A,
+    0x57, 0x57, 0x5A, 0x11, 0x63, 0x64, 0x18, 0x0E, 0x0E, 0x18, 0x11, 0x18,
+    0x18, 0x65, 0x60, 0x18, 0x60, 0x4C, 0xA4, 0x47, 0x00, 0x61, 0x83, 0x18,
+    0x0A, 0x12, 0x63, 0x66, 0x52, 0x67, 0x0A, 0x18, 0x0E, 0x0E, 0x0A, 0x11,
+    0x82, 0x18, 0x03, 0x11, 0x18, 0x18, 0x11, 0x82, 0x18, 0x04, 0x60, 0x51,
+    0x55, 0x55, 0x0A, 0x84, 0x18, 0x00, 0x11, 0x85, 0x18, 0x00, 0x5F, 0x90,
+    0x47, 0x0B, 0x55, 0x54, 0x18, 0x18, 0x11, 0x18, 0x18, 0x56, 0x48, 0x50,
+    0x11, 0x68, 0xA4, 0x47, 0x05, 0x4D, 0x59, 0x18, 0x18, 0x69, 0x4D, 0x82,
+    0x47, 0x03, 0x4A, 0x18, 0x12, 0x2F, 0x85, 0x18, 0x07, 0x11, 0x18, 0x18,
+    0x0A, 0x18, 0x0E, 0x52, 0x48, 0x82, 0x47, 0x00, 0x63, 0x84, 0x18, 0x01,
+    0x12, 0x0F, 0x84, 0x18, 0x01, 0x0E, 0x57, 0x91, 0x47, 0x05, 0x69, 0x12,
+    0x0A, 0x11, 0x18, 0x52, 0xA9, 0x47, 0x03, 0x5F, 0x18, 0x59, 0x4D, 0x82,
+    0x47, 0x04, 0x4D, 0x66, 0x11, 0x0A, 0x0E, 0x82, 0x18, 0x08, 0x11, 0x18,
+    0x18, 0x11, 0x18, 0x5A, 0x57, 0x55, 0x48, 0x84, 0x47, 0x00, 0x61, 0x85,
+    0x18, 0x00, 0x0A, 0x86, 0x18, 0x02, 0x63, 0x56, 0x48, 0x8E, 0x47, 0x05,
+    0x55, 0x18, 0x18, 0x11, 0x18, 0x52, 0xA9, 0x47, 0x02, 0x51, 0x18, 0x5F,
+    0x83, 0x47, 0x03, 0x5F, 0x18, 0x18, 0x11, 0x82, 0x18, 0x05, 0x4B, 0x6A,
+    0x18, 0x18, 0x12, 0x61, 0x89, 0x47, 0x02, 0x4A, 0x59, 0x0F, 0x82, 0x11,
+    0x02, 0x0F, 0x11, 0x12, 0x86, 0x18, 0x03, 0x12, 0x4F, 0x50, 0x53, 0x8B,
+    0x47, 0x05, 0x5E, 0x0F, 0x18, 0x0A, 0x18, 0x52, 0xA9, 0x47, 0x02, 0x55,
+    0x59, 0x4D, 0x83, 0x47, 0x0B, 0x50, 0x18, 0x0E, 0x0E, 0x18, 0x18, 0x60,
+    0x4C, 0x4D, 0x59, 0x18, 0x63, 0x8B, 0x47, 0x01, 0x4D, 0x6B, 0x83, 0x18,
+    0x00, 0x0F, 0x82, 0x11, 0x02, 0x0A, 0x11, 0x0F, 0x84, 0x18, 0x01, 0x0F,
+    0x5B, 0x8B, 0x47, 0x04, 0x6C, 0x0A, 0x11, 0x18, 0x52, 0xA9, 0x47, 0x01,
+    0x5E, 0x5B, 0x83, 0x47, 0x0C, 0x4C, 0x63, 0x12, 0x0A, 0x18, 0x18, 0x60,
+    0x4C, 0x47, 0x47, 0x61, 0x18, 0x5F, 0x8C, 0x47, 0x12, 0x4C, 0x5A, 0x11,
+    0x11, 0x12, 0x12, 0x18, 0x18, 0x11, 0x18, 0x18, 0x11, 0x18, 0x18, 0x63,
+    0x4F, 0x0F, 0x18, 0x5A, 0x8B, 0x47, 0x04, 0x11, 0x18, 0x11, 0x18, 0x52,
+    0xAF, 0x47, 0x06, 0x4F, 0x18, 0x0E, 0x0E, 0x18, 0x60, 0x4C, 0x82, 0x47,
+    0x02, 0x4D, 0x0A, 0x48, 0x90, 0x47, 0x0E, 0x56, 0x0E, 0x12, 0x11, 0x0F,
+    0x18, 0x12, 0x0F, 0x18, 0x0F, 0x53, 0x47, 0x5E, 0x56, 0x64, 0x8B, 0x47,
+    0x04, 0x11, 0x18, 0x11, 0x18, 0x56, 0xAF, 0x47, 0x05, 0x11, 0x18, 0x11,
+    0x18, 0x60, 0x4C, 0x84, 0x47, 0x00, 0x55, 0x84, 0x47, 0x02, 0x55, 0x48,
+    0x4A, 0x89, 0x47, 0x01, 0x4C, 0x4F, 0x82, 0x11, 0x04, 0x2F, 0x0E, 0x18,
+    0x18, 0x61, 0x8F, 0x47, 0x05, 0x56, 0x12, 0x19, 0x0E, 0x18, 0x4A, 0xAE,
+    0x47, 0x05, 0x6D, 0x11, 0x0E, 0x0E, 0x60, 0x4C, 0x89, 0x47, 0x06, 0x4D,
+    0x6E, 0x12, 0x2F, 0x18, 0x5A, 0x4D, 0x86, 0x47, 0x09, 0x48, 0x6F, 0x18,
+    0x18, 0x0F, 0x11, 0x0F, 0x18, 0x18, 0x5F, 0x85, 0x47, 0x03, 0x51, 0x61,
+    0x6C, 0x6D, 0x86, 0x47, 0x05, 0x11, 0x18, 0x11, 0x18, 0x0F, 0x5E, 0xA2,
+    0x47, 0x04, 0x4A, 0x52, 0x50, 0x69, 0x5E, 0x85, 0x47, 0x05, 0x4C, 0x60,
+    0x12, 0x12, 0x18, 0x4A, 0x8A, 0x47, 0x07, 0x57, 0x53, 0x4C, 0x0A, 0x18,
+    0x18, 0x4B, 0x48, 0x84, 0x47, 0x05, 0x53, 0x0E, 0x0F, 0x11, 0x0A, 0x12,
+    0x82, 0x18, 0x00, 0x5F, 0x85, 0x47, 0x05, 0x69, 0x6B, 0x0E, 0x11, 0x0F,
+    0x6D, 0x85, 0x47, 0x04, 0x67, 0x11, 0x12, 0x18, 0x11, 0xA3, 0x47, 0x0B,
+    0x6F, 0x69, 0x11, 0x12, 0x0F, 0x52, 0x57, 0x4D, 0x47, 0x4D, 0x61, 0x0E,
+    0x82, 0x18, 0x00, 0x4F, 0x8E, 0x47, 0x09, 0x53, 0x5F, 0x4F, 0x18, 0x0E,
+    0x5F, 0x57, 0x69, 0x52, 0x63, 0x82, 0x11, 0x00, 0x0A, 0x82, 0x18, 0x01,
+    0x0E, 0x4A, 0x86, 0x47, 0x07, 0x48, 0x47, 0x70, 0x0F, 0x18, 0x0F, 0x56,
+    0x4D, 0x82, 0x47, 0x00, 0x5F, 0x83, 0x18, 0x00, 0x50, 0xA5, 0x47, 0x07,
+    0x19, 0x12, 0x18, 0x18, 0x0E, 0x19, 0x3E, 0x11, 0x84, 0x18, 0x00, 0x51,
+    0x8A, 0x47, 0x0A, 0x4D, 0x61, 0x58, 0x52, 0x50, 0x48, 0x47, 0x5F, 0x0F,
+    0x11, 0x12, 0x87, 0x18, 0x02, 0x0F, 0x52, 0x48, 0x88, 0x47, 0x09, 0x4C,
+    0x50, 0x71, 0x11, 0x11, 0x18, 0x59, 0x56, 0x61, 0x62, 0x84, 0x18, 0x00,
+    0x4A, 0xA1, 0x47, 0x08, 0x4D, 0x61, 0x52, 0x62, 0x0F, 0x0F, 0x11, 0x11,
+    0x0E, 0x86, 0x18, 0x01, 0x12, 0x4D, 0x89, 0x47, 0x09, 0x4D, 0x4F, 0x11,
+    0x11, 0x18, 0x18, 0x0E, 0x52, 0x52, 0x0A, 0x87, 0x18, 0x02, 0x12, 0x50,
+    0x53, 0x88, 0x47, 0x03, 0x4D, 0x52, 0x12, 0x12, 0x82, 0x18, 0x01, 0x11,
+    0x0E, 0x87, 0x18, 0x00, 0x52, 0xA1, 0x47, 0x04, 0x58, 0x5A, 0x52, 0x11,
+    0x0A, 0x82, 0x11, 0x00, 0x12, 0x87, 0x18, 0x03, 0x63, 0x52, 0x56, 0x5B,
+    0x86, 0x47, 0x06, 0x5E, 0x4A, 0x48, 0x63, 0x0F, 0x11, 0x0A, 0x83, 0x11,
+    0x85, 0x18, 0x03, 0x64, 0x58, 0x51, 0x4D, 0x88, 0x47, 0x07, 0x68, 0x68,
+    0x58, 0x19, 0x5F, 0x61, 0x72, 0x11, 0x89, 0x18, 0x02, 0x5A, 0x51, 0x4D,
+    0x9E, 0x47, 0x04, 0x48, 0x47, 0x47, 0x48, 0x4F, 0x87, 0x18, 0x03, 0x0F,
+    0x5A, 0x72, 0x0E, 0x82, 0x18, 0x02, 0x0A, 0x11, 0x61, 0x87, 0x47, 0x0D,
+    0x5E, 0x73, 0x12, 0x18, 0x18, 0x0F, 0x11, 0x5A, 0x52, 0x58, 0x4F, 0x5A,
+    0x61, 0x6B, 0x82, 0x18, 0x02, 0x6C, 0x56, 0x48, 0x86, 0x47, 0x00, 0x55,
+    0x82, 0x47, 0x06, 0x4D, 0x52, 0x11, 0x18, 0x18, 0x12, 0x11, 0x82, 0x18,
+    0x07, 0x0E, 0x4F, 0x5D, 0x0F, 0x18, 0x18, 0x64, 0x61, 0x9F, 0x47, 0x03,
+    0x4C, 0x63, 0x12, 0x12, 0x82, 0x18, 0x0E, 0x52, 0x57, 0x55, 0x69, 0x53,
+    0x47, 0x47, 0x4C, 0x5A, 0x0F, 0x18, 0x6E, 0x56, 0x64, 0x4D, 0x86, 0x47,
+    0x05, 0x50, 0x12, 0x0A, 0x11, 0x5F, 0x5E, 0x87, 0x47, 0x06, 0x51, 0x59,
+    0x18, 0x0A, 0x5A, 0x2F, 0x48, 0x88, 0x47, 0x13, 0x5B, 0x5A, 0x11, 0x18,
+    0x59, 0x4A, 0x4D, 0x4D, 0x61, 0x52, 0x61, 0x48, 0x47, 0x47, 0x53, 0x74,
+    0x12, 0x11, 0x11, 0x61, 0x9E, 0x47, 0x06, 0x72, 0x50, 0x69, 0x6B, 0x11,
+    0x5A, 0x51, 0x88, 0x47, 0x05, 0x5E, 0x55, 0x4D, 0x47, 0x4D, 0x4D, 0x86,
+    0x47, 0x03, 0x75, 0x4D, 0x4D, 0x5E, 0x8A, 0x47, 0x05, 0x4D, 0x55, 0x5E,
+    0x47, 0x4C, 0x5E, 0x87, 0x47, 0x05, 0x4D, 0x63, 0x4F, 0x68, 0x6F, 0x4D,
+    0x8A, 0x47, 0x03, 0x55, 0x47, 0x4D, 0x76, 0x9E, 0x47, 0x00, 0x6A, 0xB8,
+    0x47, 0x01, 0x48, 0x5B, 0xFF, 0x47, 0xFF, 0x47, 0xFF, 0x47, 0xFF, 0x47,
+    0xC8, 0x47};
@@ -0,0 +1,64 @@
+// ILI9341 display list example: a dashboard background is recorded once
+// into a display list and replayed whenever the screen has to be rebuilt,
+// e.g. after the panel is reset or woken. Replaying skips all of the GFX
+// maths and sends the screen in a single SPI transaction.
+
+#include "SPI.h"
+#include "Adafruit_GFX.h"
+#include "Adafruit_ILI9341.h"
+#include "ILI9341_DisplayList.h"
+
+// For the Adafruit shield, these are the default.
+#define TFT_DC 9
+#define TFT_CS 10
+
+Adafruit_ILI9341 tft = Adafruit_ILI9341(TFT_CS, TFT_DC);
+ILI9341_DisplayList background;
+
+void drawBackground(Adafruit_GFX &gfx) {
+  gfx.fillScreen(ILI9341_NAVY);
+  for (int16_t i = 0; i < 4; i++) {
+    int16_t y = 10 + i * 75;
+    gfx.fillRoundRect(10, y, 220, 65, 8, ILI9341_DARKGREY);
+    gfx.drawRoundRect(10, y, 220, 65, 8, ILI9341_WHITE);
+    gfx.drawCircle(50, y + 32, 25, ILI9341_CYAN);
+    gfx.setCursor(90, y + 10);
+    gfx.setTextColor(ILI9341_WHITE);
+    gfx.setTextSize(2);
+    gfx.print(F("Channel "));
+    gfx.print(i + 1);
+  }
+}
+
+void setup() {
+  Serial.begin(9600);
+  tft.begin();
+
+  if (!background.begin(8192)) {
+    Serial.println(F("Not enough RAM for the display list"));
+    while (1) yield();
+  }
+  drawBackground(background);
+  Serial.print(F("Display list: "));
+  Serial.print(background.length());
+  Serial.println(background.overflowed() ? F(" bytes (truncated)")
+                                         : F(" bytes"));
+
+  uint32_t t = micros();
+  drawBackground(tft);
+  Serial.print(F("Direct draw: "));
+  Serial.print(micros() - t);
+  Serial.println(F(" us"));
+}
+
+void loop() {
+  delay(2000);
+
+  // Simulate the panel losing its contents, then rebuild from the list
+  tft.fillScreen(ILI9341_BLACK);
+  uint32_t t = micros();
+  background.replay(tft);
+  Serial.print(F("Replay: "));
+  Serial.print(micros() - t);
+  Serial.println(F(" us"));
+}
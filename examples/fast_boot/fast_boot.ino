@@ -0,0 +1,42 @@
+// ILI9341 fast boot example: starts the display with beginAsync() and
+// brings up the rest of the system while the panel wakes from sleep,
+// then reports how long it took to get the first frame on screen.
+
+#include "SPI.h"
+#include "Adafruit_GFX.h"
+#include "Adafruit_ILI9341.h"
+
+// For the Adafruit shield, these are the default.
+#define TFT_DC 9
+#define TFT_CS 10
+
+Adafruit_ILI9341 tft = Adafruit_ILI9341(TFT_CS, TFT_DC);
+
+uint32_t otherWork = 0;
+
+void setup() {
+  uint32_t start = millis();
+  tft.beginAsync();
+
+  // Anything that doesn't need the display can run here: poll() returns
+  // true after about 240 ms (120 ms from reset to SLPOUT, then 120 ms
+  // before DISPON).
+  Serial.begin(9600);
+  while (!tft.poll()) {
+    otherWork++; // e.g. read sensors, start the network...
+  }
+
+  tft.fillScreen(ILI9341_BLACK);
+  tft.setTextColor(ILI9341_WHITE);
+  tft.setTextSize(2);
+  tft.print(F("First frame after "));
+  tft.print(millis() - start);
+  tft.println(F(" ms"));
+
+  Serial.print(F("Boot to first frame: "));
+  Serial.print(millis() - start);
+  Serial.print(F(" ms, loop iterations while waiting: "));
+  Serial.println(otherWork);
+}
+
+void loop(void) {}
@@ -0,0 +1,74 @@
+// ILI9341 indexed layers example: a 4 bpp sprite moves over a 1 bpp
+// checkerboard. Each frame redraws only the rectangle covering the
+// sprite's old and new positions, compositing both layers line by line
+// with drawIndexedLayers(), so no frame buffer is needed.
+
+#include "SPI.h"
+#include "Adafruit_GFX.h"
+#include "Adafruit_ILI9341.h"
+
+// For the Adafruit shield, these are the default.
+#define TFT_DC 9
+#define TFT_CS 10
+
+#define SPRITE_SIZE 32
+
+Adafruit_ILI9341 tft = Adafruit_ILI9341(TFT_CS, TFT_DC);
+
+uint8_t checker[ILI9341_TFTWIDTH / 8 * ILI9341_TFTHEIGHT]; // 1 bpp
+uint8_t sprite[SPRITE_SIZE / 2 * SPRITE_SIZE];             // 4 bpp
+uint16_t checkerPalette[2] = {ILI9341_DARKGREY, ILI9341_LIGHTGREY};
+uint16_t spritePalette[16];
+
+ILI9341_IndexedLayer background = {checker, checkerPalette, 0, 0,
+                                   ILI9341_TFTWIDTH, ILI9341_TFTHEIGHT, 1,
+                                   -1};
+ILI9341_IndexedLayer ball = {sprite, spritePalette, 0, 0, SPRITE_SIZE,
+                             SPRITE_SIZE, 4, 0}; // Index 0 is see-through
+
+int16_t dx = 3, dy = 2;
+
+void setup() {
+  Serial.begin(9600);
+  tft.begin();
+
+  // 16x16 pixel squares
+  for (uint16_t y = 0; y < ILI9341_TFTHEIGHT; y++)
+    for (uint16_t x = 0; x < ILI9341_TFTWIDTH / 8; x++)
+      checker[y * (ILI9341_TFTWIDTH / 8) + x] = ((x / 2 + y / 16) & 1) ? 0xFF : 0;
+
+  // A disc with concentric rings of colours 1-15
+  for (uint8_t i = 1; i < 16; i++)
+    spritePalette[i] = tft.color565(255, i * 16, 255 - i * 16);
+  for (int16_t y = 0; y < SPRITE_SIZE; y++) {
+    for (int16_t x = 0; x < SPRITE_SIZE; x += 2) {
+      uint8_t p = 0;
+      for (uint8_t k = 0; k < 2; k++) {
+        int16_t ox = x + k - SPRITE_SIZE / 2, oy = y - SPRITE_SIZE / 2;
+        uint16_t d2 = ox * ox + oy * oy;
+        uint8_t c = (d2 < SPRITE_SIZE * SPRITE_SIZE / 4) ? 1 + d2 % 15 : 0;
+        p = (p << 4) | c;
+      }
+      sprite[y * (SPRITE_SIZE / 2) + x / 2] = p;
+    }
+  }
+
+  tft.drawIndexedBitmap(0, 0, checker, 1, ILI9341_TFTWIDTH,
+                        ILI9341_TFTHEIGHT, checkerPalette);
+}
+
+void loop() {
+  int16_t oldX = ball.x, oldY = ball.y;
+  if ((ball.x + dx < 0) || (ball.x + dx + SPRITE_SIZE > tft.width()))
+    dx = -dx;
+  if ((ball.y + dy < 0) || (ball.y + dy + SPRITE_SIZE > tft.height()))
+    dy = -dy;
+  ball.x += dx;
+  ball.y += dy;
+
+  int16_t x0 = min(oldX, ball.x), y0 = min(oldY, ball.y);
+  int16_t x1 = max(oldX, ball.x) + SPRITE_SIZE;
+  int16_t y1 = max(oldY, ball.y) + SPRITE_SIZE;
+  tft.drawIndexedLayers(x0, y0, x1 - x0, y1 - y0, background, ball);
+  delay(10);
+}
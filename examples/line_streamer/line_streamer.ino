@@ -0,0 +1,57 @@
+// ILI9341 line streamer example: a full-screen plasma computed one line at
+// a time. On boards with SPI DMA, each line is rendered while the previous
+// one is still being sent. The statistics printed every 16 frames show
+// whether the effect is limited by the CPU or by the SPI bus.
+
+#include "SPI.h"
+#include "Adafruit_GFX.h"
+#include "Adafruit_ILI9341.h"
+#include "ILI9341_LineStreamer.h"
+
+// For the Adafruit shield, these are the default.
+#define TFT_DC 9
+#define TFT_CS 10
+
+Adafruit_ILI9341 tft = Adafruit_ILI9341(TFT_CS, TFT_DC);
+ILI9341_LineStreamer streamer(tft);
+
+uint8_t sine[256];
+uint16_t frame = 0;
+
+void plasmaLine(uint16_t *line, int16_t y, uint16_t w, void *arg) {
+  uint8_t t = *(uint16_t *)arg;
+  uint8_t ty = sine[(uint8_t)(y + t)] + sine[(uint8_t)(y * 2 - t)];
+  for (uint16_t x = 0; x < w; x++) {
+    uint8_t v = ty + sine[(uint8_t)(x + t * 2)] + sine[(uint8_t)(x + y + t)];
+    line[x] = tft.color565(sine[v], sine[(uint8_t)(v + 85)],
+                           sine[(uint8_t)(v + 170)]);
+  }
+}
+
+void setup() {
+  Serial.begin(9600);
+  tft.begin();
+  tft.setRotation(1);
+  for (uint16_t i = 0; i < 256; i++)
+    sine[i] = 128 + 127 * sin(i * 2 * PI / 256);
+  if (!streamer.begin(tft.width())) {
+    Serial.println(F("Not enough RAM for line buffers"));
+    while (1) yield();
+  }
+}
+
+void loop() {
+  streamer.stream(0, 0, tft.width(), tft.height(), plasmaLine, &frame);
+
+  if (!(++frame & 15)) {
+    const ILI9341_StreamStats &s = streamer.stats();
+    Serial.print(F("render "));
+    Serial.print(s.renderMicros / 16);
+    Serial.print(F(" us/frame, DMA wait "));
+    Serial.print(s.dmaWaitMicros / 16);
+    Serial.print(F(" us/frame, starved "));
+    Serial.print(s.starvedLines * 100 / s.lines);
+    Serial.println(F("% of lines"));
+    streamer.resetStats();
+  }
+}
@@ -0,0 +1,61 @@
+// ILI9341 low-power example: a seconds counter shown in a 40-row partial
+// area, in 8-colour idle mode at a reduced frame rate. Every 30 seconds it
+// returns to full-screen normal mode for five seconds.
+
+#include "SPI.h"
+#include "Adafruit_GFX.h"
+#include "Adafruit_ILI9341.h"
+
+// For the Adafruit shield, these are the default.
+#define TFT_DC 9
+#define TFT_CS 10
+
+#define BAND_TOP 140 // Partial area rows (rotation 0, so rows == y)
+#define BAND_ROWS 40
+
+Adafruit_ILI9341 tft = Adafruit_ILI9341(TFT_CS, TFT_DC);
+
+void setup() {
+  Serial.begin(9600);
+  tft.begin();
+  tft.fillScreen(ILI9341_NAVY);
+  tft.setTextColor(ILI9341_WHITE, ILI9341_NAVY);
+  tft.setTextSize(2);
+  tft.setCursor(10, 10);
+  tft.println(F("Full screen mode"));
+
+  // Rates for the two low-power modes; normal mode keeps the init value
+  Serial.print(F("Partial mode: "));
+  Serial.print(tft.setFrameRate(20, ILI9341_FRMCTR3));
+  Serial.println(F(" Hz"));
+  Serial.print(F("Idle mode:    "));
+  Serial.print(tft.setFrameRate(10, ILI9341_FRMCTR2));
+  Serial.println(F(" Hz"));
+
+  tft.fillRect(0, BAND_TOP, tft.width(), BAND_ROWS, ILI9341_BLUE);
+  tft.setTextColor(ILI9341_YELLOW, ILI9341_BLUE);
+  tft.setPartialArea(BAND_TOP, BAND_TOP + BAND_ROWS - 1);
+}
+
+void loop() {
+  uint32_t s = millis() / 1000;
+  bool awake = (s % 30) < 5;
+
+  if (awake) {
+    tft.normalMode();
+  } else {
+    // Idle mode keeps only the MSB of each channel, so stick to the eight
+    // primary/secondary colours inside the band
+    tft.enablePartialMode(true);
+    tft.enableIdleMode(true);
+  }
+
+  tft.setCursor(60, BAND_TOP + 12);
+  tft.print(s / 60);
+  tft.print(':');
+  if ((s % 60) < 10)
+    tft.print('0');
+  tft.print(s % 60);
+
+  delay(1000 - (millis() % 1000));
+}
@@ -0,0 +1,50 @@
+// ILI9341 readback example: a magnifier that reads a small patch of the
+// screen back from the panel with readPixels() and draws it enlarged in
+// the corner. Needs the TFT's MISO pin connected.
+
+#include "SPI.h"
+#include "Adafruit_GFX.h"
+#include "Adafruit_ILI9341.h"
+
+// For the Adafruit shield, these are the default.
+#define TFT_DC 9
+#define TFT_CS 10
+
+#define PATCH 16 // Patch edge in pixels
+#define ZOOM 5   // Magnification
+
+Adafruit_ILI9341 tft = Adafruit_ILI9341(TFT_CS, TFT_DC);
+uint16_t patch[PATCH * PATCH];
+
+void setup() {
+  Serial.begin(9600);
+  tft.begin();
+  tft.setReadSpeed(4000000); // Slower than the default for long wires
+
+  for (int16_t i = 0; i < 40; i++)
+    tft.fillCircle(random(tft.width()), random(tft.height() - 100) + 100,
+                   random(5, 30), random(0x10000));
+  tft.setCursor(10, 250);
+  tft.setTextColor(ILI9341_WHITE);
+  tft.setTextSize(2);
+  tft.print(F("Readback!"));
+  tft.drawRect(0, 0, PATCH * ZOOM + 2, PATCH * ZOOM + 2, ILI9341_WHITE);
+}
+
+void loop() {
+  static int16_t x = 0, y = 100, dx = 1, dy = 1;
+  if ((x + dx < 0) || (x + dx + PATCH > tft.width()))
+    dx = -dx;
+  if ((y + dy < PATCH * ZOOM + 2) || (y + dy + PATCH > tft.height()))
+    dy = -dy;
+  x += dx;
+  y += dy;
+
+  tft.readPixels(x, y, PATCH, PATCH, patch);
+  tft.startWrite();
+  for (int16_t j = 0; j < PATCH; j++)
+    for (int16_t i = 0; i < PATCH; i++)
+      tft.writeFillRect(1 + i * ZOOM, 1 + j * ZOOM, ZOOM, ZOOM,
+                        patch[j * PATCH + i]);
+  tft.endWrite();
+}
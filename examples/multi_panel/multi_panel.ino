@@ -0,0 +1,102 @@
+// ILI9341 shared-bus example: three panels on one SPI bus, each with its
+// own CS pin and sharing DC. Every panel shows an animated level bar. The
+// bars are rendered into RAM buffers and queued with ILI9341_BusScheduler,
+// which sends them in chunks, taking turns between the panels, while
+// loop() goes on rendering. Panel 0 is given twice the share of the others.
+// Frames per second for each panel are printed over serial. The three bar
+// buffers take about 38 KB of RAM.
+
+#include "SPI.h"
+#include "Adafruit_GFX.h"
+#include "Adafruit_ILI9341.h"
+#include "ILI9341_BusScheduler.h"
+
+#define PANELS 3
+#define TFT_DC 9
+const uint8_t csPins[PANELS] = {10, 8, 7};
+
+Adafruit_ILI9341 tft[PANELS] = {Adafruit_ILI9341(10, TFT_DC),
+                                Adafruit_ILI9341(8, TFT_DC),
+                                Adafruit_ILI9341(7, TFT_DC)};
+ILI9341_BusScheduler bus;
+
+#define BAR_X 60
+#define BAR_Y 104
+#define BAR_W 200
+#define BAR_H 32
+
+const uint16_t barColors[PANELS] = {ILI9341_GREEN, ILI9341_CYAN,
+                                    ILI9341_ORANGE};
+uint16_t bars[PANELS][BAR_W * BAR_H];
+bool busy[PANELS];
+uint32_t steps[PANELS], frames[PANELS], lastReport;
+
+// Called from bus.poll() once a panel's bar has been sent
+void barSent(uint8_t panel, void *) { busy[panel] = false; }
+
+void renderBar(uint8_t p) {
+  float phase = steps[p] * 0.04 * (p + 1);
+  int16_t level = (BAR_W - 1) * (1 + sin(phase)) / 2;
+  for (int16_t y = 0; y < BAR_H; y++) {
+    uint16_t *row = &bars[p][y * BAR_W];
+    for (int16_t x = 0; x < BAR_W; x++)
+      row[x] = (x <= level) ? barColors[p] : ILI9341_BLACK;
+  }
+}
+
+void setup() {
+  Serial.begin(9600);
+
+  // Deselect every panel before talking to any of them
+  for (uint8_t p = 0; p < PANELS; p++) {
+    pinMode(csPins[p], OUTPUT);
+    digitalWrite(csPins[p], HIGH);
+  }
+
+  bus.begin(PANELS);
+  for (uint8_t p = 0; p < PANELS; p++) {
+    tft[p].begin();
+    tft[p].setRotation(1);
+    bus.addPanel(tft[p], (p == 0) ? 2 : 1);
+    bus.queueFill(p, 0, 0, tft[p].width(), tft[p].height(), ILI9341_BLACK);
+  }
+  bus.flush(); // Finish queued work before drawing on the panels directly
+
+  for (uint8_t p = 0; p < PANELS; p++) {
+    tft[p].setTextColor(ILI9341_WHITE);
+    tft[p].setTextSize(2);
+    tft[p].setCursor(BAR_X, BAR_Y - 30);
+    tft[p].print(F("Panel "));
+    tft[p].print(p);
+    tft[p].drawRect(BAR_X - 2, BAR_Y - 2, BAR_W + 4, BAR_H + 4,
+                    ILI9341_WHITE);
+  }
+  lastReport = millis();
+}
+
+void loop() {
+  // Render a new bar for each panel whose last one is out, then let the
+  // scheduler send the next chunk
+  for (uint8_t p = 0; p < PANELS; p++) {
+    if (busy[p])
+      continue;
+    renderBar(p);
+    busy[p] = bus.queuePixels(p, BAR_X, BAR_Y, BAR_W, BAR_H, bars[p], barSent);
+    steps[p]++;
+    frames[p]++;
+  }
+  bus.poll();
+
+  if (millis() - lastReport >= 2000) {
+    for (uint8_t p = 0; p < PANELS; p++) {
+      Serial.print(F("panel "));
+      Serial.print(p);
+      Serial.print(F(": "));
+      Serial.print(frames[p] / 2.0);
+      Serial.print(F(" fps  "));
+      frames[p] = 0;
+    }
+    Serial.println();
+    lastReport = millis();
+  }
+}
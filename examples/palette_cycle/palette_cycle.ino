@@ -0,0 +1,57 @@
+// ILI9341 indexed canvas example: a one-byte-per-pixel framebuffer with a
+// 256-colour palette. The scene is drawn once; the animation is done purely
+// by rotating palette entries, and each flush() only resends the pixels
+// that use the rotated entries. Needs ~90 KB of RAM (SAMD51, ESP32...).
+
+#include "SPI.h"
+#include "Adafruit_GFX.h"
+#include "Adafruit_ILI9341.h"
+#include "ILI9341_IndexedCanvas.h"
+
+// For the Adafruit shield, these are the default.
+#define TFT_DC 9
+#define TFT_CS 10
+
+#define RING_FIRST 16 // Palette entries used by the cycling rings
+#define RING_COUNT 32
+
+Adafruit_ILI9341 tft = Adafruit_ILI9341(TFT_CS, TFT_DC);
+ILI9341_IndexedCanvas canvas(tft);
+
+void setup() {
+  Serial.begin(9600);
+  tft.begin();
+  if (!canvas.begin()) {
+    Serial.println(F("Not enough RAM for the indexed canvas"));
+    while (1) yield();
+  }
+
+  // Entry 0 is the background, 1 the static text, then a rainbow ramp
+  canvas.setPaletteColor(0, ILI9341_BLACK);
+  canvas.setPaletteColor(1, ILI9341_WHITE);
+  for (uint8_t i = 0; i < RING_COUNT; i++) {
+    uint8_t r = (i < 16) ? i * 16 : (31 - i) * 16;
+    canvas.setPaletteColor(RING_FIRST + i, tft.color565(r, 255 - r, 128));
+  }
+
+  // Draw concentric rings, each ring using the next palette entry
+  int16_t cx = canvas.width() / 2, cy = canvas.height() / 2;
+  for (int16_t i = RING_COUNT * 3 - 1; i >= 0; i--)
+    canvas.fillCircle(cx, cy, 20 + i * 2, RING_FIRST + (i % RING_COUNT));
+  canvas.setTextColor(1);
+  canvas.setTextSize(2);
+  canvas.setCursor(10, 10);
+  canvas.print(F("Palette cycle"));
+  canvas.flush();
+}
+
+void loop() {
+  canvas.rotatePalette(RING_FIRST, RING_FIRST + RING_COUNT - 1);
+  uint32_t t = micros();
+  uint32_t pixels = canvas.flush();
+  t = micros() - t;
+  Serial.print(pixels);
+  Serial.print(F(" pixels resent in "));
+  Serial.print(t);
+  Serial.println(F(" us"));
+}
@@ -0,0 +1,71 @@
+// ILI9341 video wall example: four panels on one SPI bus, each with its own
+// CS pin and sharing DC, arranged 2 x 2 and drawn as one 640 x 480 canvas
+// with ILI9341_PanelGrid. Text, shapes and a ball that bounces across the
+// seams are drawn with ordinary Adafruit_GFX calls; each panel only gets
+// the part of every shape that falls on it. The time per frame is printed
+// over serial.
+
+#include "SPI.h"
+#include "Adafruit_GFX.h"
+#include "Adafruit_ILI9341.h"
+#include "ILI9341_PanelGrid.h"
+
+#define TFT_DC 9
+const uint8_t csPins[4] = {10, 8, 7, 6}; // Left to right, top to bottom
+
+Adafruit_ILI9341 tft0(10, TFT_DC), tft1(8, TFT_DC), tft2(7, TFT_DC),
+    tft3(6, TFT_DC);
+Adafruit_ILI9341 *panels[4] = {&tft0, &tft1, &tft2, &tft3};
+
+// Two panels across, two down, each in landscape (rotation 1)
+ILI9341_PanelGrid wall(panels, 2, 2, 1);
+
+#define BALL_R 24
+
+int16_t ballX = 100, ballY = 100, dx = 5, dy = 3;
+
+void setup() {
+  Serial.begin(9600);
+
+  // Deselect every panel before talking to any of them
+  for (uint8_t p = 0; p < 4; p++) {
+    pinMode(csPins[p], OUTPUT);
+    digitalWrite(csPins[p], HIGH);
+  }
+  wall.begin();
+
+  // One batch: each panel is selected once for the whole background
+  wall.startWrite();
+  wall.fillScreen(ILI9341_NAVY);
+  for (int16_t x = 0; x < wall.width(); x += 40)
+    wall.drawFastVLine(x, 0, wall.height(), ILI9341_DARKGREY);
+  for (int16_t y = 0; y < wall.height(); y += 40)
+    wall.drawFastHLine(0, y, wall.width(), ILI9341_DARKGREY);
+  wall.endWrite();
+
+  wall.setTextColor(ILI9341_WHITE);
+  wall.setTextSize(6);
+  wall.setCursor(wall.width() / 2 - 6 * 6 * 5 / 2, wall.height() / 2 - 24);
+  wall.print(F("HELLO"));
+  wall.drawCircle(wall.width() / 2, wall.height() / 2, 200, ILI9341_YELLOW);
+}
+
+void loop() {
+  uint32_t t = micros();
+
+  wall.startWrite();
+  wall.fillCircle(ballX, ballY, BALL_R, ILI9341_NAVY); // Erase
+  ballX += dx;
+  ballY += dy;
+  if ((ballX < BALL_R) || (ballX >= wall.width() - BALL_R))
+    dx = -dx;
+  if ((ballY < BALL_R) || (ballY >= wall.height() - BALL_R))
+    dy = -dy;
+  wall.fillCircle(ballX, ballY, BALL_R, ILI9341_RED);
+  wall.endWrite();
+
+  Serial.print(F("Frame: "));
+  Serial.print(micros() - t);
+  Serial.println(F(" us"));
+  delay(10);
+}
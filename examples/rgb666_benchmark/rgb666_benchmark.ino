@@ -0,0 +1,149 @@
+// ILI9341 pixel format benchmark: runs the graphicstest workloads once in
+// 16-bit (RGB565) mode and once in 18-bit (RGB666) mode and prints the time
+// for each. Finishes with an RGB888 gradient so the banding difference
+// between the two modes can be seen on the panel. For the bytes each
+// workload puts on the bus, run extras/host/benchmark/graphicstest_bench
+// with --pixfmt 16 and --pixfmt 18.
+
+#include "SPI.h"
+#include "Adafruit_GFX.h"
+#include "Adafruit_ILI9341.h"
+
+// For the Adafruit shield, these are the default.
+#define TFT_DC 9
+#define TFT_CS 10
+#define SPI_FREQ 24000000
+
+Adafruit_ILI9341 tft = Adafruit_ILI9341(TFT_CS, TFT_DC);
+
+void setup() {
+  Serial.begin(9600);
+  tft.begin(SPI_FREQ);
+
+  const uint8_t formats[2] = {ILI9341_PIXFMT_16BIT, ILI9341_PIXFMT_18BIT};
+  unsigned long t[2][6];
+  for (uint8_t f = 0; f < 2; f++) {
+    tft.setPixelFormat(formats[f]);
+    t[f][0] = testFillScreen();
+    t[f][1] = testText();
+    t[f][2] = testFastLines(ILI9341_RED, ILI9341_BLUE);
+    t[f][3] = testFilledRects(ILI9341_YELLOW, ILI9341_MAGENTA);
+    t[f][4] = testFilledCircles(10, ILI9341_MAGENTA);
+    t[f][5] = testGradient();
+  }
+
+  static const char *const names[6] = {
+      "Screen fill     ", "Text            ", "Horiz/Vert Lines",
+      "Rects (filled)  ", "Circles (filled)", "RGB888 gradient "};
+  Serial.println(F("Benchmark          565 (us)    666 (us)   ratio"));
+  for (uint8_t i = 0; i < 6; i++) {
+    Serial.print(names[i]);
+    Serial.print(F("  "));
+    Serial.print(t[0][i]);
+    Serial.print(F("  "));
+    Serial.print(t[1][i]);
+    Serial.print(F("  "));
+    Serial.println((float)t[1][i] / t[0][i], 2);
+  }
+}
+
+void loop(void) {
+  // Alternate the gradient between formats to compare banding by eye
+  tft.setPixelFormat(ILI9341_PIXFMT_16BIT);
+  testGradient();
+  delay(3000);
+  tft.setPixelFormat(ILI9341_PIXFMT_18BIT);
+  testGradient();
+  delay(3000);
+}
+
+unsigned long testFillScreen() {
+  unsigned long start = micros();
+  tft.fillScreen(ILI9341_BLACK);
+  tft.fillScreen(ILI9341_RED);
+  tft.fillScreen(ILI9341_GREEN);
+  tft.fillScreen(ILI9341_BLUE);
+  tft.fillScreen(ILI9341_BLACK);
+  return micros() - start;
+}
+
+unsigned long testText() {
+  tft.fillScreen(ILI9341_BLACK);
+  unsigned long start = micros();
+  tft.setCursor(0, 0);
+  tft.setTextColor(ILI9341_WHITE);  tft.setTextSize(1);
+  tft.println("Hello World!");
+  tft.setTextColor(ILI9341_YELLOW); tft.setTextSize(2);
+  tft.println(1234.56);
+  tft.setTextColor(ILI9341_RED);    tft.setTextSize(3);
+  tft.println(0xDEADBEEF, HEX);
+  tft.setTextColor(ILI9341_GREEN);
+  tft.setTextSize(5);
+  tft.println("Groop");
+  return micros() - start;
+}
+
+unsigned long testFastLines(uint16_t color1, uint16_t color2) {
+  unsigned long start;
+  int           x, y, w = tft.width(), h = tft.height();
+
+  tft.fillScreen(ILI9341_BLACK);
+  start = micros();
+  for(y=0; y<h; y+=5) tft.drawFastHLine(0, y, w, color1);
+  for(x=0; x<w; x+=5) tft.drawFastVLine(x, 0, h, color2);
+
+  return micros() - start;
+}
+
+unsigned long testFilledRects(uint16_t color1, uint16_t color2) {
+  unsigned long start, t = 0;
+  int           n, i, i2,
+                cx = tft.width()  / 2 - 1,
+                cy = tft.height() / 2 - 1;
+
+  tft.fillScreen(ILI9341_BLACK);
+  n = min(tft.width(), tft.height());
+  for(i=n; i>0; i-=6) {
+    i2    = i / 2;
+    start = micros();
+    tft.fillRect(cx-i2, cy-i2, i, i, color1);
+    t    += micros() - start;
+    tft.drawRect(cx-i2, cy-i2, i, i, color2);
+  }
+
+  return t;
+}
+
+unsigned long testFilledCircles(uint8_t radius, uint16_t color) {
+  unsigned long start;
+  int x, y, w = tft.width(), h = tft.height(), r2 = radius * 2;
+
+  tft.fillScreen(ILI9341_BLACK);
+  start = micros();
+  for(x=radius; x<w; x+=r2) {
+    for(y=radius; y<h; y+=r2) {
+      tft.fillCircle(x, y, radius, color);
+    }
+  }
+
+  return micros() - start;
+}
+
+// Smooth vertical ramps, one line at a time from an RGB888 buffer
+unsigned long testGradient() {
+  static uint8_t line[ILI9341_TFTWIDTH * 3];
+  unsigned long start = micros();
+  tft.startWrite();
+  tft.setAddrWindow(0, 0, ILI9341_TFTWIDTH, ILI9341_TFTHEIGHT);
+  for (uint16_t y = 0; y < ILI9341_TFTHEIGHT; y++) {
+    uint8_t v = (uint32_t)y * 255 / (ILI9341_TFTHEIGHT - 1);
+    for (uint16_t x = 0; x < ILI9341_TFTWIDTH; x++) {
+      line[x * 3] = (x < 80) ? v : 0;
+      line[x * 3 + 1] = (x >= 80 && x < 160) ? v : 0;
+      line[x * 3 + 2] = (x >= 160) ? v : (v / 4);
+    }
+    tft.writePixels888(line, ILI9341_TFTWIDTH);
+  }
+  tft.endWrite();
+  return micros() - start;
+}
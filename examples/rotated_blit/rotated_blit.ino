@@ -0,0 +1,52 @@
+// ILI9341 rotated blit example: one arrow bitmap drawn in all eight
+// orientations (four quarter turns, plain and mirrored). The panel's scan
+// direction is changed for each blit instead of rotating pixels in
+// software, so every orientation takes as long as a plain drawRGBBitmap().
+// The time for each is printed over serial.
+
+#include "SPI.h"
+#include "Adafruit_GFX.h"
+#include "Adafruit_ILI9341.h"
+
+// For the Adafruit shield, these are the default.
+#define TFT_DC 9
+#define TFT_CS 10
+
+#define ARROW_W 48
+#define ARROW_H 24
+
+Adafruit_ILI9341 tft = Adafruit_ILI9341(TFT_CS, TFT_DC);
+uint16_t arrow[ARROW_W * ARROW_H];
+
+void setup() {
+  Serial.begin(9600);
+  tft.begin();
+  tft.fillScreen(ILI9341_BLACK);
+
+  // An arrow pointing right, with a green top half so mirroring shows
+  for (int16_t y = 0; y < ARROW_H; y++) {
+    for (int16_t x = 0; x < ARROW_W; x++) {
+      int16_t d = abs(y - ARROW_H / 2);
+      bool shaft = (x < ARROW_W / 2) && (d < ARROW_H / 6);
+      bool head = (x >= ARROW_W / 2) && (d < ARROW_W - x);
+      uint16_t c = (y < ARROW_H / 2) ? ILI9341_GREEN : ILI9341_ORANGE;
+      arrow[y * ARROW_W + x] = (shaft || head) ? c : ILI9341_NAVY;
+    }
+  }
+
+  for (uint8_t mirror = 0; mirror < 2; mirror++) {
+    for (uint8_t rot = 0; rot < 4; rot++) {
+      int16_t x = 8 + rot * 58, y = 40 + mirror * 120;
+      uint32_t t = micros();
+      tft.drawRGBBitmapRotated(x, y, arrow, ARROW_W, ARROW_H, rot, mirror);
+      t = micros() - t;
+      Serial.print(F("rot "));
+      Serial.print(rot * 90);
+      Serial.print(mirror ? F(" mirrored: ") : F(": "));
+      Serial.print(t);
+      Serial.println(F(" us"));
+    }
+  }
+}
+
+void loop() {}
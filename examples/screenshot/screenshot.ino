@@ -0,0 +1,39 @@
+// ILI9341 screenshot example: send 'p' over the serial monitor for a PPM
+// screenshot or 'r' for a smaller run-length encoded one (convert it with
+// extras/screenshot_decode). Capture the raw serial output to a file, e.g.
+//   stty -F /dev/ttyACM0 raw 115200; cat /dev/ttyACM0 > shot.ppm
+// Needs the TFT's MISO pin connected.
+
+#include "SPI.h"
+#include "Adafruit_GFX.h"
+#include "Adafruit_ILI9341.h"
+
+// For the Adafruit shield, these are the default.
+#define TFT_DC 9
+#define TFT_CS 10
+
+Adafruit_ILI9341 tft = Adafruit_ILI9341(TFT_CS, TFT_DC);
+
+void setup() {
+  Serial.begin(115200);
+  tft.begin();
+  tft.setRotation(1);
+  tft.fillScreen(ILI9341_NAVY);
+  for (int16_t r = 100; r > 0; r -= 10)
+    tft.fillCircle(tft.width() / 2, tft.height() / 2, r,
+                   tft.color565(255 - r * 2, r * 2, 128));
+  tft.setCursor(10, 10);
+  tft.setTextSize(2);
+  tft.print(F("Screenshot me"));
+}
+
+void loop() {
+  if (!Serial.available())
+    return;
+  char c = Serial.read();
+  if ((c == 'p') || (c == 'r')) {
+    if (!tft.dumpScreen(Serial,
+                        (c == 'p') ? ILI9341_DUMP_PPM : ILI9341_DUMP_RLE565))
+      tft.print(F(" no RAM!"));
+  }
+}
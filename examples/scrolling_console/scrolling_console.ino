@@ -0,0 +1,60 @@
+// ILI9341 console example: a log viewer with a fixed title bar and status
+// line. The middle of the screen scrolls in hardware, so each new line
+// only costs drawing that line. Anything typed into the serial monitor is
+// echoed, including ANSI colour codes.
+
+#include "SPI.h"
+#include "Adafruit_GFX.h"
+#include "Adafruit_ILI9341.h"
+#include "ILI9341_Console.h"
+
+// For the Adafruit shield, these are the default.
+#define TFT_DC 9
+#define TFT_CS 10
+
+#define TITLE_H 16
+#define STATUS_H 16
+
+Adafruit_ILI9341 tft = Adafruit_ILI9341(TFT_CS, TFT_DC);
+ILI9341_Console console(tft, TITLE_H, STATUS_H);
+
+uint32_t lineCount = 0;
+
+void setup() {
+  Serial.begin(9600);
+  tft.begin();
+  console.begin();
+
+  tft.fillRect(0, 0, tft.width(), TITLE_H, ILI9341_NAVY);
+  tft.setTextColor(ILI9341_WHITE);
+  tft.setCursor(4, 4);
+  tft.print(F("Field log"));
+
+  // begin() may have grown the status area to fit whole text lines
+  tft.fillRect(0, console.bottomAreaTop(), tft.width(),
+               tft.height() - console.bottomAreaTop(), ILI9341_DARKGREY);
+}
+
+void loop() {
+  while (Serial.available())
+    console.write(Serial.read());
+
+  static uint32_t last = 0;
+  if (millis() - last >= 250) {
+    last = millis();
+    lineCount++;
+    if (lineCount % 10 == 0)
+      console.print(F("\x1b[1;33mWARN\x1b[0m "));
+    else
+      console.print(F("\x1b[32mINFO\x1b[0m "));
+    console.print(F("sample "));
+    console.print(lineCount);
+    console.print(F(" value="));
+    console.println(analogRead(A0));
+
+    tft.setTextColor(ILI9341_WHITE, ILI9341_DARKGREY);
+    tft.setCursor(4, console.bottomAreaTop() + 4);
+    tft.print(F("Lines: "));
+    tft.print(lineCount);
+  }
+}
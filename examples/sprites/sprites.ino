@@ -0,0 +1,96 @@
+// ILI9341 sprite layer example: balls bouncing over a grid with no frame
+// buffer. Each frame only the rectangles covering the balls' old and new
+// positions are rebuilt from the background callback and the sprites,
+// and each goes out as one address window. The frame rate is printed
+// every 64 frames.
+
+#include "SPI.h"
+#include "Adafruit_GFX.h"
+#include "Adafruit_ILI9341.h"
+#include "ILI9341_SpriteLayer.h"
+
+// For the Adafruit shield, these are the default.
+#define TFT_DC 9
+#define TFT_CS 10
+
+#define BALLS 6
+#define BALL_SIZE 24
+#define BGCOLOR 0x18E3
+#define GRIDCOLOR 0x4A69
+#define KEY 0xF81F // Transparent colour of the ball image
+
+Adafruit_ILI9341 tft = Adafruit_ILI9341(TFT_CS, TFT_DC);
+ILI9341_SpriteLayer sprites(tft);
+
+uint16_t ball[BALL_SIZE * BALL_SIZE];
+int16_t bx[BALLS], by[BALLS], vx[BALLS], vy[BALLS];
+uint32_t startTime, frame = 0;
+
+// A 16-pixel grid, computed for whatever part of a line is asked for.
+void grid(uint16_t *line, int16_t x, int16_t y, uint16_t w, void *arg) {
+  bool rowLine = !(y & 15);
+  for (uint16_t i = 0; i < w; i++)
+    line[i] = (rowLine || !((x + i) & 15)) ? GRIDCOLOR : BGCOLOR;
+}
+
+void setup() {
+  Serial.begin(9600);
+  tft.begin();
+  tft.setRotation(1);
+
+  // Shaded ball with transparent corners
+  const int16_t r = BALL_SIZE / 2;
+  for (int16_t y = 0; y < BALL_SIZE; y++) {
+    for (int16_t x = 0; x < BALL_SIZE; x++) {
+      int16_t dx = x - r, dy = y - r, d2 = dx * dx + dy * dy;
+      uint8_t shade = 255 - min(d2 * 200 / (r * r), 200);
+      ball[y * BALL_SIZE + x] =
+          (d2 < r * r) ? tft.color565(shade, shade / 4, shade / 2) : KEY;
+    }
+  }
+
+  sprites.setBackground(grid);
+  if (!sprites.begin(BALLS)) {
+    Serial.println(F("Not enough RAM for sprites"));
+    while (1) yield();
+  }
+  for (uint8_t i = 0; i < BALLS; i++) {
+    sprites.addSprite(ball, BALL_SIZE, BALL_SIZE, KEY);
+    bx[i] = random(tft.width() - BALL_SIZE);
+    by[i] = random(tft.height() - BALL_SIZE);
+    vx[i] = random(1, 4) * (random(2) ? 1 : -1);
+    vy[i] = random(1, 4) * (random(2) ? 1 : -1);
+  }
+
+  // Draw the whole background once; after that only sprites are redrawn
+  uint16_t line[ILI9341_TFTHEIGHT];
+  tft.startWrite();
+  tft.setAddrWindow(0, 0, tft.width(), tft.height());
+  for (int16_t y = 0; y < tft.height(); y++) {
+    grid(line, 0, y, tft.width(), NULL);
+    tft.writePixels(line, tft.width());
+  }
+  tft.endWrite();
+  startTime = millis();
+}
+
+void loop() {
+  for (uint8_t i = 0; i < BALLS; i++) {
+    bx[i] += vx[i];
+    by[i] += vy[i];
+    if ((bx[i] < 0) || (bx[i] > tft.width() - BALL_SIZE))
+      vx[i] = -vx[i];
+    if ((by[i] < 0) || (by[i] > tft.height() - BALL_SIZE))
+      vy[i] = -vy[i];
+    sprites.moveTo(i, bx[i], by[i]);
+  }
+  sprites.update();
+
+  if (!(++frame & 63)) {
+    uint32_t now = millis();
+    Serial.print(frame * 1000 / (now - startTime));
+    Serial.println(F(" fps"));
+    frame = 0;
+    startTime = now;
+  }
+}
@@ -0,0 +1,74 @@
+// ILI9341 strip chart example: two telemetry traces rolling across a
+// landscape screen. Each sample writes one 240-pixel column and moves the
+// panel's hardware scroll start line, so the history never has to be
+// redrawn. The axis labels on the left and the legend on the right sit in
+// fixed areas that do not scroll. Every 200 samples a waterfall-style
+// colour bar is pushed with addColumn(). The time per sample is printed
+// over serial.
+
+#include "SPI.h"
+#include "Adafruit_GFX.h"
+#include "Adafruit_ILI9341.h"
+#include "ILI9341_StripChart.h"
+
+// For the Adafruit shield, these are the default.
+#define TFT_DC 9
+#define TFT_CS 10
+
+#define AXIS_W 30   // Fixed columns on the left for labels
+#define LEGEND_W 40 // Fixed columns on the right for the legend
+
+Adafruit_ILI9341 tft = Adafruit_ILI9341(TFT_CS, TFT_DC);
+ILI9341_StripChart chart(tft, AXIS_W, LEGEND_W);
+
+uint32_t sample = 0, busy = 0;
+
+void setup() {
+  Serial.begin(9600);
+  tft.begin();
+  tft.setRotation(1);
+  tft.fillScreen(ILI9341_BLACK);
+
+  chart.begin(ILI9341_BLACK);
+  chart.setRange(-100, 100);
+  chart.setGrid(ILI9341_DARKGREY, 30, 40);
+  chart.setSeriesColor(0, ILI9341_YELLOW);
+  chart.setSeriesColor(1, ILI9341_CYAN);
+
+  // Axis labels every 50 units, on every other grid line
+  tft.setTextColor(ILI9341_WHITE);
+  for (int16_t v = -100; v <= 100; v += 50) {
+    tft.setCursor(0, (int16_t)((100 - v) * (tft.height() - 1) / 200) - 3);
+    tft.print(v);
+  }
+  int16_t x = tft.width() - LEGEND_W + 4;
+  tft.setTextColor(ILI9341_YELLOW);
+  tft.setCursor(x, 8);
+  tft.print(F("temp"));
+  tft.setTextColor(ILI9341_CYAN);
+  tft.setCursor(x, 20);
+  tft.print(F("load"));
+}
+
+void loop() {
+  float values[2];
+  values[0] = 60 * sin(sample * 0.02) + random(-5, 6);
+  values[1] = 40 * sin(sample * 0.07 + 1) - 20;
+
+  uint32_t t = micros();
+  if ((sample % 200) == 199) {
+    uint16_t bar[ILI9341_TFTWIDTH];
+    for (int16_t y = 0; y < tft.height(); y++)
+      bar[y] = tft.color565(y, 255 - y, 128);
+    chart.addColumn(bar);
+  } else {
+    chart.addSample(values, 2);
+  }
+  busy += micros() - t;
+
+  if (!(++sample % 100)) {
+    Serial.print(busy / 100);
+    Serial.println(F(" us/sample"));
+    busy = 0;
+  }
+}
@@ -0,0 +1,53 @@
+// ILI9341 tearing-effect example: a pair of bars sweep across the screen,
+// written through ILI9341_TearingScheduler so each band is sent only while
+// the panel is not refreshing it. Wire the panel's TE pad to TFT_TE for
+// locked updates, or set TFT_TE to -1 to use the frame-rate model alone.
+
+#include "SPI.h"
+#include "Adafruit_GFX.h"
+#include "Adafruit_ILI9341.h"
+#include "ILI9341_TearingScheduler.h"
+
+// For the Adafruit shield, these are the default.
+#define TFT_DC 9
+#define TFT_CS 10
+#define TFT_TE 2
+
+#define BAR_W 24
+
+Adafruit_ILI9341 tft = Adafruit_ILI9341(TFT_CS, TFT_DC);
+ILI9341_TearingScheduler scheduler(tft, TFT_TE);
+
+// One column of each bar; a bar is this column repeated, so a single
+// 1-pixel-wide strip per rectangle edge is enough to move it
+uint16_t leading[ILI9341_TFTHEIGHT], trailing[ILI9341_TFTHEIGHT];
+int16_t pos = 0;
+
+void setup() {
+  Serial.begin(9600);
+  tft.begin();
+  tft.fillScreen(ILI9341_BLACK);
+  tft.setFrameRate(50);
+  for (uint16_t y = 0; y < ILI9341_TFTHEIGHT; y++) {
+    leading[y] = tft.color565(255, y * 255 / ILI9341_TFTHEIGHT, 0);
+    trailing[y] = ILI9341_BLACK;
+  }
+  scheduler.begin();
+}
+
+void loop() {
+  // Each step paints the new leading column and erases the old trailing
+  // one. A rectangle's pixels are row-major, so a 1 x h strip is just the
+  // column array.
+  ILI9341_Rect rects[2] = {
+      {(int16_t)((pos + BAR_W) % tft.width()), 0, 1, tft.height(), leading},
+      {pos, 0, 1, tft.height(), trailing}};
+  scheduler.submit(rects, 2);
+  pos = (pos + 1) % tft.width();
+
+  if (!pos) {
+    Serial.print(F("Waited "));
+    Serial.print(scheduler.lastWaitMicros());
+    Serial.println(F(" us in the last update"));
+  }
+}
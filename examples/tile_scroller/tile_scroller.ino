@@ -0,0 +1,79 @@
+// ILI9341 tile map example: an endless top-down map built from 8x8 tiles
+// in flash. Scrolling down the map only moves the panel's hardware scroll
+// start line and draws the rows that came into view; every few seconds
+// the view also steps sideways, which redraws the whole screen. The number
+// of pixels sent per frame is printed every 64 frames.
+
+#include "SPI.h"
+#include "Adafruit_GFX.h"
+#include "Adafruit_ILI9341.h"
+#include "ILI9341_TileMap.h"
+
+// For the Adafruit shield, these are the default.
+#define TFT_DC 9
+#define TFT_CS 10
+
+#define MAP_W 32 // Map size in tiles
+#define MAP_H 64
+
+Adafruit_ILI9341 tft = Adafruit_ILI9341(TFT_CS, TFT_DC);
+ILI9341_TileMap tiles(tft);
+
+// Four 8x8 tiles, 2 bits per pixel, 2 bytes per row: grass, water,
+// brick and path.
+const uint8_t tileset[] PROGMEM = {
+    0x00, 0x00, 0x04, 0x10, 0x00, 0x00, 0x40, 0x04, // Grass
+    0x00, 0x00, 0x01, 0x00, 0x00, 0x40, 0x00, 0x00, //
+    0xAA, 0xAA, 0xAA, 0xAA, 0xBA, 0xAA, 0xAF, 0xAA, // Water
+    0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xBA, 0xAA, 0xAF, //
+    0xFF, 0xFF, 0x55, 0x57, 0x55, 0x57, 0xFF, 0xFF, // Brick
+    0xFF, 0xFF, 0x57, 0x55, 0x57, 0x55, 0xFF, 0xFF, //
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, // Path
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, //
+};
+
+uint16_t palette[4] = {0x2444, 0x8C51, 0x1A7B, 0xC618};
+uint8_t map_[MAP_W * MAP_H];
+int32_t scrollX = 0, scrollY = 0;
+uint32_t frame = 0, pixels = 0;
+
+void setup() {
+  Serial.begin(9600);
+  tft.begin();
+
+  // A river, a path and some walls on grass
+  for (uint8_t y = 0; y < MAP_H; y++) {
+    uint8_t river = 8 + 4 * sin(y * 2 * PI / MAP_H);
+    for (uint8_t x = 0; x < MAP_W; x++) {
+      uint8_t t = 0;
+      if ((x >= river) && (x < river + 3))
+        t = 1;
+      else if (x == 20)
+        t = 3;
+      else if (((y & 15) == 4) && (x > 22) && (x < 30))
+        t = 2;
+      map_[y * MAP_W + x] = t;
+    }
+  }
+
+  tiles.setTiles(tileset, 2, 8, palette);
+  tiles.setMap(map_, MAP_W, MAP_H);
+  if (!tiles.begin()) {
+    Serial.println(F("Not enough RAM for line buffers"));
+    while (1) yield();
+  }
+}
+
+void loop() {
+  scrollY += 2;
+  if (!(frame & 255))
+    scrollX += 8;
+  tiles.scrollTo(scrollX, scrollY);
+  pixels += tiles.update();
+
+  if (!(++frame & 63)) {
+    Serial.print(pixels / 64);
+    Serial.println(F(" pixels/frame"));
+    pixels = 0;
+  }
+}
@@ -0,0 +1,2 @@
+// Host stand-in: Adafruit_GFX.h includes Adafruit BusIO, which the
+// emulator does not need.
@@ -0,0 +1,368 @@
+/*!
+ * @file Adafruit_SPITFT.cpp
+ *
+ * Host stand-in for Adafruit_SPITFT. Drawing logic mirrors the real class
+ * (clipping, window setup, pixel streaming) so traffic counts match what
+ * the driver produces on hardware.
+ */
+
+#include "Adafruit_SPITFT.h"
+
+Adafruit_SPITFT::Adafruit_SPITFT(uint16_t w, uint16_t h, int8_t cs, int8_t dc,
+                                 int8_t mosi, int8_t sck, int8_t rst,
+                                 int8_t miso)
+    : Adafruit_GFX(w, h), connection(TFT_SOFT_SPI), _rst(rst), _cs(cs),
+      _dc(dc) {
+  (void)mosi;
+  (void)sck;
+  (void)miso;
+  hwspi._spi = NULL;
+  hwspi._mode = SPI_MODE0;
+  tft8.wide = false;
+}
+
+Adafruit_SPITFT::Adafruit_SPITFT(uint16_t w, uint16_t h, int8_t cs, int8_t dc,
+                                 int8_t rst)
+    : Adafruit_SPITFT(w, h, &SPI, cs, dc, rst) {}
+
+Adafruit_SPITFT::Adafruit_SPITFT(uint16_t w, uint16_t h, SPIClass *spiClass,
+                                 int8_t cs, int8_t dc, int8_t rst)
+    : Adafruit_GFX(w, h), connection(TFT_HARD_SPI), _rst(rst), _cs(cs),
+      _dc(dc) {
+  hwspi._spi = spiClass;
+  hwspi._mode = SPI_MODE0;
+  tft8.wide = false;
+}
+
+Adafruit_SPITFT::Adafruit_SPITFT(uint16_t w, uint16_t h, tftBusWidth busWidth,
+                                 int8_t d0, int8_t wr, int8_t dc, int8_t cs,
+                                 int8_t rst, int8_t rd)
+    : Adafruit_GFX(w, h), connection(TFT_PARALLEL), _rst(rst), _cs(cs),
+      _dc(dc) {
+  (void)d0;
+  (void)wr;
+  (void)rd;
+  hwspi._spi = NULL;
+  hwspi._mode = SPI_MODE0;
+  tft8.wide = (busWidth == tft16bitbus);
+}
+
+void Adafruit_SPITFT::initSPI(uint32_t freq, uint8_t spiMode) {
+  if (!freq)
+    freq = 24000000;
+  hwspi.settings = SPISettings(freq, MSBFIRST, spiMode);
+  hwspi._mode = spiMode;
+  if (_rst >= 0) { // Same pulse train as the real initSPI()
+    digitalWrite(_rst, HIGH);
+    delay(100);
+    digitalWrite(_rst, LOW);
+    if (_hostBus)
+      _hostBus->reset();
+    delay(100);
+    digitalWrite(_rst, HIGH);
+    delay(200);
+  }
+}
+
+void Adafruit_SPITFT::setSPISpeed(uint32_t freq) {
+  hwspi.settings = SPISettings(freq, MSBFIRST, hwspi._mode);
+}
+
+void Adafruit_SPITFT::hostTransfer(bool dc, uint8_t b, bool strobe) {
+  if (_hostBus) {
+    if (dc)
+      _hostBus->data(b);
+    else
+      _hostBus->command(b);
+  }
+  if (connection == TFT_PARALLEL) {
+    if (strobe)
+      ArduinoHost::advance(_hostCycleNs);
+  } else {
+    ArduinoHost::advance(8000000000ULL / hwspi.settings._clock);
+  }
+}
+
+void Adafruit_SPITFT::startWrite(void) {
+  SPI_BEGIN_TRANSACTION();
+  if (_cs >= 0)
+    SPI_CS_LOW();
+}
+
+void Adafruit_SPITFT::endWrite(void) {
+  if (_cs >= 0)
+    SPI_CS_HIGH();
+  SPI_END_TRANSACTION();
+}
+
+void Adafruit_SPITFT::SPI_CS_HIGH(void) {
+  if (_hostBus)
+    _hostBus->select(false);
+}
+
+void Adafruit_SPITFT::SPI_CS_LOW(void) {
+  if (_hostBus)
+    _hostBus->select(true);
+}
+
+void Adafruit_SPITFT::sendCommand(uint8_t commandByte, uint8_t *dataBytes,
+                                  uint8_t numDataBytes) {
+  sendCommand(commandByte, (const uint8_t *)dataBytes, numDataBytes);
+}
+
+void Adafruit_SPITFT::sendCommand(uint8_t commandByte,
+                                  const uint8_t *dataBytes,
+                                  uint8_t numDataBytes) {
+  SPI_BEGIN_TRANSACTION();
+  if (_cs >= 0)
+    SPI_CS_LOW();
+  SPI_DC_LOW();
+  spiWrite(commandByte);
+  SPI_DC_HIGH();
+  for (int i = 0; i < numDataBytes; i++)
+    spiWrite(pgm_read_byte(dataBytes++));
+  if (_cs >= 0)
+    SPI_CS_HIGH();
+  SPI_END_TRANSACTION();
+}
+
+void Adafruit_SPITFT::sendCommand16(uint16_t commandWord,
+                                    const uint8_t *dataBytes,
+                                    uint8_t numDataBytes) {
+  SPI_BEGIN_TRANSACTION();
+  if (_cs >= 0)
+    SPI_CS_LOW();
+  writeCommand16(commandWord);
+  for (int i = 0; i < numDataBytes; i++)
+    write16(pgm_read_byte(dataBytes++));
+  if (_cs >= 0)
+    SPI_CS_HIGH();
+  SPI_END_TRANSACTION();
+}
+
+uint8_t Adafruit_SPITFT::readcommand8(uint8_t commandByte, uint8_t index) {
+  uint8_t result;
+  startWrite();
+  SPI_DC_LOW();
+  spiWrite(commandByte);
+  SPI_DC_HIGH();
+  do {
+    result = spiRead();
+  } while (index--);
+  endWrite();
+  return result;
+}
+
+uint16_t Adafruit_SPITFT::readcommand16(uint16_t addr) {
+  startWrite();
+  writeCommand16(addr);
+  uint16_t result = read16();
+  endWrite();
+  return result;
+}
+
+void Adafruit_SPITFT::writePixel(uint16_t color) { SPI_WRITE16(color); }
+
+void Adafruit_SPITFT::writePixels(uint16_t *colors, uint32_t len, bool block,
+                                  bool bigEndian) {
+  (void)block;
+  while (len--) {
+    uint16_t c = *colors++;
+    if (bigEndian)
+      c = (c << 8) | (c >> 8);
+    SPI_WRITE16(c);
+  }
+}
+
+void Adafruit_SPITFT::writeColor(uint16_t color, uint32_t len) {
+  while (len--)
+    SPI_WRITE16(color);
+}
+
+void Adafruit_SPITFT::writePixel(int16_t x, int16_t y, uint16_t color) {
+  if ((x >= 0) && (x < _width) && (y >= 0) && (y < _height)) {
+    setAddrWindow(x, y, 1, 1);
+    SPI_WRITE16(color);
+  }
+}
+
+// Clip a rectangle to the screen; false if nothing is left. Like the real
+// class, the fill and line functions clip for themselves and go straight
+// to writeFillRectPreclipped() instead of through the virtual functions.
+bool Adafruit_SPITFT::hostClip(int16_t &x, int16_t &y, int16_t &w,
+                               int16_t &h) const {
+  if (w < 0) {
+    x += w + 1;
+    w = -w;
+  }
+  if (h < 0) {
+    y += h + 1;
+    h = -h;
+  }
+  if (x < 0) {
+    w += x;
+    x = 0;
+  }
+  if (y < 0) {
+    h += y;
+    y = 0;
+  }
+  if (x + w > _width)
+    w = _width - x;
+  if (y + h > _height)
+    h = _height - y;
+  return (w > 0) && (h > 0);
+}
+
+void Adafruit_SPITFT::writeFillRect(int16_t x, int16_t y, int16_t w,
+                                    int16_t h, uint16_t color) {
+  if (hostClip(x, y, w, h))
+    writeFillRectPreclipped(x, y, w, h, color);
+}
+
+void Adafruit_SPITFT::writeFastHLine(int16_t x, int16_t y, int16_t w,
+                                     uint16_t color) {
+  int16_t h = 1;
+  if (hostClip(x, y, w, h))
+    writeFillRectPreclipped(x, y, w, 1, color);
+}
+
+void Adafruit_SPITFT::writeFastVLine(int16_t x, int16_t y, int16_t h,
+                                     uint16_t color) {
+  int16_t w = 1;
+  if (hostClip(x, y, w, h))
+    writeFillRectPreclipped(x, y, 1, h, color);
+}
+
+void Adafruit_SPITFT::swapBytes(uint16_t *src, uint32_t len, uint16_t *dest) {
+  if (!dest)
+    dest = src;
+  for (uint32_t i = 0; i < len; i++)
+    dest[i] = (src[i] << 8) | (src[i] >> 8);
+}
+
+void Adafruit_SPITFT::drawPixel(int16_t x, int16_t y, uint16_t color) {
+  if ((x >= 0) && (x < _width) && (y >= 0) && (y < _height)) {
+    startWrite();
+    setAddrWindow(x, y, 1, 1);
+    SPI_WRITE16(color);
+    endWrite();
+  }
+}
+
+void Adafruit_SPITFT::fillRect(int16_t x, int16_t y, int16_t w, int16_t h,
+                               uint16_t color) {
+  if (hostClip(x, y, w, h)) {
+    startWrite();
+    writeFillRectPreclipped(x, y, w, h, color);
+    endWrite();
+  }
+}
+
+void Adafruit_SPITFT::drawFastHLine(int16_t x, int16_t y, int16_t w,
+                                    uint16_t color) {
+  int16_t h = 1;
+  if (hostClip(x, y, w, h)) {
+    startWrite();
+    writeFillRectPreclipped(x, y, w, 1, color);
+    endWrite();
+  }
+}
+
+void Adafruit_SPITFT::drawFastVLine(int16_t x, int16_t y, int16_t h,
+                                    uint16_t color) {
+  int16_t w = 1;
+  if (hostClip(x, y, w, h)) {
+    startWrite();
+    writeFillRectPreclipped(x, y, 1, h, color);
+    endWrite();
+  }
+}
+
+void Adafruit_SPITFT::pushColor(uint16_t color) {
+  startWrite();
+  SPI_WRITE16(color);
+  endWrite();
+}
+
+void Adafruit_SPITFT::drawRGBBitmap(int16_t x, int16_t y, uint16_t *pcolors,
+                                    int16_t w, int16_t h) {
+  int16_t x2, y2;
+  if ((x >= _width) || (y >= _height) || ((x2 = (x + w - 1)) < 0) ||
+      ((y2 = (y + h - 1)) < 0))
+    return;
+  int16_t bx1 = 0, by1 = 0, saveW = w;
+  if (x < 0) {
+    w += x;
+    bx1 = -x;
+    x = 0;
+  }
+  if (y < 0) {
+    h += y;
+    by1 = -y;
+    y = 0;
+  }
+  if (x2 >= _width)
+    w = _width - x;
+  if (y2 >= _height)
+    h = _height - y;
+  pcolors += by1 * saveW + bx1;
+  startWrite();
+  setAddrWindow(x, y, w, h);
+  while (h--) {
+    writePixels(pcolors, w);
+    pcolors += saveW;
+  }
+  endWrite();
+}
+
+void Adafruit_SPITFT::invertDisplay(bool i) {
+  startWrite();
+  writeCommand(i ? invertOnCommand : invertOffCommand);
+  endWrite();
+}
+
+uint16_t Adafruit_SPITFT::color565(uint8_t red, uint8_t green, uint8_t blue) {
+  return ((red & 0xF8) << 8) | ((green & 0xFC) << 3) | (blue >> 3);
+}
+
+void Adafruit_SPITFT::spiWrite(uint8_t b) { hostTransfer(_dcData, b); }
+
+void Adafruit_SPITFT::writeCommand(uint8_t cmd) {
+  SPI_DC_LOW();
+  spiWrite(cmd);
+  SPI_DC_HIGH();
+}
+
+uint8_t Adafruit_SPITFT::spiRead(void) {
+  uint8_t b = _hostBus ? _hostBus->read() : 0;
+  if (connection == TFT_PARALLEL)
+    ArduinoHost::advance(_hostCycleNs * 2); // Read strobes are slower
+  else
+    ArduinoHost::advance(8000000000ULL / hwspi.settings._clock);
+  return b;
+}
+
+void Adafruit_SPITFT::write16(uint16_t w) { SPI_WRITE16(w); }
+
+void Adafruit_SPITFT::writeCommand16(uint16_t cmd) {
+  SPI_DC_LOW();
+  SPI_WRITE16(cmd);
+  SPI_DC_HIGH();
+}
+
+uint16_t Adafruit_SPITFT::read16(void) {
+  uint16_t hi = spiRead();
+  return (hi << 8) | spiRead();
+}
+
+void Adafruit_SPITFT::SPI_WRITE16(uint16_t w) {
+  // A 16-bit parallel bus moves both bytes in a single strobe
+  hostTransfer(_dcData, w >> 8);
+  hostTransfer(_dcData, w & 0xFF, !tft8.wide);
+}
+
+void Adafruit_SPITFT::SPI_WRITE32(uint32_t l) {
+  SPI_WRITE16(l >> 16);
+  SPI_WRITE16(l & 0xFFFF);
+}
@@ -0,0 +1,189 @@
+/*!
+ * @file Adafruit_SPITFT.h
+ *
+ * Host stand-in for Adafruit_GFX's Adafruit_SPITFT. It keeps the public and
+ * protected interface the ILI9341 driver relies on, but instead of driving
+ * pins it hands every command, data and read cycle to an attached
+ * ILI9341_HostBus device (normally an ILI9341_Emulator) and advances the
+ * simulated clock by the modelled bus time.
+ *
+ * Put this directory ahead of the Adafruit_GFX checkout on the include path
+ * so this header wins over the real one; do not compile the real
+ * Adafruit_SPITFT.cpp.
+ */
+
+#ifndef _ADAFRUIT_SPITFT_H_
+#define _ADAFRUIT_SPITFT_H_
+
+#include "Adafruit_GFX.h"
+#include <SPI.h>
+
+/// Parallel bus width selector, as in the real Adafruit_SPITFT
+enum tftBusWidth { tft8bitbus, tft16bitbus };
+
+/*!
+  @brief  A device sitting on the emulated display bus.
+*/
+class ILI9341_HostBus {
+public:
+  virtual ~ILI9341_HostBus() {}
+  /*!
+    @brief  Chip select edge.
+    @param  active  true when CS goes low.
+  */
+  virtual void select(bool active) = 0;
+  /*!
+    @brief  One byte clocked in with D/C low.
+    @param  cmd  Command byte.
+  */
+  virtual void command(uint8_t cmd) = 0;
+  /*!
+    @brief  One byte clocked in with D/C high.
+    @param  b  Data byte.
+  */
+  virtual void data(uint8_t b) = 0;
+  /*!
+    @brief  One byte clocked out of the controller.
+    @return Byte read.
+  */
+  virtual uint8_t read(void) = 0;
+  /*!
+    @brief  Hardware reset line asserted.
+  */
+  virtual void reset(void) = 0;
+};
+
+/*!
+  @brief  Emulated Adafruit_SPITFT: same drawing behaviour as the real class,
+          with bus traffic routed to an ILI9341_HostBus.
+*/
+class Adafruit_SPITFT : public Adafruit_GFX {
+public:
+  Adafruit_SPITFT(uint16_t w, uint16_t h, int8_t cs, int8_t dc, int8_t mosi,
+                  int8_t sck, int8_t rst = -1, int8_t miso = -1);
+  Adafruit_SPITFT(uint16_t w, uint16_t h, int8_t cs, int8_t dc,
+                  int8_t rst = -1);
+  Adafruit_SPITFT(uint16_t w, uint16_t h, SPIClass *spiClass, int8_t cs,
+                  int8_t dc, int8_t rst = -1);
+  Adafruit_SPITFT(uint16_t w, uint16_t h, tftBusWidth busWidth, int8_t d0,
+                  int8_t wr, int8_t dc, int8_t cs = -1, int8_t rst = -1,
+                  int8_t rd = -1);
+  virtual ~Adafruit_SPITFT() {}
+
+  virtual void begin(uint32_t freq) = 0;
+  virtual void setAddrWindow(uint16_t x, uint16_t y, uint16_t w,
+                             uint16_t h) = 0;
+
+  void initSPI(uint32_t freq = 0, uint8_t spiMode = SPI_MODE0);
+  void setSPISpeed(uint32_t freq);
+  void startWrite(void);
+  void endWrite(void);
+  void sendCommand(uint8_t commandByte, uint8_t *dataBytes,
+                   uint8_t numDataBytes);
+  void sendCommand(uint8_t commandByte, const uint8_t *dataBytes = NULL,
+                   uint8_t numDataBytes = 0);
+  void sendCommand16(uint16_t commandWord, const uint8_t *dataBytes = NULL,
+                     uint8_t numDataBytes = 0);
+  uint8_t readcommand8(uint8_t commandByte, uint8_t index = 0);
+  uint16_t readcommand16(uint16_t addr);
+
+  void writePixel(uint16_t color);
+  void writePixels(uint16_t *colors, uint32_t len, bool block = true,
+                   bool bigEndian = false);
+  void writeColor(uint16_t color, uint32_t len);
+  void writePixel(int16_t x, int16_t y, uint16_t color);
+  void writeFillRect(int16_t x, int16_t y, int16_t w, int16_t h,
+                     uint16_t color);
+  void writeFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color);
+  void writeFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color);
+  void writeFillRectPreclipped(int16_t x, int16_t y, int16_t w, int16_t h,
+                               uint16_t color) {
+    setAddrWindow(x, y, w, h);
+    writeColor(color, (uint32_t)w * h);
+  }
+  void dmaWait(void) {}
+  bool dmaBusy(void) const { return false; }
+  void swapBytes(uint16_t *src, uint32_t len, uint16_t *dest = NULL);
+
+  void drawPixel(int16_t x, int16_t y, uint16_t color);
+  void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+  void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color);
+  void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color);
+  void pushColor(uint16_t color);
+
+  using Adafruit_GFX::drawRGBBitmap;
+  void drawRGBBitmap(int16_t x, int16_t y, uint16_t *pcolors, int16_t w,
+                     int16_t h);
+
+  void invertDisplay(bool i);
+  uint16_t color565(uint8_t r, uint8_t g, uint8_t b);
+
+  void spiWrite(uint8_t b);
+  void writeCommand(uint8_t cmd);
+  uint8_t spiRead(void);
+  void write16(uint16_t w);
+  void writeCommand16(uint16_t cmd);
+  uint16_t read16(void);
+
+  void SPI_WRITE16(uint16_t w);
+  void SPI_WRITE32(uint32_t l);
+  void SPI_CS_HIGH(void);
+  void SPI_CS_LOW(void);
+  void SPI_DC_HIGH(void) { _dcData = true; }
+  void SPI_DC_LOW(void) { _dcData = false; }
+
+  /*!
+    @brief  Attach the emulated controller this instance talks to.
+    @param  bus  Device, or NULL to detach.
+  */
+  void attachHostBus(ILI9341_HostBus *bus) { _hostBus = bus; }
+  /*!
+    @brief  Time for one parallel write strobe, used by the bus model.
+    @param  ns  Nanoseconds per 8- or 16-bit write cycle.
+  */
+  void setHostParallelCycle(uint32_t ns) { _hostCycleNs = ns; }
+  /*!
+    @brief  Model a different bus than the one the constructor chose, e.g.
+            to time the same sketch on SPI and on a parallel interface.
+    @param  width  0 for SPI, 8 or 16 for a parallel bus of that width.
+  */
+  void setHostBusWidth(uint8_t width) {
+    connection = width ? TFT_PARALLEL : TFT_HARD_SPI;
+    tft8.wide = (width == 16);
+  }
+
+protected:
+  void SPI_BEGIN_TRANSACTION(void) {}
+  void SPI_END_TRANSACTION(void) {}
+  void hostTransfer(bool dc, uint8_t b, bool strobe = true);
+  bool hostClip(int16_t &x, int16_t &y, int16_t &w, int16_t &h) const;
+
+  /// Interface type, as in the real Adafruit_SPITFT
+  enum { TFT_HARD_SPI = 0, TFT_SOFT_SPI, TFT_PARALLEL };
+
+  struct {
+    SPIClass *_spi;       ///< SPI class pointer
+    SPISettings settings; ///< SPI transaction settings
+    uint32_t _mode;       ///< SPI data mode
+  } hwspi;                ///< Hardware SPI values
+  struct {
+    bool wide; ///< If true, is 16-bit interface
+  } tft8;      ///< Parallel interface settings
+
+  uint8_t connection;          ///< TFT_HARD_SPI, TFT_SOFT_SPI, etc.
+  int8_t _rst;                 ///< Reset pin # (or -1)
+  int8_t _cs;                  ///< Chip select pin # (or -1)
+  int8_t _dc;                  ///< Data/command pin #
+  int16_t _xstart = 0;         ///< Internal framebuffer X offset
+  int16_t _ystart = 0;         ///< Internal framebuffer Y offset
+  uint8_t invertOnCommand = 0; ///< Command to enable invert mode
+  uint8_t invertOffCommand = 0; ///< Command to disable invert mode
+  uint32_t _freq = 0;          ///< Dummy var to keep subclasses happy
+
+private:
+  ILI9341_HostBus *_hostBus = NULL;
+  uint32_t _hostCycleNs = 66;
+  bool _dcData = true;
+};
+
+#endif // _ADAFRUIT_SPITFT_H_
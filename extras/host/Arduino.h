@@ -0,0 +1,111 @@
+/*!
+ * @file Arduino.h
+ *
+ * Host (Linux/macOS) stand-in for the Arduino core, just large enough to
+ * compile Adafruit_GFX and this library against the ILI9341 emulator.
+ * Time is simulated: micros()/millis() advance with modelled bus traffic
+ * and delay() calls rather than with the wall clock.
+ */
+
+#ifndef _ILI9341_HOST_ARDUINO_H_
+#define _ILI9341_HOST_ARDUINO_H_
+
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef bool boolean;
+typedef uint8_t byte;
+
+#define HIGH 0x1
+#define LOW 0x0
+#define INPUT 0x0
+#define OUTPUT 0x1
+#define INPUT_PULLUP 0x2
+
+#define PI 3.1415926535897932384626433832795
+
+#define PROGMEM
+#define PSTR(s) (s)
+#define F(s) (s)
+#define pgm_read_byte(addr) (*(const uint8_t *)(addr))
+#define pgm_read_word(addr) (*(const uint16_t *)(addr))
+#define pgm_read_dword(addr) (*(const uint32_t *)(addr))
+#define pgm_read_pointer(addr) ((void *)*(void *const *)(addr))
+
+#ifndef __FlashStringHelper
+class __FlashStringHelper;
+#endif
+
+template <class T, class U> static inline T min(T a, U b) {
+  return (b < a) ? (T)b : a;
+}
+template <class T, class U> static inline T max(T a, U b) {
+  return (a < b) ? (T)b : a;
+}
+
+uint32_t micros(void);
+uint32_t millis(void);
+void delay(uint32_t ms);
+void delayMicroseconds(uint32_t us);
+void yield(void);
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t val);
+int digitalRead(uint8_t pin);
+void randomSeed(unsigned long seed);
+long random(long howbig);
+long random(long howsmall, long howbig);
+
+/*!
+  @brief  Host-only hooks into the simulated clock and pin state.
+*/
+namespace ArduinoHost {
+uint64_t nanos(void);             ///< Simulated time in nanoseconds
+void advance(uint64_t ns);        ///< Move simulated time forward
+void setPinReader(int (*fn)(uint8_t pin));
+void setPinWriter(void (*fn)(uint8_t pin, uint8_t val)); ///< Observe digitalWrite()
+} // namespace ArduinoHost
+
+/*!
+  @brief  Just enough of Arduino's String for Adafruit_GFX::getTextBounds().
+*/
+class String {
+public:
+  /*!
+    @brief  Wrap a C string (not copied).
+    @param  s  NUL-terminated text that outlives this object.
+  */
+  String(const char *s = "") : _s(s) {}
+  /*!
+    @brief  The text.
+    @return NUL-terminated characters.
+  */
+  const char *c_str(void) const { return _s; }
+  /*!
+    @brief  Length of the text.
+    @return Characters, excluding the terminator.
+  */
+  unsigned int length(void) const { return strlen(_s); }
+
+private:
+  const char *_s;
+};
+
+#include "Print.h"
+
+/*!
+  @brief  Serial port stand-in: output goes to stdout, input is empty.
+*/
+class HostSerial : public Stream {
+public:
+  void begin(unsigned long) {}
+  size_t write(uint8_t c);
+  using Print::write;
+  operator bool(void) { return true; }
+};
+
+extern HostSerial Serial; ///< The sketch's serial port
+
+#endif // _ILI9341_HOST_ARDUINO_H_
@@ -0,0 +1,439 @@
+/*!
+ * @file ILI9341_Emulator.cpp
+ *
+ * Host-side ILI9341 controller model.
+ */
+
+#include "ILI9341_Emulator.h"
+#include <stdio.h>
+
+#define EMU_OSC_HZ 615000UL ///< Internal oscillator, datasheet typical
+#define EMU_PORCH_LINES 4   ///< Default VFP + VBP (2 + 2 lines)
+
+/*!
+    @brief  Construct a powered-on controller with blank GRAM.
+*/
+ILI9341_Emulator::ILI9341_Emulator(void) : _selected(true) {
+  memset(_gram, 0, sizeof _gram);
+  clearCounters();
+  powerOn();
+}
+
+/*!
+    @brief  Connect this controller to a driver instance.
+    @param  tft  Driver whose bus traffic should be decoded here.
+*/
+void ILI9341_Emulator::attach(Adafruit_SPITFT &tft) { tft.attachHostBus(this); }
+
+/*!
+    @brief  Return registers to their power-on/reset defaults.
+            GRAM contents are undefined after reset and are left alone.
+*/
+void ILI9341_Emulator::powerOn(void) {
+  _cmd = 0;
+  _argIdx = _pixIdx = _readIdx = 0;
+  _readDummy = false;
+  _madctl = 0x00;
+  _pixfmt = 0x66;
+  _sc = _sp = 0;
+  _ec = ILI9341_EMU_WIDTH - 1;
+  _ep = ILI9341_EMU_HEIGHT - 1;
+  _c = _p = 0;
+  _tfa = 0;
+  _vsa = ILI9341_EMU_HEIGHT;
+  _bfa = 0;
+  _vsp = 0;
+  _ptlStart = 0;
+  _ptlEnd = ILI9341_EMU_HEIGHT - 1;
+  _partial = _idle = _invert = _dispOn = _te = false;
+  _sleep = true;
+  for (uint8_t i = 0; i < 3; i++) {
+    _frmctr[i][0] = 0x00;
+    _frmctr[i][1] = 0x1B;
+  }
+  _frameOrigin = _resetAt = ArduinoHost::nanos();
+  _busyUntil = _frameOrigin + 5000000ULL; // 5 ms after reset
+}
+
+// A panel without a CS pin is never deselected, so traffic counts as
+// selected until the first CS edge.
+void ILI9341_Emulator::select(bool active) {
+  if (active)
+    _count.selects++;
+  _selected = active;
+}
+
+void ILI9341_Emulator::reset(void) { powerOn(); }
+
+void ILI9341_Emulator::command(uint8_t cmd) {
+  if (!_selected) {
+    _count.unselected++;
+    return;
+  }
+  _count.commands++;
+  _count.perCommand[cmd]++;
+  if (ArduinoHost::nanos() < _busyUntil)
+    _count.early++;
+  _cmd = cmd;
+  _argIdx = 0;
+  _pixIdx = 0;
+  switch (cmd) {
+  case 0x01: // SWRESET
+    powerOn();
+    break;
+  case 0x10: // SLPIN
+    _sleep = true;
+    break;
+  case 0x11: // SLPOUT, not allowed for 120 ms after a reset
+    if ((ArduinoHost::nanos() < _resetAt + 120000000ULL) &&
+        (ArduinoHost::nanos() >= _busyUntil))
+      _count.early++;
+    _sleep = false;
+    _busyUntil = ArduinoHost::nanos() + 5000000ULL;
+    break;
+  case 0x12: // PTLON
+    _partial = true;
+    break;
+  case 0x13: // NORON
+    _partial = false;
+    break;
+  case 0x20: // INVOFF
+    _invert = false;
+    break;
+  case 0x21: // INVON
+    _invert = true;
+    break;
+  case 0x28: // DISPOFF
+    _dispOn = false;
+    break;
+  case 0x29: // DISPON
+    _dispOn = true;
+    break;
+  case 0x2C: // RAMWR restarts at the window origin
+    _c = _sc;
+    _p = _sp;
+    break;
+  case 0x2E: // RAMRD
+    _c = _sc;
+    _p = _sp;
+    _readDummy = true;
+    _readIdx = 0;
+    break;
+  case 0x34: // TEOFF
+    _te = false;
+    break;
+  case 0x35: // TEON
+    _te = true;
+    break;
+  case 0x38: // IDMOFF
+    _idle = false;
+    break;
+  case 0x39: // IDMON
+    _idle = true;
+    break;
+  }
+}
+
+void ILI9341_Emulator::data(uint8_t b) {
+  if (!_selected) {
+    _count.unselected++;
+    return;
+  }
+  if ((_cmd == 0x2C) || (_cmd == 0x3C)) { // RAMWR, RAMWRC
+    _count.pixelBytes++;
+    _pix[_pixIdx++] = b;
+    if ((_pixfmt & 0x07) == 0x06) { // 18 bpp, 3 bytes/pixel
+      if (_pixIdx == 3) {
+        storePixel(((_pix[0] & 0xF8) << 8) | ((_pix[1] & 0xFC) << 3) |
+                   (_pix[2] >> 3));
+        _pixIdx = 0;
+      }
+    } else if (_pixIdx == 2) { // 16 bpp
+      storePixel((_pix[0] << 8) | _pix[1]);
+      _pixIdx = 0;
+    }
+    return;
+  }
+  _count.paramBytes++;
+  if (_argIdx < sizeof _args)
+    _args[_argIdx] = b;
+  _argIdx++;
+  switch (_cmd) {
+  case 0x2A: // CASET
+    if (_argIdx == 4) {
+      _sc = (_args[0] << 8) | _args[1];
+      _ec = (_args[2] << 8) | _args[3];
+    }
+    break;
+  case 0x2B: // PASET
+    if (_argIdx == 4) {
+      _sp = (_args[0] << 8) | _args[1];
+      _ep = (_args[2] << 8) | _args[3];
+    }
+    break;
+  case 0x30: // PTLAR
+    if (_argIdx == 4) {
+      _ptlStart = (_args[0] << 8) | _args[1];
+      _ptlEnd = (_args[2] << 8) | _args[3];
+    }
+    break;
+  case 0x33: // VSCRDEF
+    if (_argIdx == 6) {
+      _tfa = (_args[0] << 8) | _args[1];
+      _vsa = (_args[2] << 8) | _args[3];
+      _bfa = (_args[4] << 8) | _args[5];
+    }
+    break;
+  case 0x36: // MADCTL
+    _madctl = b;
+    break;
+  case 0x37: // VSCRSADD
+    if (_argIdx == 2)
+      _vsp = (_args[0] << 8) | _args[1];
+    break;
+  case 0x3A: // COLMOD
+    _pixfmt = b;
+    break;
+  case 0xB1: // FRMCTR1..3
+  case 0xB2:
+  case 0xB3:
+    if (_argIdx <= 2)
+      _frmctr[_cmd - 0xB1][_argIdx - 1] = b;
+    break;
+  }
+}
+
+uint8_t ILI9341_Emulator::read(void) {
+  if (!_selected) {
+    _count.unselected++;
+    return 0;
+  }
+  _count.readBytes++;
+  if (_cmd == 0x2E) { // RAMRD: dummy byte, then 3 bytes/pixel (R, G, B)
+    if (_readDummy) {
+      _readDummy = false;
+      return 0;
+    }
+    if (_readIdx == 0) {
+      uint16_t col, row;
+      _readPix = mapAddress(_c, _p, col, row) ? _gram[row][col] : 0;
+      advancePointer();
+    }
+    uint8_t b;
+    switch (_readIdx) {
+    case 0:
+      b = (_readPix >> 8) & 0xF8;
+      break;
+    case 1:
+      b = (_readPix >> 3) & 0xFC;
+      break;
+    default:
+      b = (_readPix << 3) & 0xF8;
+      break;
+    }
+    _readIdx = (_readIdx + 1) % 3;
+    return b;
+  }
+  switch (_cmd) {
+  case 0x0A: // RDMODE
+    return (_sleep ? 0x00 : 0x10) | (_dispOn ? 0x04 : 0x00) |
+           (_partial ? 0x00 : 0x08) | (_idle ? 0x40 : 0x00) | 0x80;
+  case 0x0B: // RDMADCTL
+    return _madctl;
+  case 0x0C: // RDPIXFMT
+    return _pixfmt;
+  case 0x45: { // Get scanline
+    uint16_t l = scanLine();
+    uint8_t b = (_argIdx++ == 1) ? (l >> 8) : (l & 0xFF);
+    return b;
+  }
+  }
+  return 0;
+}
+
+/*!
+    @brief  Clear all traffic counters.
+*/
+void ILI9341_Emulator::clearCounters(void) { memset(&_count, 0, sizeof _count); }
+
+// Map an address-counter position to GRAM. MX/MY mirror the column/page
+// counters before MV exchanges them, as on the real controller.
+bool ILI9341_Emulator::mapAddress(uint16_t c, uint16_t p, uint16_t &col,
+                                  uint16_t &row) const {
+  bool mv = _madctl & 0x20;
+  uint16_t cmax = mv ? ILI9341_EMU_HEIGHT - 1 : ILI9341_EMU_WIDTH - 1;
+  uint16_t pmax = mv ? ILI9341_EMU_WIDTH - 1 : ILI9341_EMU_HEIGHT - 1;
+  if ((c > cmax) || (p > pmax))
+    return false;
+  if (_madctl & 0x40)
+    c = cmax - c;
+  if (_madctl & 0x80)
+    p = pmax - p;
+  if (mv) {
+    row = c;
+    col = p;
+  } else {
+    col = c;
+    row = p;
+  }
+  return true;
+}
+
+void ILI9341_Emulator::advancePointer(void) {
+  if (_c < _ec) {
+    _c++;
+  } else {
+    _c = _sc;
+    _p = (_p < _ep) ? _p + 1 : _sp;
+  }
+}
+
+void ILI9341_Emulator::storePixel(uint16_t c) {
+  uint16_t col, row;
+  if (mapAddress(_c, _p, col, row)) {
+    _gram[row][col] = c;
+    _count.pixels++;
+  }
+  advancePointer();
+}
+
+/*!
+    @brief  Read GRAM directly.
+    @param  col  GRAM column (0-239).
+    @param  row  GRAM row (0-319).
+    @return RGB565 value stored there.
+*/
+uint16_t ILI9341_Emulator::gramPixel(uint16_t col, uint16_t row) const {
+  return ((col < ILI9341_EMU_WIDTH) && (row < ILI9341_EMU_HEIGHT))
+             ? _gram[row][col]
+             : 0;
+}
+
+/*!
+    @brief  What a viewer sees, in rotation 0 coordinates. Applies the
+            panel's mirrored source wiring, vertical scroll, partial and
+            idle modes, inversion and sleep/display-off.
+    @param  x  Column (0-239).
+    @param  y  Row (0-319).
+    @return RGB565 colour of that pixel on the glass.
+*/
+uint16_t ILI9341_Emulator::visiblePixel(int16_t x, int16_t y) const {
+  if ((x < 0) || (x >= ILI9341_EMU_WIDTH) || (y < 0) ||
+      (y >= ILI9341_EMU_HEIGHT) || _sleep || !_dispOn)
+    return 0;
+  if (_partial) {
+    bool inside = (_ptlStart <= _ptlEnd)
+                      ? ((y >= _ptlStart) && (y <= _ptlEnd))
+                      : ((y >= _ptlStart) || (y <= _ptlEnd));
+    if (!inside)
+      return 0;
+  }
+  uint16_t row = y;
+  if (_vsa && (y >= _tfa) && (y < _tfa + _vsa) && (_vsp >= _tfa) &&
+      (_vsp < _tfa + _vsa))
+    row = _tfa + ((y - _tfa) + (_vsp - _tfa)) % _vsa;
+  uint16_t c = _gram[row][ILI9341_EMU_WIDTH - 1 - x];
+  if (_invert)
+    c = ~c;
+  if (_idle) // 8 colours: only the MSB of each channel survives
+    c = ((c & 0x8000) ? 0xF800 : 0) | ((c & 0x0400) ? 0x07E0 : 0) |
+        ((c & 0x0010) ? 0x001F : 0);
+  return c;
+}
+
+/*!
+    @brief  What a viewer sees at a position given in the coordinates of a
+            screen rotation, laid out as Adafruit_ILI9341::setRotation()
+            does, so a check can compare with what it drew directly.
+    @param  rotation  Screen rotation, 0-3.
+    @param  x         Column in that rotation.
+    @param  y         Row in that rotation.
+    @return RGB565 colour of that pixel on the glass.
+*/
+uint16_t ILI9341_Emulator::visiblePixel(uint8_t rotation, int16_t x,
+                                        int16_t y) const {
+  switch (rotation & 3) {
+  case 0:
+    return visiblePixel(x, y);
+  case 1:
+    return visiblePixel(ILI9341_EMU_WIDTH - 1 - y, x);
+  case 2:
+    return visiblePixel(ILI9341_EMU_WIDTH - 1 - x, ILI9341_EMU_HEIGHT - 1 - y);
+  default:
+    return visiblePixel(y, ILI9341_EMU_HEIGHT - 1 - x);
+  }
+}
+
+/*!
+    @brief  Save the visible image as a binary PPM.
+    @param  path  Output file name.
+    @return true on success.
+*/
+bool ILI9341_Emulator::writePPM(const char *path) const {
+  FILE *f = fopen(path, "wb");
+  if (!f)
+    return false;
+  fprintf(f, "P6\n%d %d\n255\n", ILI9341_EMU_WIDTH, ILI9341_EMU_HEIGHT);
+  for (int16_t y = 0; y < ILI9341_EMU_HEIGHT; y++) {
+    for (int16_t x = 0; x < ILI9341_EMU_WIDTH; x++) {
+      uint16_t c = visiblePixel(x, y);
+      uint8_t rgb[3] = {(uint8_t)(((c >> 11) * 255) / 31),
+                        (uint8_t)((((c >> 5) & 0x3F) * 255) / 63),
+                        (uint8_t)(((c & 0x1F) * 255) / 31)};
+      fwrite(rgb, 1, 3, f);
+    }
+  }
+  return fclose(f) == 0;
+}
+
+/*!
+    @brief  FNV-1a hash of the visible image, for regression checks.
+    @return 32-bit checksum.
+*/
+uint32_t ILI9341_Emulator::visibleChecksum(void) const {
+  uint32_t h = 2166136261UL;
+  for (int16_t y = 0; y < ILI9341_EMU_HEIGHT; y++) {
+    for (int16_t x = 0; x < ILI9341_EMU_WIDTH; x++) {
+      uint16_t c = visiblePixel(x, y);
+      h = (h ^ (c & 0xFF)) * 16777619UL;
+      h = (h ^ (c >> 8)) * 16777619UL;
+    }
+  }
+  return h;
+}
+
+uint16_t ILI9341_Emulator::rowsPerFrame(void) const {
+  return ILI9341_EMU_HEIGHT + EMU_PORCH_LINES;
+}
+
+/*!
+    @brief  Frame period implied by the active FRMCTR register.
+    @return Nanoseconds per frame.
+*/
+uint32_t ILI9341_Emulator::frameNanos(void) const {
+  const uint8_t *f = _frmctr[_idle ? 1 : (_partial ? 2 : 0)];
+  uint32_t clocksPerLine = f[1] & 0x1F;
+  if (clocksPerLine < 0x10)
+    clocksPerLine = 0x10;
+  uint32_t div = 1UL << (f[0] & 0x03);
+  return (uint32_t)((uint64_t)clocksPerLine * div * rowsPerFrame() *
+                    1000000000ULL / EMU_OSC_HZ);
+}
+
+/*!
+    @brief  Gate line the panel is refreshing right now (simulated time).
+            Values >= 320 are in vertical blanking.
+    @return Scan line.
+*/
+uint16_t ILI9341_Emulator::scanLine(void) const {
+  uint64_t t = (ArduinoHost::nanos() - _frameOrigin) % frameNanos();
+  return (uint16_t)(t * rowsPerFrame() / frameNanos());
+}
+
+/*!
+    @brief  Level of the TE output (mode 1: high during V-blank only).
+    @return true while TE is high.
+*/
+bool ILI9341_Emulator::tearingLevel(void) const {
+  return _te && (scanLine() >= ILI9341_EMU_HEIGHT);
+}
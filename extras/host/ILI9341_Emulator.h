@@ -0,0 +1,120 @@
+/*!
+ * @file ILI9341_Emulator.h
+ *
+ * Host-side model of the ILI9341 controller. It decodes the command stream
+ * produced by the real driver (through the emulated Adafruit_SPITFT), keeps
+ * a 240x320 GRAM, applies MADCTL, vertical scrolling, partial/idle modes
+ * and inversion to produce the visible image, and counts every bus byte.
+ */
+
+#ifndef _ILI9341_EMULATOR_H_
+#define _ILI9341_EMULATOR_H_
+
+#include "Adafruit_SPITFT.h"
+
+#define ILI9341_EMU_WIDTH 240  ///< GRAM columns
+#define ILI9341_EMU_HEIGHT 320 ///< GRAM rows (gate lines)
+
+/*!
+  @brief  Traffic counters kept by the emulator.
+*/
+typedef struct {
+  uint32_t selects;       ///< CS low edges (bus transactions)
+  uint32_t commands;      ///< Command bytes
+  uint32_t paramBytes;    ///< Data bytes that were not pixel data
+  uint32_t pixelBytes;    ///< Data bytes written after RAMWR/RAMWRC
+  uint32_t readBytes;     ///< Bytes clocked out of the controller
+  uint32_t pixels;        ///< Pixels stored to GRAM
+  uint32_t early;         ///< Commands sent inside a reset/SLPOUT wait,
+                          ///< or SLPOUT within 120 ms of a reset
+  uint32_t unselected;    ///< Bytes ignored because CS was high
+  uint32_t perCommand[256]; ///< Command byte histogram
+} ILI9341_EmulatorCounters;
+
+/*!
+  @brief  Emulated ILI9341 attached to an Adafruit_SPITFT host bus.
+*/
+class ILI9341_Emulator : public ILI9341_HostBus {
+public:
+  ILI9341_Emulator(void);
+
+  void attach(Adafruit_SPITFT &tft);
+  void powerOn(void);
+
+  // ILI9341_HostBus
+  void select(bool active);
+  void command(uint8_t cmd);
+  void data(uint8_t b);
+  uint8_t read(void);
+  void reset(void);
+
+  uint16_t gramPixel(uint16_t col, uint16_t row) const;
+  uint16_t visiblePixel(int16_t x, int16_t y) const;
+  uint16_t visiblePixel(uint8_t rotation, int16_t x, int16_t y) const;
+  bool writePPM(const char *path) const;
+  uint32_t visibleChecksum(void) const;
+
+  uint16_t scanLine(void) const;
+  bool tearingLevel(void) const;
+  uint32_t frameNanos(void) const;
+
+  /*!
+    @brief  Access the traffic counters.
+    @return Reference to counters since the last clearCounters().
+  */
+  const ILI9341_EmulatorCounters &counters(void) const { return _count; }
+  void clearCounters(void);
+
+  /*!
+    @brief  Current MADCTL register value.
+    @return MADCTL byte.
+  */
+  uint8_t madctl(void) const { return _madctl; }
+  /*!
+    @brief  Current COLMOD register value.
+    @return Pixel format byte.
+  */
+  uint8_t pixelFormat(void) const { return _pixfmt; }
+  /*!
+    @brief  Whether the panel is in sleep mode.
+    @return true if sleeping.
+  */
+  bool sleeping(void) const { return _sleep; }
+  /*!
+    @brief  Whether the display output is on.
+    @return true if DISPON is in effect.
+  */
+  bool displayOn(void) const { return _dispOn; }
+
+private:
+  void storePixel(uint16_t c);
+  void advancePointer(void);
+  bool mapAddress(uint16_t c, uint16_t p, uint16_t &col, uint16_t &row) const;
+  uint16_t rowsPerFrame(void) const;
+
+  uint16_t _gram[ILI9341_EMU_HEIGHT][ILI9341_EMU_WIDTH];
+  ILI9341_EmulatorCounters _count;
+
+  bool _selected;         // CS is low, or was never driven
+  uint8_t _cmd;           // Command whose parameters are arriving
+  uint8_t _argIdx;        // Parameter byte index
+  uint8_t _args[16];      // Parameter bytes of the current command
+  uint8_t _pixIdx;        // Byte index within the current pixel
+  uint8_t _pix[3];        // Pixel bytes being assembled
+  bool _readDummy;        // RAMRD dummy byte pending
+  uint8_t _readIdx;       // Byte index within the pixel being read
+  uint16_t _readPix;      // Pixel being read out
+
+  uint8_t _madctl, _pixfmt;
+  uint16_t _sc, _ec, _sp, _ep; // Column/page window
+  uint16_t _c, _p;             // Write/read pointer
+  uint16_t _tfa, _vsa, _bfa, _vsp;
+  uint16_t _ptlStart, _ptlEnd;
+  bool _partial, _idle, _invert, _sleep, _dispOn, _te;
+  uint8_t _frmctr[3][2]; // FRMCTR1..3: DIVA, RTNA
+  uint64_t _frameOrigin; // Simulated time of a frame start
+  uint64_t _busyUntil;   // No commands before this (reset/SLPOUT wait)
+  uint64_t _resetAt;     // Simulated time of the last reset
+};
+
+#endif // _ILI9341_EMULATOR_H_
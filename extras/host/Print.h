@@ -0,0 +1,59 @@
+/*!
+ * @file Print.h
+ *
+ * Host stand-in for the Arduino Print and Stream classes.
+ */
+
+#ifndef _ILI9341_HOST_PRINT_H_
+#define _ILI9341_HOST_PRINT_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define DEC 10
+#define HEX 16
+#define OCT 8
+#define BIN 2
+
+/*!
+  @brief  Minimal Print: formatting helpers funnel into write(uint8_t).
+*/
+class Print {
+public:
+  virtual ~Print() {}
+  virtual size_t write(uint8_t c) = 0;
+  virtual size_t write(const uint8_t *buffer, size_t size);
+  virtual int availableForWrite(void) { return 0; }
+  size_t write(const char *str);
+  size_t print(const char *s);
+  size_t print(char c);
+  size_t print(long n, int base = DEC);
+  size_t print(unsigned long n, int base = DEC);
+  size_t print(int n, int base = DEC) { return print((long)n, base); }
+  size_t print(unsigned int n, int base = DEC) {
+    return print((unsigned long)n, base);
+  }
+  size_t print(double n, int digits = 2);
+  size_t println(void);
+  template <class T> size_t println(T v) {
+    size_t n = print(v);
+    return n + println();
+  }
+  template <class T> size_t println(T v, int fmt) {
+    size_t n = print(v, fmt);
+    return n + println();
+  }
+};
+
+/*!
+  @brief  Minimal Stream: adds the read side to Print.
+*/
+class Stream : public Print {
+public:
+  virtual int available(void) { return 0; }
+  virtual int read(void) { return -1; }
+  virtual int peek(void) { return -1; }
+  virtual void flush(void) {}
+};
+
+#endif // _ILI9341_HOST_PRINT_H_
@@ -0,0 +1,50 @@
+/*!
+ * @file SPI.h
+ *
+ * Host stand-in for the Arduino SPI library. The emulated Adafruit_SPITFT
+ * never touches it; it only exists so sketches and headers compile.
+ */
+
+#ifndef _ILI9341_HOST_SPI_H_
+#define _ILI9341_HOST_SPI_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define SPI_HAS_TRANSACTION 1
+#define SPI_MODE0 0x00
+#define SPI_MODE1 0x04
+#define SPI_MODE2 0x08
+#define SPI_MODE3 0x0C
+#define MSBFIRST 1
+#define LSBFIRST 0
+
+/*!
+  @brief  SPI transaction settings (clock, bit order, mode).
+*/
+class SPISettings {
+public:
+  SPISettings(uint32_t clock = 4000000, uint8_t order = MSBFIRST,
+              uint8_t mode = SPI_MODE0)
+      : _clock(clock), _order(order), _mode(mode) {}
+  uint32_t _clock; ///< Bit clock in Hz
+  uint8_t _order;  ///< Bit order
+  uint8_t _mode;   ///< SPI mode
+};
+
+/*!
+  @brief  Do-nothing SPI peripheral.
+*/
+class SPIClass {
+public:
+  void begin(void) {}
+  void end(void) {}
+  void beginTransaction(SPISettings) {}
+  void endTransaction(void) {}
+  uint8_t transfer(uint8_t) { return 0; }
+  void transfer(void *, size_t) {}
+};
+
+extern SPIClass SPI;
+
+#endif // _ILI9341_HOST_SPI_H_
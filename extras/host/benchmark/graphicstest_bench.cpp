@@ -0,0 +1,158 @@
+/*!
+ * @file graphicstest_bench.cpp
+ *
+ * Runs the examples/graphicstest workloads against the host emulator and
+ * reports, per test, the modelled bus time, command count, bus bytes,
+ * transactions and a checksum of the resulting image. The output is CSV
+ * or JSON so runs can be diffed between commits.
+ *
+ * Usage: graphicstest_bench [--freq HZ] [--bus spi|8|16] [--cycle NS]
+ *                           [--pixfmt 16|18] [--rotation 0-3]
+ *                           [--format csv|json]
+ *
+ * Times are bus time only (plus 1 us per yield() the tests make): the CPU
+ * time spent in Adafruit_GFX is not modelled.
+ */
+
+#include "Adafruit_ILI9341.h"
+#include "ILI9341_Emulator.h"
+#include <stdio.h>
+#include <string.h>
+
+// Prototypes the Arduino builder would generate for the sketch
+unsigned long testFillScreen();
+unsigned long testText();
+unsigned long testLines(uint16_t color);
+unsigned long testFastLines(uint16_t color1, uint16_t color2);
+unsigned long testRects(uint16_t color);
+unsigned long testFilledRects(uint16_t color1, uint16_t color2);
+unsigned long testFilledCircles(uint8_t radius, uint16_t color);
+unsigned long testCircles(uint8_t radius, uint16_t color);
+unsigned long testTriangles();
+unsigned long testFilledTriangles();
+unsigned long testRoundRects();
+unsigned long testFilledRoundRects();
+
+#include "../../../examples/graphicstest/graphicstest.ino"
+
+static ILI9341_Emulator panel;
+
+/// One benchmark row
+typedef struct {
+  const char *name;               ///< Test name
+  uint64_t nanos;                 ///< Modelled time
+  ILI9341_EmulatorCounters count; ///< Bus traffic
+  uint32_t checksum;              ///< Visible image afterwards
+} Result;
+
+static void usage(void) {
+  fprintf(stderr, "usage: graphicstest_bench [--freq HZ] [--bus spi|8|16] "
+                  "[--cycle NS]\n                          [--pixfmt 16|18] "
+                  "[--rotation 0-3] [--format csv|json]\n");
+}
+
+int main(int argc, char **argv) {
+  uint32_t freq = 24000000, cycle = 66;
+  uint8_t width = 0, rotation = 0, pixfmt = ILI9341_PIXFMT_16BIT;
+  bool json = false;
+
+  for (int i = 1; i < argc; i++) {
+    const char *opt = argv[i], *val = (i + 1 < argc) ? argv[i + 1] : NULL;
+    if (!val) {
+      usage();
+      return 2;
+    }
+    i++;
+    if (!strcmp(opt, "--freq")) {
+      freq = strtoul(val, NULL, 0);
+    } else if (!strcmp(opt, "--bus")) {
+      width = strcmp(val, "spi") ? atoi(val) : 0;
+      if (width && (width != 8) && (width != 16)) {
+        usage();
+        return 2;
+      }
+    } else if (!strcmp(opt, "--cycle")) {
+      cycle = strtoul(val, NULL, 0);
+    } else if (!strcmp(opt, "--pixfmt")) {
+      pixfmt =
+          (atoi(val) == 18) ? ILI9341_PIXFMT_18BIT : ILI9341_PIXFMT_16BIT;
+    } else if (!strcmp(opt, "--rotation")) {
+      rotation = atoi(val) & 3;
+    } else if (!strcmp(opt, "--format")) {
+      json = !strcmp(val, "json");
+    } else {
+      usage();
+      return 2;
+    }
+  }
+
+  panel.attach(tft);
+  tft.setHostBusWidth(width);
+  tft.setHostParallelCycle(cycle);
+  tft.begin(freq);
+  tft.setPixelFormat(pixfmt);
+  pixfmt = tft.getPixelFormat(); // A 16-bit bus stays at 16 bits
+  tft.setRotation(rotation);
+
+  static Result results[12];
+  uint8_t n = 0;
+#define RUN(label, call)                                                       \
+  do {                                                                         \
+    panel.clearCounters();                                                     \
+    uint64_t t0 = ArduinoHost::nanos();                                        \
+    call;                                                                      \
+    results[n].name = label;                                                   \
+    results[n].nanos = ArduinoHost::nanos() - t0;                              \
+    results[n].count = panel.counters();                                       \
+    results[n++].checksum = panel.visibleChecksum();                           \
+  } while (0)
+
+  RUN("fill_screen", testFillScreen());
+  RUN("text", testText());
+  RUN("lines", testLines(ILI9341_CYAN));
+  RUN("fast_lines", testFastLines(ILI9341_RED, ILI9341_BLUE));
+  RUN("rects", testRects(ILI9341_GREEN));
+  RUN("filled_rects", testFilledRects(ILI9341_YELLOW, ILI9341_MAGENTA));
+  RUN("filled_circles", testFilledCircles(10, ILI9341_MAGENTA));
+  RUN("circles", testCircles(10, ILI9341_WHITE));
+  RUN("triangles", testTriangles());
+  RUN("filled_triangles", testFilledTriangles());
+  RUN("round_rects", testRoundRects());
+  RUN("filled_round_rects", testFilledRoundRects());
+#undef RUN
+
+  const char *bus = width ? ((width == 16) ? "16" : "8") : "spi";
+  if (json) {
+    printf("{\"bus\": \"%s\", \"freq\": %lu, \"cycle_ns\": %lu, "
+           "\"pixfmt\": %d, \"rotation\": %d, \"results\": [\n",
+           bus, (unsigned long)freq, (unsigned long)cycle,
+           (pixfmt == ILI9341_PIXFMT_18BIT) ? 18 : 16, rotation);
+  } else {
+    printf("test,bus,freq,pixfmt,rotation,micros,commands,param_bytes,"
+           "pixel_bytes,bus_bytes,transactions,checksum\n");
+  }
+  for (uint8_t i = 0; i < n; i++) {
+    const Result &r = results[i];
+    const ILI9341_EmulatorCounters &c = r.count;
+    unsigned long bytes = c.commands + c.paramBytes + c.pixelBytes;
+    if (json) {
+      printf("  {\"test\": \"%s\", \"micros\": %llu, \"commands\": %lu, "
+             "\"param_bytes\": %lu, \"pixel_bytes\": %lu, \"bus_bytes\": "
+             "%lu, \"transactions\": %lu, \"checksum\": \"%08lX\"}%s\n",
+             r.name, (unsigned long long)(r.nanos / 1000),
+             (unsigned long)c.commands, (unsigned long)c.paramBytes,
+             (unsigned long)c.pixelBytes, bytes, (unsigned long)c.selects,
+             (unsigned long)r.checksum, (i + 1 < n) ? "," : "");
+    } else {
+      printf("%s,%s,%lu,%d,%d,%llu,%lu,%lu,%lu,%lu,%lu,%08lX\n", r.name, bus,
+             (unsigned long)freq, (pixfmt == ILI9341_PIXFMT_18BIT) ? 18 : 16,
+             rotation, (unsigned long long)(r.nanos / 1000),
+             (unsigned long)c.commands, (unsigned long)c.paramBytes,
+             (unsigned long)c.pixelBytes, bytes, (unsigned long)c.selects,
+             (unsigned long)r.checksum);
+    }
+  }
+  if (json)
+    printf("]}\n");
+  return 0;
+}
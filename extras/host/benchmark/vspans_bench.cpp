@@ -0,0 +1,223 @@
+/*!
+ * @file vspans_bench.cpp
+ *
+ * Compares ways of drawing an oscilloscope trace on the host emulator: a
+ * drawFastVLine() loop that clears each column and draws the new segments,
+ * one that only erases the previous segments, a single drawVSpans() call
+ * per frame that rewrites the band, and a single updateVSpans() call that
+ * sends only the rows that change. Two traces are drawn across the full width of a
+ * landscape screen, so every frame has 640 vertical segments.
+ *
+ * Usage: vspans_bench [--freq HZ] [--bus spi|8|16] [--cycle NS]
+ *                     [--frames N] [--format csv|json]
+ *
+ * All methods must leave the same image, and updateVSpans() must not send
+ * more bytes than the erase loop; the exit status is 1 if not.
+ */
+
+#include "Adafruit_ILI9341.h"
+#include "ILI9341_Emulator.h"
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+#define TOP 20     ///< First row of the trace band
+#define HEIGHT 200 ///< Rows in the trace band
+#define TRACES 2   ///< Segments per column
+#define BG ILI9341_BLACK
+
+static const uint16_t traceColor[TRACES] = {ILI9341_YELLOW, ILI9341_CYAN};
+
+static ILI9341_Emulator panel;
+static Adafruit_ILI9341 tft(10, 9);
+
+/// Segments of one frame, sorted by column
+static ILI9341_VSpan spans[ILI9341_TFTHEIGHT * TRACES];
+static ILI9341_VSpan previous[ILI9341_TFTHEIGHT * TRACES];
+
+/// One benchmark row
+typedef struct {
+  const char *name;               ///< Method
+  uint64_t nanos;                 ///< Modelled time for all frames
+  ILI9341_EmulatorCounters count; ///< Bus traffic for all frames
+  uint32_t checksum;              ///< Visible image afterwards
+} Result;
+
+// Sample of trace t at column x in frame f, joined to the previous column
+// so each segment covers the vertical jump like a scope's line drawing.
+static int16_t sample(uint8_t t, int16_t x, uint16_t f) {
+  float phase = x * (t ? 0.045f : 0.031f) + f * (t ? 0.21f : 0.13f);
+  float noise = ((x * 7919 + f * 104729 + t * 31) % 17) - 8;
+  return TOP + HEIGHT / 2 + (HEIGHT / 2 - 10) * sinf(phase) + noise;
+}
+
+static void makeFrame(uint16_t f) {
+  uint16_t n = 0;
+  for (int16_t x = 0; x < tft.width(); x++) {
+    for (uint8_t t = 0; t < TRACES; t++) {
+      int16_t y = sample(t, x, f), prev = x ? sample(t, x - 1, f) : y;
+      spans[n].x = x;
+      spans[n].y0 = min(y, prev);
+      spans[n].y1 = max(y, prev);
+      spans[n++].color = traceColor[t];
+    }
+  }
+}
+
+static void clearBand(void) {
+  tft.fillRect(0, TOP, tft.width(), HEIGHT, BG);
+  memset(previous, 0, sizeof previous);
+}
+
+static void vlineClear(uint16_t f) {
+  makeFrame(f);
+  for (int16_t x = 0; x < tft.width(); x++) {
+    tft.drawFastVLine(x, TOP, HEIGHT, BG);
+    for (uint8_t t = 0; t < TRACES; t++) {
+      const ILI9341_VSpan &s = spans[x * TRACES + t];
+      tft.drawFastVLine(x, s.y0, s.y1 - s.y0 + 1, s.color);
+    }
+  }
+}
+
+static void vlineErase(uint16_t f) {
+  makeFrame(f);
+  for (int16_t x = 0; x < tft.width(); x++) {
+    for (uint8_t t = 0; t < TRACES; t++) {
+      const ILI9341_VSpan &p = previous[x * TRACES + t];
+      if (p.color != BG)
+        tft.drawFastVLine(x, p.y0, p.y1 - p.y0 + 1, BG);
+    }
+    for (uint8_t t = 0; t < TRACES; t++) {
+      const ILI9341_VSpan &s = spans[x * TRACES + t];
+      tft.drawFastVLine(x, s.y0, s.y1 - s.y0 + 1, s.color);
+    }
+  }
+  memcpy(previous, spans, sizeof spans);
+}
+
+static void vspans(uint16_t f) {
+  makeFrame(f);
+  tft.drawVSpans(spans, tft.width() * TRACES, TOP, HEIGHT, BG);
+}
+
+static void vspansUpdate(uint16_t f) {
+  makeFrame(f);
+  const uint16_t n = tft.width() * TRACES;
+  tft.updateVSpans(spans, n, previous, n, BG);
+  memcpy(previous, spans, sizeof spans);
+}
+
+static void usage(void) {
+  fprintf(stderr, "usage: vspans_bench [--freq HZ] [--bus spi|8|16] "
+                  "[--cycle NS]\n                    [--frames N] "
+                  "[--format csv|json]\n");
+}
+
+int main(int argc, char **argv) {
+  uint32_t freq = 24000000, cycle = 66;
+  uint16_t frames = 16;
+  uint8_t width = 0;
+  bool json = false;
+
+  for (int i = 1; i < argc; i++) {
+    const char *opt = argv[i], *val = (i + 1 < argc) ? argv[i + 1] : NULL;
+    if (!val) {
+      usage();
+      return 2;
+    }
+    i++;
+    if (!strcmp(opt, "--freq")) {
+      freq = strtoul(val, NULL, 0);
+    } else if (!strcmp(opt, "--bus")) {
+      width = strcmp(val, "spi") ? atoi(val) : 0;
+      if (width && (width != 8) && (width != 16)) {
+        usage();
+        return 2;
+      }
+    } else if (!strcmp(opt, "--cycle")) {
+      cycle = strtoul(val, NULL, 0);
+    } else if (!strcmp(opt, "--frames")) {
+      frames = max(atoi(val), 1);
+    } else if (!strcmp(opt, "--format")) {
+      json = !strcmp(val, "json");
+    } else {
+      usage();
+      return 2;
+    }
+  }
+
+  panel.attach(tft);
+  tft.setHostBusWidth(width);
+  tft.setHostParallelCycle(cycle);
+  tft.begin(freq);
+  tft.setRotation(1);
+  tft.fillScreen(BG);
+
+  static const struct {
+    const char *name;
+    void (*draw)(uint16_t f);
+  } methods[] = {{"vline_clear", vlineClear},
+                 {"vline_erase", vlineErase},
+                 {"vspans", vspans},
+                 {"vspans_update", vspansUpdate}};
+  const uint8_t n = sizeof methods / sizeof methods[0];
+  Result results[n];
+  for (uint8_t m = 0; m < n; m++) {
+    clearBand();
+    panel.clearCounters();
+    uint64_t t0 = ArduinoHost::nanos();
+    for (uint16_t f = 0; f < frames; f++)
+      methods[m].draw(f);
+    results[m].name = methods[m].name;
+    results[m].nanos = ArduinoHost::nanos() - t0;
+    results[m].count = panel.counters();
+    results[m].checksum = panel.visibleChecksum();
+  }
+
+  const char *bus = width ? ((width == 16) ? "16" : "8") : "spi";
+  if (json) {
+    printf("{\"bus\": \"%s\", \"freq\": %lu, \"cycle_ns\": %lu, "
+           "\"frames\": %u, \"results\": [\n",
+           bus, (unsigned long)freq, (unsigned long)cycle, frames);
+  } else {
+    printf("method,bus,freq,frames,micros_per_frame,commands,param_bytes,"
+           "pixel_bytes,bus_bytes,transactions,checksum\n");
+  }
+  bool same = true;
+  unsigned long eraseBytes = 0;
+  for (uint8_t i = 0; i < n; i++) {
+    const Result &r = results[i];
+    const ILI9341_EmulatorCounters &c = r.count;
+    unsigned long bytes = c.commands + c.paramBytes + c.pixelBytes;
+    same = same && (r.checksum == results[0].checksum);
+    if (methods[i].draw == vlineErase)
+      eraseBytes = bytes;
+    if (json) {
+      printf("  {\"method\": \"%s\", \"micros_per_frame\": %llu, "
+             "\"commands\": %lu, \"param_bytes\": %lu, \"pixel_bytes\": %lu, "
+             "\"bus_bytes\": %lu, \"transactions\": %lu, \"checksum\": "
+             "\"%08lX\"}%s\n",
+             r.name, (unsigned long long)(r.nanos / 1000 / frames),
+             (unsigned long)c.commands, (unsigned long)c.paramBytes,
+             (unsigned long)c.pixelBytes, bytes, (unsigned long)c.selects,
+             (unsigned long)r.checksum, (i + 1 < n) ? "," : "");
+    } else {
+      printf("%s,%s,%lu,%u,%llu,%lu,%lu,%lu,%lu,%lu,%08lX\n", r.name, bus,
+             (unsigned long)freq, frames,
+             (unsigned long long)(r.nanos / 1000 / frames),
+             (unsigned long)c.commands, (unsigned long)c.paramBytes,
+             (unsigned long)c.pixelBytes, bytes, (unsigned long)c.selects,
+             (unsigned long)r.checksum);
+    }
+  }
+  if (json)
+    printf("]}\n");
+  const ILI9341_EmulatorCounters &u = results[n - 1].count;
+  bool cheaper = u.commands + u.paramBytes + u.pixelBytes <= eraseBytes;
+  if (!same)
+    fprintf(stderr, "images differ between methods\n");
+  if (!cheaper)
+    fprintf(stderr, "vspans_update sends more than vline_erase\n");
+  return (same && cheaper) ? 0 : 1;
+}
@@ -0,0 +1,169 @@
+/*!
+ * @file vspans_check.cpp
+ *
+ * Checks drawVSpans() and updateVSpans() pixel by pixel on the host
+ * emulator. Random runs, some off screen, some overlapping, some with
+ * y0 > y1, are drawn in every rotation and both pixel formats over a
+ * patterned screen, and the visible image is compared with the same
+ * drawing done one pixel at a time in memory. drawVSpans() is also given
+ * columns out of order and with gaps; updateVSpans() is run over a series
+ * of frames, each one replacing the last.
+ *
+ * Usage: vspans_check
+ *
+ * The exit status is 1 if any pixel differs.
+ */
+
+#include "Adafruit_ILI9341.h"
+#include "ILI9341_Emulator.h"
+#include <stdio.h>
+#include <string.h>
+
+#define TRIALS 6    ///< drawVSpans() calls per rotation and format
+#define FRAMES 8    ///< updateVSpans() frames per rotation and format
+#define MAX_RUNS 600
+#define MASK 0xFFDF ///< Bits that survive the 18-bit round trip
+
+static ILI9341_Emulator panel;
+static Adafruit_ILI9341 tft(10, 9);
+static uint16_t image[ILI9341_TFTHEIGHT][ILI9341_TFTHEIGHT]; ///< [y][x]
+static ILI9341_VSpan runs[2][MAX_RUNS], shuffled[MAX_RUNS];
+// Fill the screen and the reference with a pattern, one row at a time
+static void pattern(void) {
+  for (int16_t y = 0; y < tft.height(); y++) {
+    for (int16_t x = 0; x < tft.width(); x++)
+      image[y][x] = (x * 7 + y * 13) & MASK;
+    tft.drawRGBBitmap(0, y, image[y], tft.width(), 1);
+  }
+}
+
+// Random runs sorted by x from a few columns off each side, one or two
+// per column, leaving out about a quarter of the columns if gaps is set
+static uint16_t makeRuns(ILI9341_VSpan *s, bool gaps) {
+  uint16_t n = 0;
+  for (int16_t x = -5; (x < tft.width() + 5) && (n < MAX_RUNS - 2); x++) {
+    if (gaps && !(random(4)))
+      continue;
+    uint8_t k = (random(5)) ? 1 : 2;
+    for (uint8_t j = 0; j < k; j++, n++) {
+      s[n].x = x;
+      s[n].y0 = random(340) - 10;
+      s[n].y1 = random(340) - 10;
+      s[n].color = random(0x10000) & MASK;
+    }
+  }
+  return n;
+}
+
+// Last run of s covering (x, y), or NULL
+static const ILI9341_VSpan *covering(const ILI9341_VSpan *s, uint16_t n,
+                                     int16_t x, int16_t y) {
+  const ILI9341_VSpan *found = NULL;
+  for (uint16_t k = 0; k < n; k++)
+    if ((s[k].x == x) && (y >= min(s[k].y0, s[k].y1)) &&
+        (y <= max(s[k].y0, s[k].y1)))
+      found = &s[k];
+  return found;
+}
+
+static bool compare(const char *what, uint8_t fmt, uint8_t rot, uint16_t i) {
+  for (int16_t y = 0; y < tft.height(); y++) {
+    for (int16_t x = 0; x < tft.width(); x++) {
+      uint16_t got = panel.visiblePixel(rot, x, y) & MASK;
+      if (got != image[y][x]) {
+        fprintf(stderr,
+                "%s: %u-bit rotation %u step %u: (%d,%d) is %04X, "
+                "expected %04X\n",
+                what, fmt ? 18 : 16, rot, i, x, y, got, image[y][x]);
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+// Rows top..top+height-1 of every named column become the runs or bg
+static bool checkDraw(uint8_t fmt, uint8_t rot, uint16_t trial) {
+  pattern();
+  uint8_t mode = trial % 3;
+  uint16_t n = makeRuns(runs[0], mode == 2);
+  ILI9341_VSpan *s = runs[0];
+  if (mode == 1) { // Whole columns in random order
+    uint16_t start[MAX_RUNS + 1], order[MAX_RUNS], columns = 0, m = 0;
+    for (uint16_t i = 0; i < n; i++)
+      if (!i || (s[i].x != s[i - 1].x))
+        start[columns++] = i;
+    start[columns] = n;
+    for (uint16_t c = 0; c < columns; c++)
+      order[c] = c;
+    for (uint16_t c = columns - 1; c > 0; c--) {
+      uint16_t d = random(c + 1), t = order[c];
+      order[c] = order[d];
+      order[d] = t;
+    }
+    for (uint16_t c = 0; c < columns; c++)
+      for (uint16_t i = start[order[c]]; i < start[order[c] + 1]; i++)
+        shuffled[m++] = s[i];
+    s = shuffled;
+  }
+  int16_t top = random(60) - 20, height = random(300) + 1;
+  const uint16_t bg = 0x1234 & MASK;
+  int16_t y0 = max(top, (int16_t)0);
+  int16_t y1 = min(top + height, (int)tft.height());
+  for (uint16_t i = 0; i < n; i++) {
+    int16_t x = s[i].x;
+    if ((x < 0) || (x >= tft.width()))
+      continue;
+    for (int16_t y = y0; y < y1; y++) {
+      const ILI9341_VSpan *c = covering(s, n, x, y);
+      image[y][x] = c ? c->color : bg;
+    }
+  }
+  tft.drawVSpans(s, n, top, height, bg);
+  return compare("drawVSpans", fmt, rot, trial);
+}
+
+// Rows the new runs cover take their colour, rows only the previous runs
+// covered become bg, everything else is left as it was
+static bool checkUpdate(uint8_t fmt, uint8_t rot) {
+  pattern();
+  const uint16_t bg = ILI9341_BLACK;
+  uint16_t count[2] = {0, 0};
+  for (uint16_t f = 0; f < FRAMES; f++) {
+    const ILI9341_VSpan *prev = runs[(f + 1) & 1];
+    ILI9341_VSpan *s = runs[f & 1];
+    count[f & 1] = makeRuns(s, f & 1);
+    uint16_t n = count[f & 1], pn = count[(f + 1) & 1];
+    for (int16_t x = 0; x < tft.width(); x++) {
+      for (int16_t y = 0; y < tft.height(); y++) {
+        const ILI9341_VSpan *c = covering(s, n, x, y);
+        if (c)
+          image[y][x] = c->color;
+        else if (covering(prev, pn, x, y))
+          image[y][x] = bg;
+      }
+    }
+    tft.updateVSpans(s, n, f ? prev : NULL, pn, bg);
+    if (!compare("updateVSpans", fmt, rot, f))
+      return false;
+  }
+  return true;
+}
+
+int main(void) {
+  panel.attach(tft);
+  tft.begin(24000000);
+  bool ok = true;
+  for (uint8_t fmt = 0; fmt < 2; fmt++) {
+    tft.setPixelFormat(fmt ? ILI9341_PIXFMT_18BIT : ILI9341_PIXFMT_16BIT);
+    for (uint8_t rot = 0; rot < 4; rot++) {
+      tft.setRotation(rot);
+      randomSeed(fmt * 4 + rot);
+      for (uint16_t t = 0; ok && (t < TRIALS); t++)
+        ok = checkDraw(fmt, rot, t);
+      ok = ok && checkUpdate(fmt, rot);
+    }
+  }
+  printf("%s\n", ok ? "pass" : "FAIL");
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,88 @@
+/*!
+ * @file emulator_demo.cpp
+ *
+ * Runs Adafruit_ILI9341 against the host emulator: draws a test pattern
+ * in every rotation, scrolls it, prints the bus traffic and modelled time
+ * of each step and saves what the panel shows as a PPM.
+ *
+ * Usage: emulator_demo [out.ppm [expected-checksum]]
+ * With an expected checksum (hex) the exit status tells whether the final
+ * image matched, which makes the program usable as a regression check.
+ */
+
+#include "Adafruit_ILI9341.h"
+#include "ILI9341_Emulator.h"
+#include <stdio.h>
+
+#define TFT_CS 10
+#define TFT_DC 9
+#define TFT_RST 8
+#define TFT_TE 7
+
+static ILI9341_Emulator panel;
+
+// Route the reset line and the TE output between the driver and the panel.
+static void writePin(uint8_t pin, uint8_t val) {
+  if ((pin == TFT_RST) && (val == LOW))
+    panel.reset();
+}
+
+static int readPin(uint8_t pin) {
+  return (pin == TFT_TE) ? panel.tearingLevel() : LOW;
+}
+
+static uint64_t stepStart;
+
+static void report(const char *step) {
+  const ILI9341_EmulatorCounters &c = panel.counters();
+  printf("%-12s %8llu us  %6u cmds %8u param %9u pixel bytes %5u CS\n", step,
+         (unsigned long long)((ArduinoHost::nanos() - stepStart) / 1000),
+         c.commands, c.paramBytes, c.pixelBytes, c.selects);
+  panel.clearCounters();
+  stepStart = ArduinoHost::nanos();
+}
+
+static void pattern(Adafruit_ILI9341 &tft, uint8_t r) {
+  static const uint16_t colors[] = {ILI9341_RED, ILI9341_GREEN, ILI9341_BLUE,
+                                    ILI9341_YELLOW};
+  tft.setRotation(r);
+  tft.fillRect(0, 0, tft.width() / 2, tft.height() / 2, colors[r]);
+  tft.drawRect(0, 0, tft.width(), tft.height(), ILI9341_WHITE);
+  tft.setCursor(4, 4);
+  tft.setTextColor(ILI9341_BLACK);
+  tft.print("rot ");
+  tft.print(r);
+}
+
+int main(int argc, char **argv) {
+  Adafruit_ILI9341 tft(TFT_CS, TFT_DC, TFT_RST);
+  panel.attach(tft);
+  ArduinoHost::setPinWriter(writePin);
+  ArduinoHost::setPinReader(readPin);
+
+  stepStart = ArduinoHost::nanos();
+  tft.begin(40000000);
+  report("begin");
+
+  tft.fillScreen(ILI9341_BLACK);
+  report("fillScreen");
+
+  for (uint8_t r = 0; r < 4; r++)
+    pattern(tft, r);
+  report("rotations");
+
+  tft.setRotation(0);
+  tft.setScrollMargins(16, 16);
+  tft.scrollTo(16 + 40);
+  report("scroll");
+
+  uint32_t sum = panel.visibleChecksum();
+  printf("checksum %08lX\n", (unsigned long)sum);
+  if ((argc > 1) && !panel.writePPM(argv[1])) {
+    fprintf(stderr, "can't write %s\n", argv[1]);
+    return 2;
+  }
+  if (argc > 2)
+    return (strtoul(argv[2], NULL, 16) == sum) ? 0 : 1;
+  return 0;
+}
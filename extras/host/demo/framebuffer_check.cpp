@@ -0,0 +1,109 @@
+/*!
+ * @file framebuffer_check.cpp
+ *
+ * Draws the same animated scene on two emulated panels in every rotation:
+ * one through ILI9341_Framebuffer, sending only dirty tiles with flush(),
+ * and one redrawn in full straight to the panel every frame. After each
+ * frame the two visible images must match pixel for pixel, and over the
+ * whole run the dirty flushes must send fewer pixel bytes than the full
+ * redraws.
+ *
+ * Usage: framebuffer_check [--tile PIXELS]
+ *
+ * The exit status is 1 if any check fails.
+ */
+
+#include "Adafruit_ILI9341.h"
+#include "ILI9341_Emulator.h"
+#include "ILI9341_Framebuffer.h"
+#include <stdio.h>
+#include <string.h>
+
+#define FRAMES 24 ///< Frames per rotation
+
+static ILI9341_Emulator panel, reference;
+static Adafruit_ILI9341 tft(10, 9), ref(11, 9);
+
+// Mostly static background and labels, a ball that moves, a sweeping line,
+// a frame counter and a pixel that flips every other frame.
+static void scene(Adafruit_GFX &g, uint16_t f) {
+  int16_t w = g.width(), h = g.height();
+  g.fillScreen(ILI9341_NAVY);
+  g.drawRect(4, 4, w - 8, h - 8, ILI9341_WHITE);
+  g.fillTriangle(w - 40, 20, w - 10, 60, w - 70, 60, ILI9341_GREEN);
+  g.setTextColor(ILI9341_YELLOW);
+  g.setTextSize(2);
+  g.setCursor(12, 12);
+  g.print("Frame ");
+  g.print(f);
+  g.fillCircle(30 + (f * 7) % (w - 60), h / 2 + (f * 5) % 40, 14,
+               ILI9341_RED);
+  g.drawLine(0, h - 1, (f * 13) % w, h / 2, ILI9341_CYAN);
+  g.drawFastHLine(10, h - 20, (f * 9) % (w - 20) + 1, ILI9341_ORANGE);
+  if (f & 1)
+    g.drawPixel(w / 2, h - 40, ILI9341_MAGENTA);
+}
+
+static void usage(void) {
+  fprintf(stderr, "usage: framebuffer_check [--tile PIXELS]\n");
+}
+
+int main(int argc, char **argv) {
+  uint8_t tile = 16;
+  for (int i = 1; i < argc; i++) {
+    if ((i + 1 >= argc) || strcmp(argv[i], "--tile")) {
+      usage();
+      return 2;
+    }
+    tile = max(atoi(argv[++i]), 1);
+  }
+
+  panel.attach(tft);
+  reference.attach(ref);
+  tft.begin(24000000);
+  ref.begin(24000000);
+
+  bool ok = true;
+  uint32_t dirtyBytes = 0, fullBytes = 0;
+  printf("rotation,frames,dirty_pixel_bytes,full_pixel_bytes\n");
+  for (uint8_t rot = 0; ok && (rot < 4); rot++) {
+    tft.setRotation(rot);
+    ref.setRotation(rot);
+    ILI9341_Framebuffer fb(tft, tile);
+    if (!fb.begin()) {
+      fprintf(stderr, "out of memory\n");
+      return 2;
+    }
+    panel.clearCounters();
+    reference.clearCounters();
+    for (uint16_t f = 0; ok && (f < FRAMES); f++) {
+      scene(fb, f);
+      fb.flush();
+      scene(ref, f);
+      for (int16_t py = 0; ok && (py < ILI9341_TFTHEIGHT); py++) {
+        for (int16_t px = 0; px < ILI9341_TFTWIDTH; px++) {
+          if (panel.visiblePixel(px, py) != reference.visiblePixel(px, py)) {
+            fprintf(stderr,
+                    "rotation %u frame %u: panel pixel (%d,%d) differs from "
+                    "the full redraw\n",
+                    rot, f, px, py);
+            ok = false;
+            break;
+          }
+        }
+      }
+    }
+    uint32_t dirty = panel.counters().pixelBytes;
+    uint32_t full = reference.counters().pixelBytes;
+    printf("%u,%u,%lu,%lu\n", rot, FRAMES, (unsigned long)dirty,
+           (unsigned long)full);
+    dirtyBytes += dirty;
+    fullBytes += full;
+  }
+  if (ok && (dirtyBytes >= fullBytes)) {
+    fprintf(stderr, "dirty flushes sent %lu pixel bytes, full redraws %lu\n",
+            (unsigned long)dirtyBytes, (unsigned long)fullBytes);
+    ok = false;
+  }
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,99 @@
+/*!
+ * @file indexedcanvas_check.cpp
+ *
+ * Draws random rectangles and lines on an ILI9341_IndexedCanvas on the
+ * host emulator, in every rotation, and at times writes indexes straight
+ * into getBuffer() followed by invalidate(). Between flushes the palette
+ * is changed one entry at a time or rotated. After every flush() each
+ * visible pixel must be the current palette colour of its index, however
+ * the index got into the buffer.
+ *
+ * Usage: indexedcanvas_check
+ *
+ * The exit status is 1 if any pixel differs.
+ */
+
+#include "Adafruit_ILI9341.h"
+#include "ILI9341_Emulator.h"
+#include "ILI9341_IndexedCanvas.h"
+#include <stdio.h>
+
+#define COLORS 24  ///< Palette entries in use
+#define FRAMES 40  ///< Flushes per rotation
+
+static ILI9341_Emulator panel;
+static Adafruit_ILI9341 tft(10, 9);
+
+static bool compare(ILI9341_IndexedCanvas &canvas, uint8_t rot,
+                    uint16_t frame) {
+  for (int16_t y = 0; y < canvas.height(); y++) {
+    for (int16_t x = 0; x < canvas.width(); x++) {
+      uint16_t want = canvas.getPaletteColor(canvas.getPixel(x, y));
+      uint16_t got = panel.visiblePixel(rot, x, y);
+      if (got != want) {
+        fprintf(stderr,
+                "rotation %u, frame %u: (%d,%d) is %04X, expected %04X "
+                "(index %u)\n",
+                rot, frame, x, y, got, want, canvas.getPixel(x, y));
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+static bool run(uint8_t rot) {
+  tft.setRotation(rot);
+  ILI9341_IndexedCanvas canvas(tft);
+  if (!canvas.begin()) {
+    fprintf(stderr, "out of memory\n");
+    return false;
+  }
+  const int16_t w = canvas.width(), h = canvas.height();
+  randomSeed(rot + 1);
+  for (uint8_t i = 0; i < COLORS; i++)
+    canvas.setPaletteColor(i, random(0x10000));
+
+  uint32_t sent = 0;
+  for (uint16_t f = 0; f < FRAMES; f++) {
+    uint8_t r = random(4);
+    if (r == 0) { // Bands of indexes the canvas never saw drawn
+      uint8_t *buf = canvas.getBuffer();
+      int16_t y0 = random(h), rows = random(40) + 1;
+      uint8_t index = random(COLORS);
+      for (int16_t y = y0; (y < y0 + rows) && (y < h); y++)
+        for (int16_t x = 0; x < w; x++)
+          buf[(int32_t)y * w + x] = (x / 8 + index) % COLORS;
+      canvas.invalidate();
+    } else if (r == 1) {
+      canvas.fillRect(random(w) - 20, random(h) - 20, random(80) + 1,
+                      random(80) + 1, random(COLORS));
+    } else if (r == 2) {
+      canvas.drawLine(random(w), random(h), random(w), random(h),
+                      random(COLORS));
+    }
+    sent += canvas.flush();
+    if (!compare(canvas, rot, f))
+      return false;
+
+    if (random(2))
+      canvas.rotatePalette(0, COLORS - 1);
+    else
+      canvas.setPaletteColor(random(COLORS), random(0x10000));
+    sent += canvas.flush();
+    if (!compare(canvas, rot, f))
+      return false;
+  }
+  printf("%u,%lu\n", rot, (unsigned long)sent);
+  return true;
+}
+
+int main(void) {
+  panel.attach(tft);
+  tft.begin(24000000);
+  printf("rotation,pixels_sent\n");
+  bool ok = true;
+  for (uint8_t rot = 0; ok && (rot < 4); rot++)
+    ok = run(rot);
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,191 @@
+/*!
+ * @file multipanel_check.cpp
+ *
+ * Drives three emulated panels on one bus through ILI9341_BusScheduler and
+ * checks the result: each panel must end up showing exactly what the same
+ * drawing gives when sent to it directly, no bytes may reach a panel whose
+ * CS is high, and no panel may keep the bus for more than its turn while
+ * another one is waiting. It also reports how soon a small update on one
+ * panel gets out while large transfers to the others are in progress.
+ *
+ * Usage: multipanel_check [--freq HZ] [--chunk PIXELS]
+ *
+ * The exit status is 1 if any check fails.
+ */
+
+#include "Adafruit_ILI9341.h"
+#include "ILI9341_BusScheduler.h"
+#include "ILI9341_Emulator.h"
+#include <stdio.h>
+#include <string.h>
+
+#define PANELS 3
+#define TFT_DC 9
+#define BLOCKS 4   ///< Pixel blocks per panel
+#define BLOCK_W 60 ///< Block size
+#define BLOCK_H 50
+
+static const uint8_t rotation[PANELS] = {0, 1, 3};
+static const uint8_t weight[PANELS] = {1, 1, 2};
+static const uint16_t bg[PANELS] = {ILI9341_NAVY, ILI9341_DARKGREEN,
+                                    ILI9341_MAROON};
+
+static ILI9341_Emulator panel[PANELS], reference[PANELS];
+static Adafruit_ILI9341 *tft[PANELS], *ref[PANELS];
+static uint16_t blocks[PANELS][BLOCKS][BLOCK_W * BLOCK_H];
+static uint16_t status[16 * 16];
+static uint64_t statusDone;
+
+static void statusSent(uint8_t, void *) { statusDone = ArduinoHost::nanos(); }
+
+// Each panel gets a few pixel blocks and a fill that hangs off the edge,
+// and all but panel 1 a full-screen fill first, so transfers are cut up
+// and resumed many times and panel 1 runs out of work early.
+static void drawWork(uint8_t p, ILI9341_BusScheduler *bus,
+                     Adafruit_ILI9341 &t) {
+  if (p != 1) {
+    if (bus)
+      bus->queueFill(p, 0, 0, t.width(), t.height(), bg[p]);
+    else
+      t.fillRect(0, 0, t.width(), t.height(), bg[p]);
+  }
+  for (uint8_t b = 0; b < BLOCKS; b++) {
+    int16_t x = 10 + b * 37, y = 20 + b * 45;
+    if (bus)
+      bus->queuePixels(p, x, y, BLOCK_W, BLOCK_H, blocks[p][b]);
+    else
+      t.drawRGBBitmap(x, y, blocks[p][b], BLOCK_W, BLOCK_H);
+  }
+  if (bus)
+    bus->queueFill(p, t.width() - 30, -20, 80, 90, ILI9341_WHITE);
+  else
+    t.fillRect(t.width() - 30, -20, 80, 90, ILI9341_WHITE);
+}
+
+static void usage(void) {
+  fprintf(stderr, "usage: multipanel_check [--freq HZ] [--chunk PIXELS]\n");
+}
+
+int main(int argc, char **argv) {
+  uint32_t freq = 24000000;
+  uint16_t chunk = ILI9341_BUS_CHUNK;
+  for (int i = 1; i < argc; i++) {
+    if ((i + 1 >= argc) ||
+        (strcmp(argv[i], "--freq") && strcmp(argv[i], "--chunk"))) {
+      usage();
+      return 2;
+    }
+    if (!strcmp(argv[i++], "--freq"))
+      freq = strtoul(argv[i], NULL, 0);
+    else
+      chunk = max(atoi(argv[i]), 1);
+  }
+
+  for (uint8_t p = 0; p < PANELS; p++) {
+    for (uint8_t b = 0; b < BLOCKS; b++)
+      for (uint16_t i = 0; i < BLOCK_W * BLOCK_H; i++)
+        blocks[p][b][i] = (i * (p + 3) + b * 0x1111) ^ (i / BLOCK_W << 6);
+    tft[p] = new Adafruit_ILI9341(10 + p, TFT_DC);
+    ref[p] = new Adafruit_ILI9341(20 + p, TFT_DC);
+    panel[p].attach(*tft[p]);
+    reference[p].attach(*ref[p]);
+    tft[p]->begin(freq);
+    ref[p]->begin(freq);
+    tft[p]->setRotation(rotation[p]);
+    ref[p]->setRotation(rotation[p]);
+  }
+  for (uint16_t i = 0; i < 16 * 16; i++)
+    status[i] = (i & 1) ? ILI9341_YELLOW : ILI9341_BLACK;
+
+  // Reference: the same drawing, panel after panel
+  uint64_t t0 = ArduinoHost::nanos();
+  for (uint8_t p = 0; p < PANELS; p++)
+    drawWork(p, NULL, *ref[p]);
+  uint64_t sequential = ArduinoHost::nanos() - t0;
+  ref[1]->drawRGBBitmap(200, 4, status, 16, 16);
+
+  ILI9341_BusScheduler bus;
+  if (!bus.begin(PANELS * (BLOCKS + 2) + 1, chunk)) {
+    fprintf(stderr, "out of memory\n");
+    return 2;
+  }
+  for (uint8_t p = 0; p < PANELS; p++) {
+    bus.addPanel(*tft[p], weight[p]);
+    panel[p].clearCounters();
+    drawWork(p, &bus, *tft[p]);
+  }
+
+  // Run the bus, noting which panel each chunk went to. A status block is
+  // queued for panel 1 as soon as its own work is out.
+  bool fair = true;
+  int8_t runPanel = -1;
+  uint16_t run = 0;
+  uint32_t chunks[PANELS] = {0};
+  uint64_t statusQueued = 0;
+  t0 = ArduinoHost::nanos();
+  for (;;) {
+    bool waiting[PANELS];
+    for (uint8_t p = 0; p < PANELS; p++)
+      waiting[p] = bus.pending(p) > 0;
+    if (!bus.poll())
+      break;
+    for (uint8_t p = 0; p < PANELS; p++) {
+      if (bus.stats(p).chunks == chunks[p])
+        continue;
+      chunks[p] = bus.stats(p).chunks;
+      run = (p == runPanel) ? run + 1 : 1;
+      runPanel = p;
+      bool others = false;
+      for (uint8_t q = 0; q < PANELS; q++)
+        others = others || ((q != p) && waiting[q]);
+      if (others && (run > weight[p])) {
+        fprintf(stderr,
+                "panel %u sent %u chunks in a row while others waited\n", p,
+                run);
+        fair = false;
+      }
+    }
+    if (!statusQueued && !bus.pending(1)) {
+      bus.queuePixels(1, 200, 4, 16, 16, status, statusSent);
+      statusQueued = ArduinoHost::nanos();
+    }
+  }
+  uint64_t scheduled = ArduinoHost::nanos() - t0;
+
+  bool ok = fair;
+  printf("panel,rotation,weight,jobs,chunks,pixels,turns,selects,ramwrc,"
+         "unselected,checksum,reference\n");
+  for (uint8_t p = 0; p < PANELS; p++) {
+    const ILI9341_BusPanelStats &s = bus.stats(p);
+    const ILI9341_EmulatorCounters &c = panel[p].counters();
+    uint32_t got = panel[p].visibleChecksum();
+    uint32_t want = reference[p].visibleChecksum();
+    printf("%u,%u,%u,%lu,%lu,%lu,%lu,%lu,%lu,%lu,%08lX,%08lX\n", p,
+           rotation[p], weight[p], (unsigned long)s.jobs,
+           (unsigned long)s.chunks, (unsigned long)s.pixels,
+           (unsigned long)s.turns, (unsigned long)c.selects,
+           (unsigned long)c.perCommand[ILI9341_RAMWRC],
+           (unsigned long)c.unselected, (unsigned long)got,
+           (unsigned long)want);
+    if (got != want) {
+      fprintf(stderr, "panel %u differs from its reference\n", p);
+      ok = false;
+    }
+    if (c.unselected) {
+      fprintf(stderr, "panel %u saw traffic while deselected\n", p);
+      ok = false;
+    }
+  }
+  printf("sequential %llu us, scheduled %llu us\n",
+         (unsigned long long)(sequential / 1000),
+         (unsigned long long)(scheduled / 1000));
+  printf("status block sent %llu us after queueing, with %llu us of other "
+         "transfers still to go\n",
+         (unsigned long long)((statusDone - statusQueued) / 1000),
+         (unsigned long long)((t0 + scheduled - statusDone) / 1000));
+  if (!statusDone) {
+    fprintf(stderr, "status block callback never ran\n");
+    ok = false;
+  }
+  return ok ? 0 : 1;
+}
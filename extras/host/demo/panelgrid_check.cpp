@@ -0,0 +1,161 @@
+/*!
+ * @file panelgrid_check.cpp
+ *
+ * Draws random fills, lines, circles, text, bitmaps and a triangle across
+ * ILI9341_PanelGrid walls of emulated panels, in several layouts, panel
+ * rotations and every grid rotation, and draws the same on an in-memory
+ * canvas of the wall's size. Every pixel of every panel must match the
+ * canvas, and no panel may see bytes while its CS is high.
+ *
+ * Usage: panelgrid_check
+ *
+ * The exit status is 1 if any check fails.
+ */
+
+#include "Adafruit_ILI9341.h"
+#include "ILI9341_Emulator.h"
+#include "ILI9341_PanelGrid.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+#define SHAPES 60 ///< Random shapes per wall
+#define BMP_W 200
+#define BMP_H 150
+
+/// Reference drawing in RAM
+class Canvas : public Adafruit_GFX {
+public:
+  Canvas(int16_t w, int16_t h) : Adafruit_GFX(w, h) {
+    pixels = (uint16_t *)calloc((uint32_t)w * h, sizeof(uint16_t));
+  }
+  ~Canvas(void) { free(pixels); }
+  void drawPixel(int16_t x, int16_t y, uint16_t color) {
+    if ((x >= 0) && (y >= 0) && (x < _width) && (y < _height))
+      pixels[(int32_t)y * _width + x] = color;
+  }
+  uint16_t *pixels; ///< Row by row
+};
+
+static uint16_t bitmap[BMP_W * BMP_H];
+
+// The same random shapes on the wall and the canvas
+static void draw(Adafruit_GFX **targets, int16_t w, int16_t h) {
+  for (uint8_t t = 0; t < 2; t++)
+    targets[t]->fillScreen(0x1234);
+  for (uint8_t n = 0; n < SHAPES; n++) {
+    int16_t x = random(w + 100) - 50, y = random(h + 100) - 50;
+    int16_t sw = random(400) + 1, sh = random(300) + 1;
+    uint16_t c = random(0x10000);
+    if ((n % 7) == 6)
+      for (uint16_t i = 0; i < BMP_W * BMP_H; i++)
+        bitmap[i] = i * c;
+    for (uint8_t t = 0; t < 2; t++) {
+      Adafruit_GFX &g = *targets[t];
+      switch (n % 7) {
+      case 0:
+        g.fillRect(x, y, sw, sh, c);
+        break;
+      case 1:
+        g.drawLine(x, y, x + sw, y + sh, c);
+        break;
+      case 2:
+        g.fillCircle(x, y, sw / 4, c);
+        break;
+      case 3:
+        g.drawFastHLine(x, y, sw, c);
+        g.drawFastVLine(x, y, sh, c);
+        break;
+      case 4:
+        g.setCursor(x, y);
+        g.setTextColor(c, ~c);
+        g.setTextSize(2);
+        g.print("Grid!");
+        break;
+      case 5:
+        g.drawPixel(x, y, c);
+        g.drawRect(x, y, sw, sh, c);
+        break;
+      default:
+        g.drawRGBBitmap(x, y, bitmap, BMP_W, BMP_H);
+      }
+    }
+  }
+  for (uint8_t t = 0; t < 2; t++) {
+    targets[t]->startWrite();
+    targets[t]->fillTriangle(10, 10, w - 5, h / 2, 30, h - 3, 0xF00F);
+    targets[t]->endWrite();
+  }
+}
+
+static bool run(uint8_t cols, uint8_t rows, uint8_t base, uint8_t rot) {
+  ILI9341_Emulator panels[ILI9341_GRID_PANELS];
+  Adafruit_ILI9341 *tft[ILI9341_GRID_PANELS];
+  const uint8_t n = cols * rows;
+  for (uint8_t i = 0; i < n; i++) {
+    tft[i] = new Adafruit_ILI9341(10 + i, 9);
+    panels[i].attach(*tft[i]);
+  }
+  ILI9341_PanelGrid wall(tft, cols, rows, base);
+  wall.begin(24000000);
+  wall.setRotation(rot);
+  const int16_t w = wall.width(), h = wall.height();
+  Canvas canvas(w, h);
+  Adafruit_GFX *targets[2] = {&wall, &canvas};
+  randomSeed(rot * 7 + cols * 3 + base);
+  draw(targets, w, h);
+
+  // Undo the wall's rotation a quarter turn at a time, then find the
+  // panel from the layout as wired
+  const int16_t tileW = (base & 1) ? ILI9341_TFTHEIGHT : ILI9341_TFTWIDTH;
+  const int16_t tileH = (base & 1) ? ILI9341_TFTWIDTH : ILI9341_TFTHEIGHT;
+  bool ok = true;
+  for (int16_t y = 0; ok && (y < h); y++) {
+    for (int16_t x = 0; x < w; x++) {
+      int16_t bx = x, by = y, bh = h;
+      for (uint8_t k = 0; k < rot; k++) {
+        int16_t t = bx;
+        bx = bh - 1 - by;
+        by = t;
+        bh = (bh == h) ? w : h;
+      }
+      uint8_t p = (by / tileH) * cols + bx / tileW;
+      uint16_t got = panels[p].visiblePixel(base, bx % tileW, by % tileH);
+      uint16_t want = canvas.pixels[(int32_t)y * w + x];
+      if (got != want) {
+        fprintf(stderr,
+                "%ux%u wall, panel rotation %u, rotation %u: (%d,%d) is "
+                "%04X, expected %04X\n",
+                cols, rows, base, rot, x, y, got, want);
+        ok = false;
+        break;
+      }
+    }
+  }
+  uint32_t selects = 0;
+  for (uint8_t i = 0; i < n; i++) {
+    const ILI9341_EmulatorCounters &c = panels[i].counters();
+    selects += c.selects;
+    if (c.unselected) {
+      fprintf(stderr, "%ux%u wall, rotation %u: panel %u saw traffic while "
+                      "deselected\n",
+              cols, rows, rot, i);
+      ok = false;
+    }
+  }
+  printf("%u,%u,%u,%u,%d,%d,%lu\n", cols, rows, base, rot, w, h,
+         (unsigned long)selects);
+  for (uint8_t i = 0; i < n; i++)
+    delete tft[i];
+  return ok;
+}
+
+int main(void) {
+  static const uint8_t layouts[][3] = {
+      {2, 2, 1}, {3, 1, 0}, {1, 2, 3}, {2, 3, 2}}; ///< cols, rows, rotation
+  printf("cols,rows,panel_rotation,rotation,width,height,selects\n");
+  bool ok = true;
+  for (uint8_t rot = 0; rot < 4; rot++)
+    for (uint8_t l = 0; l < sizeof layouts / sizeof layouts[0]; l++)
+      ok = run(layouts[l][0], layouts[l][1], layouts[l][2], rot) && ok;
+  return ok ? 0 : 1;
+}
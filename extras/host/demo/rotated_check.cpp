@@ -0,0 +1,105 @@
+/*!
+ * @file rotated_check.cpp
+ *
+ * Checks drawRGBBitmapRotated() on the host emulator for every screen
+ * rotation, bitmap rotation and mirroring, in both pixel formats, with the
+ * bitmap inside the screen and hanging off each edge. The visible image
+ * must be the bitmap turned and mirrored as asked, clipped to the screen,
+ * and a pixel drawn afterwards must land where it would without the
+ * call, which shows MADCTL was put back.
+ *
+ * Usage: rotated_check
+ *
+ * The exit status is 1 if any pixel differs.
+ */
+
+#include "Adafruit_ILI9341.h"
+#include "ILI9341_Emulator.h"
+#include <stdio.h>
+
+#define BMP_W 37   ///< Odd sizes, so off-by-one errors show
+#define BMP_H 23
+#define MASK 0xFFDF ///< Bits that survive the 18-bit round trip
+
+static ILI9341_Emulator panel;
+static Adafruit_ILI9341 tft(10, 9);
+static uint16_t bitmap[BMP_W * BMP_H];
+
+static const int16_t positions[][2] = {{50, 60},   {-10, -7},  {220, 300},
+                                       {300, 220}, {-30, 200}, {100, -20}};
+
+// Bitmap pixel shown at (dx, dy) from the drawn top-left corner
+static uint16_t turned(uint8_t rot, bool mirror, int16_t dx, int16_t dy) {
+  int16_t i, j;
+  switch (rot) {
+  case 0:
+    i = dx;
+    j = dy;
+    break;
+  case 1:
+    i = dy;
+    j = BMP_H - 1 - dx;
+    break;
+  case 2:
+    i = BMP_W - 1 - dx;
+    j = BMP_H - 1 - dy;
+    break;
+  default:
+    i = BMP_W - 1 - dy;
+    j = dx;
+  }
+  if (mirror)
+    i = BMP_W - 1 - i;
+  return bitmap[j * BMP_W + i];
+}
+
+static bool run(uint8_t fmt, uint8_t screen, uint8_t rot, bool mirror,
+                uint8_t p) {
+  tft.setPixelFormat(fmt ? ILI9341_PIXFMT_18BIT : ILI9341_PIXFMT_16BIT);
+  tft.setRotation(screen);
+  tft.fillScreen(ILI9341_BLACK);
+  const int16_t x = positions[p][0], y = positions[p][1];
+  tft.drawRGBBitmapRotated(x, y, bitmap, BMP_W, BMP_H, rot, mirror);
+  tft.drawPixel(0, 0, ILI9341_WHITE);
+
+  const int16_t dw = (rot & 1) ? BMP_H : BMP_W, dh = (rot & 1) ? BMP_W : BMP_H;
+  for (int16_t sy = 0; sy < tft.height(); sy++) {
+    for (int16_t sx = 0; sx < tft.width(); sx++) {
+      int16_t dx = sx - x, dy = sy - y;
+      uint16_t want = ILI9341_BLACK;
+      if (!sx && !sy)
+        want = ILI9341_WHITE;
+      else if ((dx >= 0) && (dy >= 0) && (dx < dw) && (dy < dh))
+        want = turned(rot, mirror, dx, dy);
+      uint16_t got = panel.visiblePixel(screen, sx, sy);
+      if ((got & MASK) != (want & MASK)) {
+        fprintf(stderr,
+                "%u-bit, screen rotation %u, bitmap rotation %u%s at "
+                "(%d,%d): (%d,%d) is %04X, expected %04X\n",
+                fmt ? 18 : 16, screen, rot, mirror ? " mirrored" : "", x, y,
+                sx, sy, got, want);
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+int main(void) {
+  for (uint16_t i = 0; i < BMP_W * BMP_H; i++)
+    bitmap[i] = i * 59 + 1;
+
+  panel.attach(tft);
+  tft.begin(24000000);
+  const uint8_t places = sizeof positions / sizeof positions[0];
+  uint16_t cases = 0;
+  bool ok = true;
+  for (uint8_t fmt = 0; ok && (fmt < 2); fmt++)
+    for (uint8_t screen = 0; ok && (screen < 4); screen++)
+      for (uint8_t rot = 0; ok && (rot < 4); rot++)
+        for (uint8_t mirror = 0; ok && (mirror < 2); mirror++)
+          for (uint8_t p = 0; ok && (p < places); p++, cases++)
+            ok = run(fmt, screen, rot, mirror, p);
+  printf("%u cases %s\n", cases, ok ? "pass" : "FAIL");
+  return ok ? 0 : 1;
+}
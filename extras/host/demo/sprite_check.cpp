@@ -0,0 +1,171 @@
+/*!
+ * @file sprite_check.cpp
+ *
+ * Moves, shows and hides RGB565 and indexed sprites with
+ * ILI9341_SpriteLayer on the host emulator, in every rotation, with a
+ * background callback and in save-under mode, and with a line buffer wide
+ * enough for every sprite as well as one so narrow that dirty rectangles
+ * are split into strips. After every update() the visible image must be
+ * the background with each visible sprite drawn at its position, higher
+ * ids on top.
+ *
+ * Usage: sprite_check
+ *
+ * The exit status is 1 if any pixel differs.
+ */
+
+#include "Adafruit_ILI9341.h"
+#include "ILI9341_Emulator.h"
+#include "ILI9341_SpriteLayer.h"
+#include <stdio.h>
+
+#define SPRITES 5
+#define FRAMES 200 ///< Updates per rotation and mode
+#define KEY 0xF81F ///< Transparent colour of the RGB565 sprites
+
+static ILI9341_Emulator panel;
+static Adafruit_ILI9341 tft(10, 9);
+
+static const int16_t spriteW[SPRITES] = {20, 20, 20, 16, 30};
+static const int16_t spriteH[SPRITES] = {15, 15, 15, 12, 10};
+static const uint8_t spriteBpp[SPRITES] = {0, 0, 0, 4, 2}; ///< 0: RGB565
+static const bool keyed[SPRITES] = {true, false, true, true, false};
+static uint16_t images[3][20 * 15];
+static uint8_t bits[8 * 12];
+static const uint16_t palette[16] = {0,      0xF800, 0x07E0, 0x001F,
+                                     0xFFFF, 1,      2,      3,
+                                     4,      5,      6,      7,
+                                     8,      9,      10,     11};
+static uint16_t screen[ILI9341_TFTHEIGHT * ILI9341_TFTHEIGHT];
+
+/// Where the check expects each sprite
+typedef struct {
+  int16_t x, y; ///< Position
+  bool visible; ///< Shown
+} Place;
+
+static uint16_t background(int16_t x, int16_t y) {
+  return x * 31 + y * 2047 + (x ^ y);
+}
+
+static void fillBackground(uint16_t *line, int16_t x, int16_t y, uint16_t w,
+                           void *) {
+  for (uint16_t i = 0; i < w; i++)
+    line[i] = background(x + i, y);
+}
+
+// Pixel (sx, sy) of sprite k, or -1 where it is transparent
+static int32_t spritePixel(uint8_t k, int16_t sx, int16_t sy) {
+  if (!spriteBpp[k]) {
+    uint16_t c = images[k][sy * spriteW[k] + sx];
+    if (keyed[k] && (c == KEY))
+      return -1;
+    return c;
+  }
+  uint8_t bpp = spriteBpp[k];
+  uint16_t stride = (spriteW[k] * bpp + 7) / 8;
+  uint8_t b = bits[sy * stride + sx * bpp / 8];
+  uint8_t index = (b >> (8 - bpp - (sx * bpp) % 8)) & ((1 << bpp) - 1);
+  if (keyed[k] && !index)
+    return -1;
+  return palette[index];
+}
+
+static bool compare(const Place *place, uint8_t rot, bool saveUnder,
+                    uint16_t maxWidth, uint16_t frame) {
+  for (int16_t y = 0; y < tft.height(); y++) {
+    for (int16_t x = 0; x < tft.width(); x++) {
+      uint16_t want = background(x, y);
+      for (uint8_t k = 0; k < SPRITES; k++) {
+        int16_t sx = x - place[k].x, sy = y - place[k].y;
+        if (!place[k].visible || (sx < 0) || (sx >= spriteW[k]) ||
+            (sy < 0) || (sy >= spriteH[k]))
+          continue;
+        int32_t c = spritePixel(k, sx, sy);
+        if (c >= 0)
+          want = c;
+      }
+      uint16_t got = panel.visiblePixel(rot, x, y);
+      if (got != want) {
+        fprintf(stderr,
+                "%s, line %u, rotation %u, frame %u: (%d,%d) is %04X, "
+                "expected %04X\n",
+                saveUnder ? "save-under" : "callback", maxWidth, rot, frame,
+                x, y, got, want);
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+static bool run(uint8_t rot, bool saveUnder, uint16_t maxWidth) {
+  tft.setRotation(rot);
+  const int16_t w = tft.width(), h = tft.height();
+  for (int16_t y = 0; y < h; y++) {
+    for (int16_t x = 0; x < w; x++)
+      screen[y * w + x] = background(x, y);
+    tft.drawRGBBitmap(0, y, &screen[y * w], w, 1);
+  }
+
+  ILI9341_SpriteLayer layer(tft);
+  if (!saveUnder)
+    layer.setBackground(fillBackground);
+  if (!layer.begin(SPRITES, maxWidth)) {
+    fprintf(stderr, "out of memory\n");
+    return false;
+  }
+  for (uint8_t k = 0; k < SPRITES; k++) {
+    if (spriteBpp[k])
+      layer.addSprite(bits, spriteBpp[k], spriteW[k], spriteH[k], palette,
+                      keyed[k] ? 0 : -1);
+    else
+      layer.addSprite(images[k], spriteW[k], spriteH[k],
+                      keyed[k] ? KEY : -1);
+  }
+
+  Place place[SPRITES];
+  randomSeed(1 + rot + saveUnder * 10 + maxWidth * 100);
+  for (uint16_t f = 0; f < FRAMES; f++) {
+    for (uint8_t k = 0; k < SPRITES; k++) {
+      if (!f) {
+        place[k].x = random(w);
+        place[k].y = random(h);
+        place[k].visible = true;
+      } else if (random(3)) {
+        int16_t x = place[k].x + random(21) - 10;
+        int16_t y = place[k].y + random(21) - 10;
+        place[k].x = max(min(x, w + 10), -40);
+        place[k].y = max(min(y, h + 10), -40);
+      }
+      layer.moveTo(k, place[k].x, place[k].y);
+      if (!(random(17)) || (f == FRAMES - 1)) {
+        place[k].visible = !place[k].visible && (f < FRAMES - 1);
+        layer.show(k, place[k].visible);
+      }
+    }
+    layer.update();
+    if (!compare(place, rot, saveUnder, maxWidth, f))
+      return false;
+  }
+  return true;
+}
+
+int main(void) {
+  for (uint8_t k = 0; k < 3; k++)
+    for (uint16_t i = 0; i < 20 * 15; i++)
+      images[k][i] = (i % 7) ? (uint16_t)(i * 97 + k * 5000 + 1) : KEY;
+  for (uint8_t i = 0; i < sizeof bits; i++)
+    bits[i] = i * 37 + 11;
+
+  panel.attach(tft);
+  tft.begin(24000000);
+  static const uint16_t lineWidths[] = {64, 2};
+  bool ok = true;
+  for (uint8_t m = 0; ok && (m < 2); m++)
+    for (uint8_t l = 0; ok && (l < 2); l++)
+      for (uint8_t rot = 0; ok && (rot < 4); rot++)
+        ok = run(rot, m, lineWidths[l]);
+  printf("%s\n", ok ? "pass" : "FAIL");
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,123 @@
+/*!
+ * @file stripchart_check.cpp
+ *
+ * Feeds an ILI9341_StripChart two traces, one with gaps, plus an
+ * occasional waterfall column, in every rotation, with and without fixed
+ * columns at the sides, for long enough that the scroll area wraps. The
+ * visible image must be the last plotWidth() columns, newest on the right,
+ * each with its grid, connected trace segments or waterfall pixels, and
+ * the fixed columns must be left as they were.
+ *
+ * Usage: stripchart_check
+ *
+ * The exit status is 1 if any pixel differs.
+ */
+
+#include "Adafruit_ILI9341.h"
+#include "ILI9341_Emulator.h"
+#include "ILI9341_StripChart.h"
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+#define ROWS ILI9341_TFTWIDTH    ///< Plot height in landscape
+#define COLS ILI9341_TFTHEIGHT   ///< Screen width in landscape
+#define MAX_COLUMNS 700          ///< Longest run
+#define WATERFALL_EVERY 150      ///< Every nth column is a waterfall one
+#define LO -20.0f                ///< Chart range
+#define HI 110.0f
+#define GRID_ROWS 20
+#define GRID_COLUMNS 16
+#define FIXED 0x1111             ///< Colour of the fixed columns
+#define GRID 0x3333
+static const uint16_t traceColor[2] = {ILI9341_YELLOW, ILI9341_GREEN};
+
+static ILI9341_Emulator panel;
+static Adafruit_ILI9341 tft(10, 9);
+static uint16_t expected[MAX_COLUMNS][ROWS]; ///< Every column sent, in order
+
+// Sample k of series s; series 1 has short gaps
+static float value(uint8_t s, uint16_t k) {
+  if (s)
+    return ((k % 97) < 5) ? NAN : 50 + 60 * cosf(k * 0.05f);
+  return 30 * sinf(k * 0.11f) + (k % 13);
+}
+
+static int16_t valueRow(float v) {
+  float r = (ROWS - 1) * (HI - v) / (HI - LO);
+  return (r < 0) ? 0 : (r > ROWS - 1) ? ROWS - 1 : (int16_t)(r + 0.5f);
+}
+
+static bool run(uint8_t rot, uint16_t left, uint16_t right,
+                uint16_t columns) {
+  tft.setRotation(rot);
+  ILI9341_StripChart chart(tft, left, right);
+  tft.fillScreen(FIXED);
+  chart.begin(ILI9341_BLACK);
+  chart.setRange(LO, HI);
+  chart.setGrid(GRID, GRID_ROWS, GRID_COLUMNS);
+  chart.setSeriesColor(1, traceColor[1]);
+
+  int16_t last[2] = {-1, -1};
+  uint16_t samples = 0;
+  for (uint16_t k = 0; k < columns; k++) {
+    uint16_t *c = expected[k];
+    if ((k % WATERFALL_EVERY) == WATERFALL_EVERY - 1) {
+      static uint16_t pixels[ROWS]; // addColumn() may change it
+      for (int16_t y = 0; y < ROWS; y++)
+        c[y] = y * 11 + k;
+      memcpy(pixels, c, sizeof pixels);
+      chart.addColumn(pixels);
+      last[0] = last[1] = -1;
+      continue;
+    }
+    bool gridColumn = !(samples++ % GRID_COLUMNS);
+    for (int16_t y = 0; y < ROWS; y++)
+      c[y] = (gridColumn || !((ROWS - 1 - y) % GRID_ROWS)) ? GRID
+                                                            : ILI9341_BLACK;
+    float v[2] = {value(0, k), value(1, k)};
+    for (uint8_t s = 0; s < 2; s++) {
+      if (isnan(v[s])) {
+        last[s] = -1;
+        continue;
+      }
+      int16_t row = valueRow(v[s]), from = (last[s] < 0) ? row : last[s];
+      for (int16_t y = min(row, from); y <= max(row, from); y++)
+        c[y] = traceColor[s];
+      last[s] = row;
+    }
+    chart.addSample(v, 2);
+  }
+
+  const uint16_t w = chart.plotWidth();
+  for (int16_t x = 0; x < COLS; x++) {
+    for (int16_t y = 0; y < ROWS; y++) {
+      uint16_t want = FIXED;
+      if ((x >= left) && (x < COLS - right)) {
+        int32_t k = (int32_t)columns - 1 - (left + w - 1 - x);
+        want = (k < 0) ? ILI9341_BLACK : expected[k][y];
+      }
+      uint16_t got = panel.visiblePixel(tft.getRotation(), x, y);
+      if (got != want) {
+        fprintf(stderr,
+                "rotation %u, margins %u/%u, %u columns: (%d,%d) is %04X, "
+                "expected %04X\n",
+                rot, left, right, columns, x, y, got, want);
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+int main(void) {
+  panel.attach(tft);
+  tft.begin(24000000);
+  bool ok = true;
+  for (uint8_t rot = 0; ok && (rot < 4); rot++) {
+    ok = run(rot, 0, 0, 200);
+    ok = ok && run(rot, 40, 25, MAX_COLUMNS);
+  }
+  printf("%s\n", ok ? "pass" : "FAIL");
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,194 @@
+/*!
+ * @file tearing_check.cpp
+ *
+ * Sends frame updates through ILI9341_TearingScheduler on the host
+ * emulator, in every rotation, once with the panel's TE output wired to a
+ * pin and once with the frame-rate model alone. Frames are full-screen
+ * images, a few large rectangles or many small ones, with a random pause
+ * between them so each starts at a different scan position. Every pixel
+ * byte must arrive while the panel's scan line is outside the address
+ * window being written, so that each band is written behind the scan, and
+ * the screen must show each frame's rectangles. As a control, a
+ * full-screen write without the scheduler must be seen to tear.
+ *
+ * Usage: tearing_check
+ *
+ * The exit status is 1 if any byte is written under the scan line.
+ */
+
+#include "Adafruit_ILI9341.h"
+#include "ILI9341_Emulator.h"
+#include "ILI9341_TearingScheduler.h"
+#include <stdio.h>
+
+#define TE_PIN 5   ///< Pin the emulated TE output is read on
+#define FRAMES 40  ///< Updates per rotation and timing source
+#define MAX_RECTS 8
+
+/// Emulator that notes every pixel byte written where the panel is scanning
+class ScanWatch : public ILI9341_Emulator {
+public:
+  ScanWatch(void) : torn(0), written(0), _cmd(0), _arg(0) {}
+
+  void command(uint8_t cmd) {
+    _cmd = cmd;
+    _arg = 0;
+    ILI9341_Emulator::command(cmd);
+  }
+
+  void data(uint8_t b) {
+    if ((_cmd == ILI9341_CASET) || (_cmd == ILI9341_PASET)) {
+      uint16_t *w = (_cmd == ILI9341_CASET) ? _col : _page;
+      if (_arg < 4)
+        w[_arg / 2] = (_arg & 1) ? (w[_arg / 2] | b) : (b << 8);
+      _arg++;
+    } else if ((_cmd == ILI9341_RAMWR) || (_cmd == ILI9341_RAMWRC)) {
+      uint16_t g0, g1, s = scanLine();
+      gateLines(g0, g1);
+      if ((s >= g0) && (s <= g1))
+        torn++;
+      written++;
+    }
+    ILI9341_Emulator::data(b);
+  }
+
+  uint32_t torn;    ///< Pixel bytes written inside the scanned window
+  uint32_t written; ///< Pixel bytes written
+
+private:
+  // Gate lines spanned by the address window. They follow the page
+  // address, or the column address when MADCTL exchanges the two, and run
+  // the other way when that address is mirrored.
+  void gateLines(uint16_t &g0, uint16_t &g1) const {
+    const uint8_t m = madctl();
+    const uint16_t *a = (m & 0x20) ? _col : _page;
+    g0 = a[0];
+    g1 = a[1];
+    if (m & ((m & 0x20) ? 0x40 : 0x80)) {
+      g0 = ILI9341_TFTHEIGHT - 1 - a[1];
+      g1 = ILI9341_TFTHEIGHT - 1 - a[0];
+    }
+  }
+
+  uint8_t _cmd, _arg;
+  uint16_t _col[2], _page[2]; ///< CASET/PASET start and end
+};
+
+static ScanWatch panel;
+static Adafruit_ILI9341 tft(10, 9);
+static uint16_t image[ILI9341_TFTWIDTH * ILI9341_TFTHEIGHT];
+
+static int readPin(uint8_t pin) {
+  return (pin == TE_PIN) ? panel.tearingLevel() : 0;
+}
+
+// Wait for the panel to enter V-blank, as a sketch using the model alone
+// would do once at start-up (from a TE interrupt or a timer it trusts)
+static void syncToBlanking(void) {
+  while (panel.scanLine() >= ILI9341_TFTHEIGHT)
+    ArduinoHost::advance(1000);
+  while (panel.scanLine() < ILI9341_TFTHEIGHT)
+    ArduinoHost::advance(1000);
+}
+
+static ILI9341_Rect rect(int16_t x, int16_t y, int16_t w, int16_t h) {
+  ILI9341_Rect r = {x, y, w, h, image};
+  return r;
+}
+
+static uint8_t makeFrame(ILI9341_Rect *rects, uint16_t f) {
+  const int16_t w = tft.width(), h = tft.height();
+  uint8_t n = 0;
+  switch (f % 3) {
+  case 0:
+    rects[n++] = rect(0, 0, w, h);
+    break;
+  case 1:
+    for (; n < 2; n++) {
+      int16_t rw = random(w / 2) + w / 2, rh = random(h / 2) + 20;
+      rects[n] = rect(random(w - rw + 1), random(h) - 10, rw, rh);
+    }
+    break;
+  default:
+    for (; n < MAX_RECTS; n++)
+      rects[n] = rect(random(w + 20) - 10, random(h + 20) - 10,
+                      random(40) + 1, random(40) + 1);
+  }
+  return n;
+}
+
+static bool run(bool tePin, uint8_t rot) {
+  tft.setRotation(rot);
+  tft.setFrameRate(60);
+  ILI9341_TearingScheduler sched(tft, tePin ? TE_PIN : -1);
+  if (!tePin)
+    syncToBlanking();
+  sched.begin();
+
+  ILI9341_Rect rects[MAX_RECTS];
+  uint32_t sent = 0, waited = 0;
+  randomSeed(rot * 2 + tePin + 1);
+  panel.torn = panel.written = 0;
+  for (uint16_t f = 0; f < FRAMES; f++) {
+    delayMicroseconds(random(20000));
+    for (uint32_t i = 0; i < ILI9341_TFTWIDTH * ILI9341_TFTHEIGHT; i++)
+      image[i] = i * 7 + f * 1111;
+    uint8_t n = makeFrame(rects, f);
+    sent += sched.submit(rects, n);
+    waited += sched.lastWaitMicros();
+    for (uint8_t i = 0; i < n; i++) {
+      const ILI9341_Rect &r = rects[i];
+      int16_t x = r.x + r.w / 2, y = r.y + r.h / 2;
+      if ((x < 0) || (y < 0) || (x >= tft.width()) || (y >= tft.height()))
+        continue;
+      uint16_t want = r.pixels[(int32_t)(y - r.y) * r.w + (x - r.x)];
+      for (uint8_t j = i + 1; j < n; j++) // A later rectangle may cover it
+        if ((x >= rects[j].x) && (y >= rects[j].y) &&
+            (x < rects[j].x + rects[j].w) && (y < rects[j].y + rects[j].h))
+          want = rects[j].pixels[(int32_t)(y - rects[j].y) * rects[j].w +
+                                 (x - rects[j].x)];
+      uint16_t got = panel.visiblePixel(rot, x, y);
+      if (got != want) {
+        fprintf(stderr,
+                "%s, rotation %u, frame %u: (%d,%d) is %04X, expected "
+                "%04X\n",
+                tePin ? "TE pin" : "model", rot, f, x, y, got, want);
+        return false;
+      }
+    }
+  }
+  printf("%s,%u,%lu,%lu,%lu\n", tePin ? "te_pin" : "model", rot,
+         (unsigned long)sent, (unsigned long)waited,
+         (unsigned long)panel.torn);
+  if (panel.torn) {
+    fprintf(stderr, "%s, rotation %u: %lu of %lu pixel bytes written under "
+                    "the scan line\n",
+            tePin ? "TE pin" : "model", rot, (unsigned long)panel.torn,
+            (unsigned long)panel.written);
+    return false;
+  }
+  return true;
+}
+
+int main(void) {
+  panel.attach(tft);
+  ArduinoHost::setPinReader(readPin);
+  tft.begin(24000000);
+
+  // Control: a plain full-screen write must be caught tearing
+  for (uint32_t i = 0; i < ILI9341_TFTWIDTH * ILI9341_TFTHEIGHT; i++)
+    image[i] = i;
+  tft.setFrameRate(60);
+  tft.drawRGBBitmap(0, 0, image, ILI9341_TFTWIDTH, ILI9341_TFTHEIGHT);
+  if (!panel.torn) {
+    fprintf(stderr, "unscheduled write was not seen to tear\n");
+    return 1;
+  }
+
+  printf("timing,rotation,pixels_sent,wait_us,torn_bytes\n");
+  bool ok = true;
+  for (uint8_t te = 0; te < 2; te++)
+    for (uint8_t rot = 0; rot < 4; rot++)
+      ok = run(te, rot) && ok;
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,121 @@
+/*!
+ * @file tilemap_check.cpp
+ *
+ * Scrolls an ILI9341_TileMap around a wrapping map on the host emulator,
+ * with RGB565 and 4-bit indexed tiles, with and without hardware
+ * scrolling, in every rotation. Steps are small moves along and across
+ * the scroll axis and occasional jumps of more than a screen. After every
+ * update() the visible image must be the map at the scroll position.
+ *
+ * Usage: tilemap_check
+ *
+ * The exit status is 1 if any pixel differs.
+ */
+
+#include "Adafruit_ILI9341.h"
+#include "ILI9341_Emulator.h"
+#include "ILI9341_TileMap.h"
+#include <stdio.h>
+
+#define TILES 6    ///< Tiles in each set
+#define MAP_W 13   ///< Map size in tiles
+#define MAP_H 7
+#define FRAMES 60  ///< Scroll steps per configuration
+
+static ILI9341_Emulator panel;
+static Adafruit_ILI9341 tft(10, 9);
+
+static uint16_t tiles[TILES * 16 * 16];    ///< 16 x 16 RGB565
+static uint8_t indexedTiles[TILES * 8 * 4]; ///< 8 x 8 at 4 bits
+static const uint16_t palette[16] = {1,  0xF800, 0x07E0, 0x001F, 0xFFFF, 5,
+                                     6,  7,      8,      9,      10,     11,
+                                     12, 13,     14,     15};
+static uint8_t map[MAP_W * MAP_H];
+
+static int32_t wrap(int32_t v, int32_t m) {
+  v %= m;
+  return (v < 0) ? v + m : v;
+}
+
+// Map pixel at (mx, my), already wrapped
+static uint16_t mapPixel(bool indexed, int32_t mx, int32_t my) {
+  const uint8_t size = indexed ? 8 : 16;
+  uint8_t t = map[(my / size) * MAP_W + mx / size];
+  uint8_t col = mx % size, row = my % size;
+  if (!indexed)
+    return tiles[(t * size + row) * size + col];
+  uint8_t b = indexedTiles[(t * size + row) * 4 + col / 2];
+  return palette[(col & 1) ? (b & 15) : (b >> 4)];
+}
+
+static bool run(bool indexed, bool hardware, uint8_t rot) {
+  tft.setRotation(rot);
+  ILI9341_TileMap tm(tft);
+  tm.begin(hardware);
+  if (!hardware)
+    tft.scrollTo(0);
+  if (indexed)
+    tm.setTiles(indexedTiles, 4, 8, palette);
+  else
+    tm.setTiles(tiles, 16);
+  tm.setMap(map, MAP_W, MAP_H);
+
+  const int32_t mapW = MAP_W * (indexed ? 8 : 16);
+  const int32_t mapH = MAP_H * (indexed ? 8 : 16);
+  int32_t sx = 0, sy = 0;
+  uint32_t sent = 0;
+  randomSeed(rot * 4 + hardware * 2 + indexed);
+  for (uint16_t f = 0; f < FRAMES; f++) {
+    uint8_t r = random(10);
+    if (r < 6) { // Along the scroll axis
+      if (rot & 1)
+        sx += random(41) - 20;
+      else
+        sy += random(41) - 20;
+    } else if (r < 8) {
+      sx += random(41) - 20;
+    } else if (r < 9) { // Jump
+      sy += random(900) - 450;
+    }
+    tm.scrollTo(sx, sy);
+    sent += tm.update();
+    for (int16_t y = 0; y < tft.height(); y++) {
+      for (int16_t x = 0; x < tft.width(); x++) {
+        uint16_t want = mapPixel(indexed, wrap(sx + x, mapW),
+                                 wrap(sy + y, mapH));
+        uint16_t got = panel.visiblePixel(rot, x, y);
+        if (got != want) {
+          fprintf(stderr,
+                  "%s tiles, %s scroll, rotation %u, step %u: (%d,%d) is "
+                  "%04X, expected %04X\n",
+                  indexed ? "indexed" : "RGB565",
+                  hardware ? "hardware" : "software", rot, f, x, y, got,
+                  want);
+          return false;
+        }
+      }
+    }
+  }
+  printf("%s,%s,%u,%lu\n", indexed ? "indexed" : "rgb565",
+         hardware ? "hardware" : "software", rot, (unsigned long)sent);
+  return true;
+}
+
+int main(void) {
+  for (uint16_t i = 0; i < TILES * 16 * 16; i++)
+    tiles[i] = i * 131 + 7;
+  for (uint16_t i = 0; i < sizeof indexedTiles; i++)
+    indexedTiles[i] = i * 53 + 3;
+  for (uint16_t i = 0; i < MAP_W * MAP_H; i++)
+    map[i] = (i * 7 + i / MAP_W) % TILES;
+
+  panel.attach(tft);
+  tft.begin(24000000);
+  printf("tiles,scroll,rotation,pixels_sent\n");
+  bool ok = true;
+  for (uint8_t indexed = 0; ok && (indexed < 2); indexed++)
+    for (uint8_t hardware = 0; ok && (hardware < 2); hardware++)
+      for (uint8_t rot = 0; ok && (rot < 4); rot++)
+        ok = run(indexed, hardware, rot);
+  return ok ? 0 : 1;
+}
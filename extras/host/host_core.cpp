@@ -0,0 +1,85 @@
+/*!
+ * @file host_core.cpp
+ *
+ * Simulated clock, pins and Print formatting for the host build.
+ */
+
+#include "Arduino.h"
+#include <SPI.h>
+#include <stdio.h>
+
+SPIClass SPI;
+HostSerial Serial;
+
+static uint64_t hostNanos = 0;
+static int (*hostPinReader)(uint8_t) = NULL;
+static void (*hostPinWriter)(uint8_t, uint8_t) = NULL;
+
+uint64_t ArduinoHost::nanos(void) { return hostNanos; }
+void ArduinoHost::advance(uint64_t ns) { hostNanos += ns; }
+void ArduinoHost::setPinReader(int (*fn)(uint8_t pin)) { hostPinReader = fn; }
+void ArduinoHost::setPinWriter(void (*fn)(uint8_t pin, uint8_t val)) {
+  hostPinWriter = fn;
+}
+
+uint32_t micros(void) { return (uint32_t)(hostNanos / 1000); }
+uint32_t millis(void) { return (uint32_t)(hostNanos / 1000000); }
+void delay(uint32_t ms) { hostNanos += (uint64_t)ms * 1000000; }
+void delayMicroseconds(uint32_t us) { hostNanos += (uint64_t)us * 1000; }
+void yield(void) { hostNanos += 1000; } // A polling loop costs ~1 us
+void pinMode(uint8_t, uint8_t) {}
+void digitalWrite(uint8_t pin, uint8_t val) {
+  if (hostPinWriter)
+    hostPinWriter(pin, val);
+}
+int digitalRead(uint8_t pin) { return hostPinReader ? hostPinReader(pin) : 0; }
+// Same sequence on every host, unlike rand()
+static uint32_t hostRandomState = 1;
+void randomSeed(unsigned long seed) { hostRandomState = seed; }
+long random(long howbig) {
+  hostRandomState = hostRandomState * 1103515245 + 12345;
+  return howbig ? (long)((hostRandomState >> 16) % howbig) : 0;
+}
+long random(long howsmall, long howbig) {
+  return (howbig > howsmall) ? howsmall + random(howbig - howsmall)
+                             : howsmall;
+}
+
+size_t Print::write(const uint8_t *buffer, size_t size) {
+  size_t n = 0;
+  while (size--)
+    n += write(*buffer++);
+  return n;
+}
+
+size_t Print::write(const char *str) {
+  return str ? write((const uint8_t *)str, strlen(str)) : 0;
+}
+
+size_t Print::print(const char *s) { return write(s); }
+size_t Print::print(char c) { return write((uint8_t)c); }
+
+size_t Print::print(long n, int base) {
+  char buf[40];
+  if (base == HEX)
+    snprintf(buf, sizeof buf, "%lX", (unsigned long)n);
+  else
+    snprintf(buf, sizeof buf, "%ld", n);
+  return write(buf);
+}
+
+size_t Print::print(unsigned long n, int base) {
+  char buf[40];
+  snprintf(buf, sizeof buf, (base == HEX) ? "%lX" : "%lu", n);
+  return write(buf);
+}
+
+size_t Print::print(double n, int digits) {
+  char buf[48];
+  snprintf(buf, sizeof buf, "%.*f", digits, n);
+  return write(buf);
+}
+
+size_t Print::println(void) { return write("\r\n"); }
+
+size_t HostSerial::write(uint8_t c) { return fputc(c, stdout) == EOF ? 0 : 1; }
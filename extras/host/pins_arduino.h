@@ -0,0 +1 @@
+// Host stand-in: no board pin tables are needed by the emulator.
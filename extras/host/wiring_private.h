@@ -0,0 +1 @@
+// Host stand-in: no private wiring definitions are needed by the emulator.
@@ -0,0 +1,217 @@
+/*!
+ * @file rle_encode.cpp
+ *
+ * Host tool that converts an image into the palette + RLE format drawn by
+ * Adafruit_ILI9341::drawCompressedBitmap(), written out as a C header.
+ *
+ * Build:   g++ -O2 -o rle_encode rle_encode.cpp
+ * Usage:   rle_encode [-w width -h height] input symbol > output.h
+ *
+ * The input is either a binary PPM (P6) image, or a C header of RGB565
+ * values such as examples/pictureEmbed/dragon.h: every 0x/0X four-digit
+ * hex number after the first '{' is a pixel, and the size comes from
+ * "#define ..._WIDTH" / "#define ..._HEIGHT" lines unless -w/-h are given.
+ * At most 256 distinct colours are allowed; quantize larger images first.
+ *
+ * BSD license, all text here must be included in any redistribution.
+ *
+ */
+
+#include <ctype.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+static bool readFile(const char *path, std::string &out) {
+  FILE *f = fopen(path, "rb");
+  if (!f)
+    return false;
+  char buf[4096];
+  size_t n;
+  while ((n = fread(buf, 1, sizeof buf, f)) > 0)
+    out.append(buf, n);
+  fclose(f);
+  return true;
+}
+
+// Skip whitespace and # comments between PPM header fields.
+static size_t ppmSkip(const std::string &s, size_t i) {
+  while (i < s.size()) {
+    if (s[i] == '#') {
+      while ((i < s.size()) && (s[i] != '\n'))
+        i++;
+    } else if (isspace((unsigned char)s[i])) {
+      i++;
+    } else {
+      break;
+    }
+  }
+  return i;
+}
+
+static bool parsePPM(const std::string &s, int &w, int &h,
+                     std::vector<uint16_t> &pixels) {
+  size_t i = 2;
+  long v[3];
+  for (int k = 0; k < 3; k++) {
+    i = ppmSkip(s, i);
+    char *end;
+    v[k] = strtol(s.c_str() + i, &end, 10);
+    i = end - s.c_str();
+  }
+  i++; // Single whitespace byte before the raster
+  w = (int)v[0];
+  h = (int)v[1];
+  if ((w <= 0) || (h <= 0) || (v[2] != 255) ||
+      (s.size() < i + (size_t)w * h * 3))
+    return false;
+  for (long p = 0; p < (long)w * h; p++, i += 3) {
+    uint8_t r = s[i], g = s[i + 1], b = s[i + 2];
+    pixels.push_back(((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3));
+  }
+  return true;
+}
+
+// Value of "#define <anything><suffix> <n>", or 0.
+static int defineValue(const std::string &s, const char *suffix) {
+  size_t i = 0;
+  while ((i = s.find("#define", i)) != std::string::npos) {
+    size_t eol = s.find('\n', i);
+    std::string line = s.substr(i, eol - i);
+    char name[128];
+    int value;
+    if ((sscanf(line.c_str(), "#define %127s %d", name, &value) == 2) &&
+        (strlen(name) >= strlen(suffix)) &&
+        !strcmp(name + strlen(name) - strlen(suffix), suffix))
+      return value;
+    i = eol;
+  }
+  return 0;
+}
+
+static bool parseHeader(const std::string &s, int &w, int &h,
+                        std::vector<uint16_t> &pixels) {
+  if (!w)
+    w = defineValue(s, "_WIDTH");
+  if (!h)
+    h = defineValue(s, "_HEIGHT");
+  size_t i = s.find('{');
+  if (i == std::string::npos)
+    return false;
+  for (; i + 5 < s.size(); i++) {
+    if ((s[i] == '0') && ((s[i + 1] == 'x') || (s[i + 1] == 'X')) &&
+        isxdigit((unsigned char)s[i + 2])) {
+      char *end;
+      pixels.push_back((uint16_t)strtoul(s.c_str() + i + 2, &end, 16));
+      i = end - s.c_str() - 1;
+    }
+  }
+  return (w > 0) && (h > 0) && (pixels.size() == (size_t)w * h);
+}
+
+// Greedy packetizer: runs of 3 or more become run packets (2 bytes), all
+// else is gathered into literal packets of up to 128 indexes.
+static void encode(const std::vector<uint8_t> &idx, std::vector<uint8_t> &out) {
+  size_t i = 0, n = idx.size();
+  std::vector<uint8_t> lit;
+  while (i < n) {
+    size_t r = 1;
+    while ((i + r < n) && (r < 128) && (idx[i + r] == idx[i]))
+      r++;
+    if (r >= 3) {
+      if (!lit.empty()) {
+        out.push_back(lit.size() - 1);
+        out.insert(out.end(), lit.begin(), lit.end());
+        lit.clear();
+      }
+      out.push_back(0x80 | (r - 1));
+      out.push_back(idx[i]);
+      i += r;
+    } else {
+      lit.push_back(idx[i++]);
+      if (lit.size() == 128) {
+        out.push_back(127);
+        out.insert(out.end(), lit.begin(), lit.end());
+        lit.clear();
+      }
+    }
+  }
+  if (!lit.empty()) {
+    out.push_back(lit.size() - 1);
+    out.insert(out.end(), lit.begin(), lit.end());
+  }
+}
+
+int main(int argc, char *argv[]) {
+  int w = 0, h = 0, a = 1;
+  for (; (a + 1 < argc) && (argv[a][0] == '-'); a += 2) {
+    if (!strcmp(argv[a], "-w"))
+      w = atoi(argv[a + 1]);
+    else if (!strcmp(argv[a], "-h"))
+      h = atoi(argv[a + 1]);
+  }
+  if (argc - a != 2) {
+    fprintf(stderr, "usage: %s [-w width -h height] input symbol\n", argv[0]);
+    return 1;
+  }
+  const char *input = argv[a], *symbol = argv[a + 1];
+
+  std::string data;
+  if (!readFile(input, data)) {
+    fprintf(stderr, "%s: cannot read\n", input);
+    return 1;
+  }
+  std::vector<uint16_t> pixels;
+  bool ok = (data.compare(0, 2, "P6") == 0) ? parsePPM(data, w, h, pixels)
+                                            : parseHeader(data, w, h, pixels);
+  if (!ok) {
+    fprintf(stderr, "%s: not a P6 PPM or RGB565 header of known size\n",
+            input);
+    return 1;
+  }
+
+  std::vector<uint16_t> palette;
+  std::vector<uint8_t> idx;
+  for (size_t p = 0; p < pixels.size(); p++) {
+    size_t c = 0;
+    while ((c < palette.size()) && (palette[c] != pixels[p]))
+      c++;
+    if (c == palette.size()) {
+      if (palette.size() == 256) {
+        fprintf(stderr, "%s: more than 256 colours\n", input);
+        return 1;
+      }
+      palette.push_back(pixels[p]);
+    }
+    idx.push_back((uint8_t)c);
+  }
+
+  std::vector<uint8_t> out;
+  out.push_back('R');
+  out.push_back('L');
+  out.push_back(w >> 8);
+  out.push_back(w & 0xFF);
+  out.push_back(h >> 8);
+  out.push_back(h & 0xFF);
+  out.push_back(palette.size() & 0xFF); // 256 wraps to 0
+  for (size_t c = 0; c < palette.size(); c++) {
+    out.push_back(palette[c] >> 8);
+    out.push_back(palette[c] & 0xFF);
+  }
+  encode(idx, out);
+
+  printf("// Generated by extras/rle_encode from %s:\n", input);
+  printf("// %dx%d, %u colours, %u bytes raw RGB565, %u bytes compressed.\n",
+         w, h, (unsigned)palette.size(), (unsigned)(pixels.size() * 2),
+         (unsigned)out.size());
+  printf("// Draw with tft.drawCompressedBitmap(x, y, %s).\n\n", symbol);
+  printf("const PROGMEM uint8_t %s[%u] = {", symbol, (unsigned)out.size());
+  for (size_t i = 0; i < out.size(); i++)
+    printf("%s0x%02X%s", (i % 12) ? " " : "\n    ", out[i],
+           (i + 1 < out.size()) ? "," : "");
+  printf("};\n");
+  return 0;
+}
@@ -0,0 +1,70 @@
+/*!
+ * @file screenshot_decode.cpp
+ *
+ * Host tool that converts an Adafruit_ILI9341::dumpScreen() RLE565 capture
+ * into a binary PPM image. PPM captures can be opened directly.
+ *
+ * Build:   g++ -O2 -o screenshot_decode screenshot_decode.cpp
+ * Usage:   screenshot_decode capture.rle > capture.ppm
+ *
+ * A serial capture may start with unrelated text (boot messages etc.); the
+ * decoder skips ahead to the 'R' '5' signature.
+ *
+ * BSD license, all text here must be included in any redistribution.
+ *
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <vector>
+
+int main(int argc, char *argv[]) {
+  if (argc != 2) {
+    fprintf(stderr, "usage: %s capture.rle > capture.ppm\n", argv[0]);
+    return 1;
+  }
+  FILE *f = fopen(argv[1], "rb");
+  if (!f) {
+    fprintf(stderr, "%s: cannot read\n", argv[1]);
+    return 1;
+  }
+  std::vector<uint8_t> d;
+  int c;
+  while ((c = fgetc(f)) != EOF)
+    d.push_back(c);
+  fclose(f);
+
+  size_t i = 0;
+  while ((i + 6 <= d.size()) && !((d[i] == 'R') && (d[i + 1] == '5')))
+    i++;
+  if (i + 6 > d.size()) {
+    fprintf(stderr, "%s: no RLE565 signature\n", argv[1]);
+    return 1;
+  }
+  unsigned w = (d[i + 2] << 8) | d[i + 3], h = (d[i + 4] << 8) | d[i + 5];
+  i += 6;
+
+  printf("P6\n%u %u\n255\n", w, h);
+  unsigned long pixels = 0, total = (unsigned long)w * h;
+  while ((pixels < total) && (i < d.size())) {
+    uint8_t code = d[i++];
+    unsigned n = (code & 0x7F) + 1;
+    bool run = code & 0x80;
+    for (unsigned k = 0; (k < n) && (i + 1 < d.size()); k++) {
+      uint16_t p = (d[i] << 8) | d[i + 1];
+      if (!run || (k == n - 1))
+        i += 2;
+      uint8_t r = p >> 11, g = (p >> 5) & 0x3F, b = p & 0x1F;
+      putchar((r << 3) | (r >> 2));
+      putchar((g << 2) | (g >> 4));
+      putchar((b << 3) | (b >> 2));
+      pixels++;
+    }
+  }
+  if (pixels < total) {
+    fprintf(stderr, "%s: truncated, %lu of %lu pixels\n", argv[1], pixels,
+            total);
+    return 1;
+  }
+  return 0;
+}